@@ -0,0 +1,228 @@
+/*
+ * Autotune.c
+ *
+ * Relay feedback autotuner for the velocity controller.
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team
+ */
+
+#include <math.h>
+#include <stddef.h>
+
+#include "Autotune.h"
+
+#define PI 3.14159265f
+
+// Start a new period of the oscillation
+static void startPeriod(struct autotuner *tuner);
+
+// Record a completed period and calculate the results once enough have been
+// measured
+static void endPeriod(struct autotuner *tuner);
+
+void autotuneInit(struct autotuner *tuner, float amplitude, float hysteresis,
+                  float bias, float outputMin, float outputMax, uint32_t maxSamples,
+                  volatile float *setpoint, volatile float *feedback,
+                  volatile float *controlSignal) {
+    if (tuner == NULL)
+        return;
+
+    tuner->amplitude = amplitude;
+    tuner->hysteresis = hysteresis;
+    tuner->bias = bias;
+    tuner->outputMin = outputMin;
+    tuner->outputMax = outputMax;
+
+    tuner->setpoint = setpoint;
+    tuner->feedback = feedback;
+    tuner->controlSignal = controlSignal;
+
+    tuner->relayHigh = true;
+    tuner->centre = *setpoint;
+
+    tuner->periods = 0;
+    tuner->measuredSamples = 0;
+    tuner->amplitudeSum = 0.0f;
+
+    tuner->samples = 0;
+    tuner->maxSamples = maxSamples;
+
+    tuner->ultimateGain = 0.0f;
+    tuner->ultimatePeriod = 0.0f;
+
+    startPeriod(tuner);
+
+    tuner->state = AUTOTUNE_RUNNING;
+}
+
+float runAutotune(struct autotuner *tuner) {
+    if (tuner == NULL)
+        return 0;
+
+    if (tuner->state != AUTOTUNE_RUNNING) {
+        *(tuner->controlSignal) = tuner->bias;
+        return tuner->bias;
+    }
+
+    float feedback = *(tuner->feedback);
+    float error = *(tuner->setpoint) - feedback;
+
+    if (feedback > tuner->peak)
+        tuner->peak = feedback;
+    if (feedback < tuner->trough)
+        tuner->trough = feedback;
+
+    tuner->deviationSum += fabsf(feedback - tuner->centre);
+
+    // Switch the relay once the error passes the hysteresis. A period ends each
+    // time the relay switches high.
+    if (tuner->relayHigh && error < -tuner->hysteresis) {
+        tuner->relayHigh = false;
+    } else if (!tuner->relayHigh && error > tuner->hysteresis) {
+        tuner->relayHigh = true;
+        endPeriod(tuner);
+        startPeriod(tuner);
+    }
+
+    float controlSignal = tuner->relayHigh ? tuner->bias + tuner->amplitude
+                                           : tuner->bias - tuner->amplitude;
+
+    if (controlSignal < tuner->outputMin)
+        controlSignal = tuner->outputMin;
+    else if (controlSignal > tuner->outputMax)
+        controlSignal = tuner->outputMax;
+
+    tuner->controlSum += controlSignal;
+    tuner->periodSamples++;
+
+    if (++tuner->samples >= tuner->maxSamples && tuner->state == AUTOTUNE_RUNNING)
+        tuner->state = AUTOTUNE_FAILED;
+
+    // Hold the bias once the experiment is over
+    if (tuner->state != AUTOTUNE_RUNNING)
+        controlSignal = tuner->bias;
+
+    *(tuner->controlSignal) = controlSignal;
+
+    return controlSignal;
+}
+
+bool autotuneParameters(const struct autotuner *tuner, enum autotuneRule rule,
+                        float sampleFreq, struct pidParameters *params) {
+    if (tuner == NULL || params == NULL || tuner->state != AUTOTUNE_DONE)
+        return false;
+
+    float ku = tuner->ultimateGain;
+    float tu = tuner->ultimatePeriod / sampleFreq;
+
+    switch (rule) {
+        case AUTOTUNE_ZIEGLER_NICHOLS_PID:
+            params->kp = 0.6f * ku;
+            params->ki = params->kp / (0.5f * tu);
+            params->kd = params->kp * 0.125f * tu;
+            break;
+        case AUTOTUNE_TYREUS_LUYBEN_PI:
+            params->kp = ku / 3.2f;
+            params->ki = params->kp / (2.2f * tu);
+            params->kd = 0.0f;
+            break;
+        case AUTOTUNE_ZIEGLER_NICHOLS_PI:
+        default:
+            params->kp = 0.45f * ku;
+            params->ki = params->kp / (tu / 1.2f);
+            params->kd = 0.0f;
+            break;
+    }
+
+    return true;
+}
+
+bool autotuneHandover(const struct autotuner *tuner, enum autotuneRule rule,
+                      float sampleFreq, struct pidParameters *params,
+                      struct pidController *pid) {
+    if (tuner == NULL || params == NULL || pid == NULL ||
+        tuner->state == AUTOTUNE_RUNNING)
+        return false;
+
+    bool tuned = autotuneParameters(tuner, rule, sampleFreq, params) &&
+                 pidRetune(pid, params);
+
+    // The integrator takes over from the bias so that the next control signal
+    // equals it. The proportional and feedforward terms are taken out with the
+    // coefficients in use now, as the swap to the tuned coefficients adjusts
+    // the integrator for their change. The integral action of the next sample
+    // uses the coefficients it will run with.
+    const struct pidCoefficients *current = pidActiveCoefficients(pid);
+    const struct pidCoefficients *next = pid->swapPending
+                                       ? &pid->banks[pid->activeBank ^ 1]
+                                       : current;
+    float setpoint = *(pid->setpoint);
+    float feedback = *(pid->feedback);
+
+    pid->integrator = tuner->bias
+                    - current->kp * (current->setWeightB * setpoint - feedback)
+                    - current->feedforwardGain * setpoint
+                    - next->intCoeff * (setpoint - feedback);
+
+    // No derivative kick from the error built up under the relay
+    pid->differentiator = 0.0f;
+    pid->prevError = current->setWeightC * setpoint - feedback;
+
+    return tuned;
+}
+
+static void startPeriod(struct autotuner *tuner) {
+    float feedback = *(tuner->feedback);
+
+    tuner->periodSamples = 0;
+    tuner->peak = feedback;
+    tuner->trough = feedback;
+    tuner->controlSum = 0.0f;
+    tuner->deviationSum = 0.0f;
+}
+
+static void endPeriod(struct autotuner *tuner) {
+    tuner->periods++;
+
+    // The next period is measured about the centre of this one
+    tuner->centre = 0.5f * (tuner->peak + tuner->trough);
+
+    // The first period started with the motor at rest rather than part way
+    // through the oscillation
+    if (tuner->periods == 1)
+        return;
+
+    if (tuner->periods <= 1 + AUTOTUNE_SETTLE_PERIODS) {
+        // Centre the oscillation on the setpoint. The period is a whole number
+        // of samples, so the average alternates between periods and is
+        // filtered.
+        float average = tuner->controlSum / tuner->periodSamples;
+        tuner->bias += 0.5f * (average - tuner->bias);
+        return;
+    }
+
+    // The speed is closer to a triangle wave than a sine wave, so half the
+    // peak to peak speed overestimates the amplitude of the fundamental (by 23%
+    // for a triangle wave). The mean absolute deviation is (2 / pi) times the
+    // amplitude for a sine wave and within 3% of that for a triangle wave.
+    tuner->measuredSamples += tuner->periodSamples;
+    tuner->amplitudeSum += 0.5f * PI * tuner->deviationSum / tuner->periodSamples;
+
+    if (tuner->periods < 1 + AUTOTUNE_SETTLE_PERIODS + AUTOTUNE_MEASURE_PERIODS)
+        return;
+
+    float amplitude = tuner->amplitudeSum / AUTOTUNE_MEASURE_PERIODS;
+    float squared = amplitude * amplitude - tuner->hysteresis * tuner->hysteresis;
+
+    if (squared <= 0.0f) {
+        tuner->state = AUTOTUNE_FAILED;
+        return;
+    }
+
+    tuner->ultimateGain = 4.0f * tuner->amplitude / (PI * sqrtf(squared));
+    tuner->ultimatePeriod = (float)tuner->measuredSamples / AUTOTUNE_MEASURE_PERIODS;
+    tuner->state = AUTOTUNE_DONE;
+}
@@ -0,0 +1,127 @@
+/*
+ * Autotune.h
+ *
+ * Relay feedback autotuner for the velocity controller.
+ *
+ * Instead of the controller, a relay drives the motor: the control signal is
+ * bias + amplitude while the speed is below the setpoint and bias - amplitude
+ * while it is above. This makes the speed oscillate about the setpoint at the
+ * frequency where the phase lag of the motor (including the sampling and
+ * measurement delays) reaches 180 degrees. From the amplitude A and period Tu
+ * of the oscillation, the describing function of the relay gives the ultimate
+ * gain
+ *
+ *      Ku = 4 * amplitude / (pi * sqrt(A^2 - hysteresis^2))
+ *
+ * The relay switches only once the error passes the hysteresis, so that noise
+ * in the measured speed does not cause extra switching. The bias is corrected
+ * at the end of each period to the average control signal over that period,
+ * which makes the oscillation symmetric about the setpoint.
+ *
+ * After the period in which the motor first reaches the setpoint, the next
+ * AUTOTUNE_SETTLE_PERIODS periods are used to reach a steady oscillation, then
+ * Ku and Tu are averaged over AUTOTUNE_MEASURE_PERIODS periods. The PID gains
+ * are then calculated with one of the rules below.
+ *
+ * runAutotune() is meant to be called in the control interrupt in place of the
+ * controller until the state is no longer AUTOTUNE_RUNNING. autotuneHandover()
+ * is then called once, in the same interrupt and before the controller first
+ * runs, so that the controller takes over from the relay without a bump.
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team
+ */
+
+#ifndef AUTOTUNE_H
+#define AUTOTUNE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "PIDController.h"
+
+// Periods ignored while the oscillation settles
+#define AUTOTUNE_SETTLE_PERIODS     4
+
+// Periods averaged to measure the oscillation
+#define AUTOTUNE_MEASURE_PERIODS    4
+
+enum autotuneState {
+    AUTOTUNE_RUNNING,
+    AUTOTUNE_DONE,
+    AUTOTUNE_FAILED             // No steady oscillation before the time limit
+};
+
+// Tuning rules which calculate PID gains from Ku and Tu
+enum autotuneRule {
+    AUTOTUNE_ZIEGLER_NICHOLS_PI,    // Kp = 0.45 Ku, Ti = Tu / 1.2
+    AUTOTUNE_ZIEGLER_NICHOLS_PID,   // Kp = 0.6 Ku, Ti = Tu / 2, Td = Tu / 8
+    AUTOTUNE_TYREUS_LUYBEN_PI       // Kp = Ku / 3.2, Ti = 2.2 Tu
+};
+
+// A tuner must be set up with autotuneInit() before use.
+struct autotuner {
+    float amplitude;
+    float hysteresis;
+    float bias;
+    float outputMin, outputMax;
+
+    volatile float *setpoint;
+    volatile float *feedback;
+    volatile float *controlSignal;
+
+    bool relayHigh;
+
+    // Current period
+    uint32_t periodSamples;
+    float peak, trough;
+    float centre;               // Centre of the previous period
+    float controlSum;
+    float deviationSum;         // Sum of |feedback - centre|
+
+    // Completed periods
+    uint32_t periods;
+    uint32_t measuredSamples;
+    float amplitudeSum;
+
+    uint32_t samples;
+    uint32_t maxSamples;
+
+    volatile enum autotuneState state;
+
+    // Results, valid once the state is AUTOTUNE_DONE
+    float ultimateGain;
+    float ultimatePeriod;       // In samples
+};
+
+// Set up a tuner with the relay amplitude and hysteresis, the initial bias of
+// the control signal, the output limits and the number of samples after which
+// the experiment fails. The relay drives the feedback about the value at the
+// setpoint memory location.
+void autotuneInit(struct autotuner *tuner, float amplitude, float hysteresis,
+                  float bias, float outputMin, float outputMax,
+                  uint32_t maxSamples,
+                  volatile float *setpoint, volatile float *feedback,
+                  volatile float *controlSignal);
+
+float runAutotune(struct autotuner *tuner);
+
+// Calculate the PID gains from the results of a completed experiment. Only kp,
+// ki and kd are changed. Returns false if the experiment has not completed.
+bool autotuneParameters(const struct autotuner *tuner, enum autotuneRule rule,
+                        float sampleFreq, struct pidParameters *params);
+
+// Hand the motor over from the relay to the controller once the experiment is
+// no longer running. The gains calculated with autotuneParameters() are
+// applied with pidRetune(), and the controller states are set so that the next
+// control signal, at the current setpoint and feedback, equals the bias.
+// Returns false if the gains were not applied, such as when the experiment
+// failed, in which case the controller keeps its gains but still starts from
+// the bias.
+bool autotuneHandover(const struct autotuner *tuner, enum autotuneRule rule,
+                      float sampleFreq, struct pidParameters *params,
+                      struct pidController *pid);
+
+#endif
@@ -0,0 +1,116 @@
+/*
+ * Biquad.c
+ *
+ * Cascaded biquad filters in floating point and fixed point.
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team
+ */
+
+#include <stddef.h>
+
+#include "Biquad.h"
+
+void biquadInit(struct biquadFilter *filter,
+                const struct biquadCoefficients *sections, uint32_t numSections,
+                float initial) {
+    if (filter == NULL || sections == NULL)
+        return;
+
+    if (numSections > BIQUAD_MAX_SECTIONS)
+        numSections = BIQUAD_MAX_SECTIONS;
+
+    filter->sections = sections;
+    filter->numSections = numSections;
+
+    // With a constant input x, each section settles to the output
+    // y = (b0 + b1 + b2) / (1 + a1 + a2) * x
+    float x = initial;
+    for (uint32_t i = 0; i < numSections; i++) {
+        const struct biquadCoefficients *c = &sections[i];
+        float y = (c->b0 + c->b1 + c->b2) / (1.0f + c->a1 + c->a2) * x;
+
+        filter->states[i][1] = c->b2 * x - c->a2 * y;
+        filter->states[i][0] = c->b1 * x - c->a1 * y + filter->states[i][1];
+
+        x = y;
+    }
+}
+
+float runBiquadFilter(struct biquadFilter *filter, float input) {
+    if (filter == NULL)
+        return 0;
+
+    float x = input;
+
+    for (uint32_t i = 0; i < filter->numSections; i++) {
+        const struct biquadCoefficients *c = &filter->sections[i];
+        float *s = filter->states[i];
+
+        float y = c->b0 * x + s[0];
+        s[0] = c->b1 * x - c->a1 * y + s[1];
+        s[1] = c->b2 * x - c->a2 * y;
+
+        x = y;
+    }
+
+    return x;
+}
+
+void biquadFixInit(struct biquadFixFilter *filter,
+                   const struct biquadFixCoefficients *sections, uint32_t numSections,
+                   fix_t initial) {
+    if (filter == NULL || sections == NULL)
+        return;
+
+    if (numSections > BIQUAD_MAX_SECTIONS)
+        numSections = BIQUAD_MAX_SECTIONS;
+
+    filter->sections = sections;
+    filter->numSections = numSections;
+
+    // As for biquadInit(). This only runs once, so the steady state is found
+    // in floating point.
+    float x = fix2float(initial);
+    for (uint32_t i = 0; i < numSections; i++) {
+        const struct biquadFixCoefficients *c = &sections[i];
+        float b0 = fix2float(c->b0), b1 = fix2float(c->b1), b2 = fix2float(c->b2);
+        float a1 = fix2float(c->a1), a2 = fix2float(c->a2);
+        float y = (b0 + b1 + b2) / (1.0f + a1 + a2) * x;
+
+        float s1 = b2 * x - a2 * y;
+        float s0 = b1 * x - a1 * y + s1;
+        filter->states[i][0] = FIX_POINT(s0);
+        filter->states[i][1] = FIX_POINT(s1);
+
+        x = y;
+    }
+}
+
+fix_t runBiquadFixFilter(struct biquadFixFilter *filter, fix_t input) {
+    if (filter == NULL)
+        return 0;
+
+    fix_t x = input;
+
+    for (uint32_t i = 0; i < filter->numSections; i++) {
+        const struct biquadFixCoefficients *c = &filter->sections[i];
+        fix_t *s = filter->states[i];
+
+        fix_t y = (fix_t)(((dint_t)c->b0 * x >> Q_POINT) + s[0]);
+
+        // s[1] is scaled by a multiplication, as left shifting a negative
+        // value is undefined
+        dint_t s0 = (dint_t)c->b1 * x - (dint_t)c->a1 * y
+                  + (dint_t)s[1] * ((dint_t)1 << Q_POINT);
+        dint_t s1 = (dint_t)c->b2 * x - (dint_t)c->a2 * y;
+        s[0] = (fix_t)(s0 >> Q_POINT);
+        s[1] = (fix_t)(s1 >> Q_POINT);
+
+        x = y;
+    }
+
+    return x;
+}
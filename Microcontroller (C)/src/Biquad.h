@@ -0,0 +1,87 @@
+/*
+ * Biquad.h
+ *
+ * Cascaded biquad (second-order section) filters in floating point and fixed
+ * point, for conditioning the feedback or setpoint before the controller.
+ *
+ * Each section is a direct form II transposed filter
+ *
+ *      y  = b0 * x + s1
+ *      s1 = b1 * x - a1 * y + s2
+ *      s2 = b2 * x - a2 * y
+ *
+ * which needs two states per section and five multiplications. The output of
+ * each section is the input of the next. Coefficients are generated by
+ * Scripts/generate_biquad.py (Butterworth low-pass and notch stages), which
+ * writes a header such as FeedbackFilter.h.
+ *
+ * The fixed point filter uses the Q format of fix_t for coefficients, states
+ * and signals. Each state is calculated in double length and truncated once,
+ * so rounding errors do not build up between the terms of a section. Overflow
+ * is not checked.
+ *
+ * Usage:
+ *      static const struct biquadCoefficients feedbackFilter[] =
+ *          FEEDBACK_FILTER_COEFFS;
+ *
+ *      struct biquadFilter filter;
+ *      biquadInit(&filter, feedbackFilter, FEEDBACK_FILTER_SECTIONS, 0.0f);
+ *      feedbackReg = runBiquadFilter(&filter, rawSpeed);
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team
+ */
+
+#ifndef BIQUAD_H
+#define BIQUAD_H
+
+#include <stdint.h>
+
+#include "fix_t.h"
+
+// Largest number of sections in one filter
+#define BIQUAD_MAX_SECTIONS 4
+
+// Coefficients of one section, normalised so that a0 = 1
+struct biquadCoefficients {
+    float b0, b1, b2, a1, a2;
+};
+
+struct biquadFixCoefficients {
+    fix_t b0, b1, b2, a1, a2;
+};
+
+// A filter must be set up with biquadInit() before use.
+struct biquadFilter {
+    const struct biquadCoefficients *sections;
+    uint32_t numSections;
+
+    float states[BIQUAD_MAX_SECTIONS][2];
+};
+
+// A filter must be set up with biquadFixInit() before use.
+struct biquadFixFilter {
+    const struct biquadFixCoefficients *sections;
+    uint32_t numSections;
+
+    fix_t states[BIQUAD_MAX_SECTIONS][2];
+};
+
+// Set up a filter with the coefficients of each section. The states are set as
+// if the input had been constant at `initial`, so a filter started with the
+// current speed does not add a transient.
+void biquadInit(struct biquadFilter *filter,
+                const struct biquadCoefficients *sections, uint32_t numSections,
+                float initial);
+
+float runBiquadFilter(struct biquadFilter *filter, float input);
+
+void biquadFixInit(struct biquadFixFilter *filter,
+                   const struct biquadFixCoefficients *sections, uint32_t numSections,
+                   fix_t initial);
+
+fix_t runBiquadFixFilter(struct biquadFixFilter *filter, fix_t input);
+
+#endif
@@ -0,0 +1,73 @@
+/*
+ * CICDecimator.c
+ *
+ * Cascaded integrator-comb decimator for oversampled encoder ticks.
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team
+ */
+
+#include <stddef.h>
+
+#include "CICDecimator.h"
+
+void cicInit(struct cicDecimator *cic, uint32_t order, uint32_t ratio) {
+    if (cic == NULL)
+        return;
+
+    if (order > CIC_MAX_ORDER)
+        order = CIC_MAX_ORDER;
+    if (order == 0)
+        order = 1;
+    if (ratio == 0)
+        ratio = 1;
+
+    cic->order = order;
+    cic->ratio = ratio;
+    cic->phase = 0;
+
+    float gain = 1.0f;
+    for (uint32_t i = 0; i < order; i++) {
+        cic->integrators[i] = 0;
+        cic->combs[i] = 0;
+        gain *= (float)ratio;
+    }
+
+    cic->output = 0;
+    cic->invGain = 1.0f / gain;
+}
+
+bool runCicDecimator(struct cicDecimator *cic, int32_t input) {
+    if (cic == NULL)
+        return false;
+
+    uint32_t x = (uint32_t)input;
+    for (uint32_t i = 0; i < cic->order; i++) {
+        cic->integrators[i] += x;
+        x = cic->integrators[i];
+    }
+
+    if (++cic->phase < cic->ratio)
+        return false;
+
+    cic->phase = 0;
+
+    for (uint32_t i = 0; i < cic->order; i++) {
+        uint32_t y = x - cic->combs[i];
+        cic->combs[i] = x;
+        x = y;
+    }
+
+    cic->output = (int32_t)x;
+
+    return true;
+}
+
+float cicOutput(const struct cicDecimator *cic) {
+    if (cic == NULL)
+        return 0;
+
+    return (float)cic->output * cic->invGain;
+}
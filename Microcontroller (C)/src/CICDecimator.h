@@ -0,0 +1,70 @@
+/*
+ * CICDecimator.h
+ *
+ * Cascaded integrator-comb (CIC) decimator for encoder tick counts sampled at
+ * an integer multiple of the control rate.
+ *
+ * A decimator of order N and ratio R is N integrators running at the input
+ * rate followed by N combs (first differences) running at the output rate.
+ * Every R input samples it outputs the input convolved with N boxcars of
+ * length R, which is a gain of R^N. No multiplications are needed, and the
+ * integer arithmetic is exact: the integrators wrap around, but the combs
+ * cancel the wrap as long as the output fits in 32 bits.
+ *
+ * For encoder ticks counted over each input period, an order 1 decimator is
+ * the tick count over the whole output period, which is what the QEI module
+ * measures when it samples at the output rate. Higher orders weight the ticks
+ * of the last N output periods with a smooth window. This attenuates the tick
+ * quantisation noise at the cost of a group delay of N (R - 1) / 2 input
+ * samples, and removes any component at multiples of the output rate (such as
+ * a mechanical ripple) before it can alias.
+ *
+ * Usage:
+ *      struct cicDecimator decimator;
+ *      cicInit(&decimator, CIC_ORDER, QEI_OVERSAMPLE);
+ *
+ *      if (runCicDecimator(&decimator, qeiGetVelocityTicks(QEI1)))
+ *          feedbackReg = qeiTicksToSpeed(QEI1, cicOutput(&decimator));
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team
+ */
+
+#ifndef CIC_DECIMATOR_H
+#define CIC_DECIMATOR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Largest order of a decimator
+#define CIC_MAX_ORDER   4
+
+// A decimator must be set up with cicInit() before use.
+struct cicDecimator {
+    uint32_t order;
+    uint32_t ratio;
+    uint32_t phase;                 // Input samples since the last output
+
+    // Unsigned so that wrapping around is defined
+    uint32_t integrators[CIC_MAX_ORDER];
+    uint32_t combs[CIC_MAX_ORDER];  // Comb inputs from the last output sample
+
+    int32_t output;                 // Last output, with a gain of ratio^order
+    float invGain;
+};
+
+// Set up a decimator with the given order and decimation ratio. The states are
+// cleared, so the first order outputs are a start-up transient.
+void cicInit(struct cicDecimator *cic, uint32_t order, uint32_t ratio);
+
+// Add one input sample. Returns true when an output sample has been calculated,
+// which happens every `ratio` inputs.
+bool runCicDecimator(struct cicDecimator *cic, int32_t input);
+
+// Last output divided by the gain of the decimator, i.e. the weighted mean of
+// the input
+float cicOutput(const struct cicDecimator *cic);
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef CONTROLLER_PARAMETERS_H
 #define CONTROLLER_PARAMETERS_H
 
+#include "fix_t.h"
+
 // PID Gains
 /* #define KP                  0.324f */
 /* #define KI                  11.6096f */
@@ -14,6 +16,13 @@
 /* #define KI                  1.1415f */
 /* #define KD                  0.0f */
 
+// PID gains used with the model feedforward term (MODEL_FEEDFORWARD in
+// system.c). The feedforward term supplies the voltage for a new speed, so the
+// integral action only has to correct the error in the model and a higher
+// proportional gain can be used without overshoot.
+#define FF_KP               0.2f
+#define FF_KI               0.3f
+
 // Setpoint weights
 #define SW_B                1.0f
 #define SW_C                1.0f
@@ -29,6 +38,10 @@
 #define OUTPUT_MIN          -12.0f
 #define OUTPUT_MAX          12.0f
 
+// Anti-windup method and back-calculation tracking gain (in 1/s)
+#define ANTI_WINDUP         PID_ANTI_WINDUP_NONE
+#define KT                  25.0f
+
 // Internal controller coefficients
 #define INT_COEFF           KI * TS
 #define DER_COEFF1          KD * N
@@ -37,4 +50,107 @@
 // Sample time
 #define TS                  1.0f / FS
 
+// Initialiser for a struct pidParameters using the above parameters
+#define PID_DEFAULT_PARAMETERS {                                    \
+            .kp = KP, .ki = KI, .kd = KD,                           \
+            .setWeightB = SW_B, .setWeightC = SW_C,                 \
+            .filterCoeff = N,                                       \
+            .sampleFreq = FS,                                       \
+            .outputMin = OUTPUT_MIN, .outputMax = OUTPUT_MAX,       \
+            .feedforwardGain = 0.0f,                                \
+            .antiWindup = ANTI_WINDUP, .trackingGain = KT           \
+        }
+
+// Position (outer) loop parameters
+// The position controller runs once every POSITION_LOOP_DIVIDER velocity
+// samples. Its input is an angle in degrees and its output is the velocity
+// setpoint in rpm.
+#define POSITION_LOOP_DIVIDER   5
+
+#define POS_KP              0.3f
+#define POS_KI              0.0f
+#define POS_KD              0.0f
+
+#define POS_FS              (FS / POSITION_LOOP_DIVIDER)
+
+// Velocity setpoint limits
+#define POS_OUTPUT_MIN      -20.0f
+#define POS_OUTPUT_MAX      20.0f
+
+// Initialiser for a struct pidParameters for the position controller
+#define PID_POSITION_PARAMETERS {                                   \
+            .kp = POS_KP, .ki = POS_KI, .kd = POS_KD,               \
+            .setWeightB = 1.0f, .setWeightC = 1.0f,                 \
+            .filterCoeff = N,                                       \
+            .sampleFreq = POS_FS,                                   \
+            .outputMin = POS_OUTPUT_MIN,                            \
+            .outputMax = POS_OUTPUT_MAX,                            \
+            .feedforwardGain = 0.0f,                                \
+            .antiWindup = ANTI_WINDUP, .trackingGain = KT           \
+        }
+
+// Velocity setpoint trajectory limits
+#define TRAJ_MAX_ACCEL      50.0f       // rpm/s
+#define TRAJ_MAX_JERK       500.0f      // rpm/s^2
+
+// Oversampled velocity feedback
+// The QEI velocity is sampled QEI_OVERSAMPLE times per control sample and the
+// tick counts are decimated by a CIC decimator of order CIC_ORDER. An order of
+// 1 gives the same measurement as sampling at FS.
+#define QEI_OVERSAMPLE      20          // Samples per control sample (1 kHz)
+#define CIC_ORDER           2
+
+// Smith predictor
+// Transport delay between the control signal and the measured speed, in
+// samples. This covers the PWM period, the ESC and the QEI sample. With the
+// delay removed from the loop, the velocity gains are raised by
+// SMITH_GAIN_SCALE.
+#define SMITH_DELAY         1
+#define SMITH_GAIN_SCALE    2.0f
+
+// Online identification of the motor model
+// The forgetting factor gives a memory of about 1 / (1 - RLS_FORGETTING)
+// samples. The velocity gains are recalculated from the identified model every
+// RLS_RETUNE_SAMPLES samples.
+#define RLS_FORGETTING      0.998f
+#define RLS_RETUNE_SAMPLES  100
+
+// Event-triggered control
+// The velocity controller only runs when the error has changed by at least
+// EVENT_THRESHOLD since its last update, which is set above the speed
+// resolution of one encoder tick so that quantisation alone does not trigger
+// it, or when the integral action owed to skipped samples reaches
+// EVENT_OUTPUT_THRESHOLD. It runs at least once every EVENT_MAX_SKIP + 1
+// samples.
+#define EVENT_THRESHOLD         1.5f        // rpm
+#define EVENT_OUTPUT_THRESHOLD  0.05f       // V
+#define EVENT_MAX_SKIP          10
+
+// Relay autotuning of the velocity controller
+// The relay switches the voltage by AUTOTUNE_AMPLITUDE about the voltage which
+// holds the speed at AUTOTUNE_SETPOINT. The experiment fails if it does not
+// finish within AUTOTUNE_TIMEOUT samples.
+#define AUTOTUNE_SETPOINT   15.0f       // rpm
+#define AUTOTUNE_AMPLITUDE  2.0f        // V
+#define AUTOTUNE_HYSTERESIS 0.5f        // rpm
+#define AUTOTUNE_TIMEOUT    500
+#define AUTOTUNE_RULE       AUTOTUNE_ZIEGLER_NICHOLS_PI
+
+// Explicit MPC disturbance estimate
+// Each sample the estimate of the disturbance at the input of the motor is
+// moved by this fraction of the error in the predicted speed, so it settles in
+// about 1 / MPC_OBSERVER_GAIN samples.
+#define MPC_OBSERVER_GAIN   0.2f
+
+// Fixed point controller coefficients
+// These are laid out in the same way as the FPGA controller (Controller.v)
+#define FIX_PROP_COEFF1     FIX_POINT(KP * SW_B)
+#define FIX_PROP_COEFF2     FIX_POINT(KP)
+#define FIX_INT_COEFF       FIX_POINT(INT_COEFF)
+#define FIX_DER_COEFF1      FIX_POINT(DER_COEFF1 * SW_C * DER_COEFF2)
+#define FIX_DER_COEFF2      FIX_POINT(DER_COEFF1 * DER_COEFF2)
+#define FIX_DER_COEFF3      FIX_POINT(DER_COEFF2)
+#define FIX_OUTPUT_MIN      FIX_POINT(OUTPUT_MIN)
+#define FIX_OUTPUT_MAX      FIX_POINT(OUTPUT_MAX)
+
 #endif
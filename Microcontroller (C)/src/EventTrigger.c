@@ -0,0 +1,122 @@
+/*
+ * EventTrigger.c
+ *
+ * Event-triggered operation of the PID controller.
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team
+ */
+
+#include <stddef.h>
+
+#include "EventTrigger.h"
+
+void eventTriggerInit(struct eventTrigger *trigger, struct pidController *pid,
+                      float threshold, float outputThreshold, uint32_t maxSkip) {
+    if (trigger == NULL)
+        return;
+
+    trigger->pid = pid;
+    trigger->threshold = threshold;
+    trigger->outputThreshold = outputThreshold;
+    trigger->maxSkip = maxSkip;
+
+    // Force an update in the first sample
+    trigger->lastError = 0.0f;
+    trigger->integralStep = 0.0f;
+    trigger->owed = 0.0f;
+    trigger->skipped = maxSkip;
+
+    trigger->samples = 0;
+    trigger->updates = 0;
+    trigger->resetPending = false;
+}
+
+bool runEventTriggeredAlgorithm(struct eventTrigger *trigger) {
+    if (trigger == NULL)
+        return false;
+
+    struct pidController *pid = trigger->pid;
+    float error = *(pid->setpoint) - *(pid->feedback);
+    float change = error - trigger->lastError;
+
+    // The statistics are only written here, so that an interrupt between
+    // clearing the samples and the updates cannot leave more updates than
+    // samples
+    if (trigger->resetPending) {
+        trigger->samples = 0;
+        trigger->updates = 0;
+        trigger->resetPending = false;
+    }
+
+    trigger->samples++;
+
+    // Skipping this sample would leave owed + integralStep of integral action
+    // to be applied at the next update
+    float owed = trigger->owed + trigger->integralStep;
+
+    if (change < trigger->threshold && change > -trigger->threshold
+            && owed < trigger->outputThreshold && owed > -trigger->outputThreshold
+            && trigger->skipped < trigger->maxSkip) {
+        trigger->owed = owed;
+        trigger->skipped++;
+        return false;
+    }
+
+    // Integrate the error held over the skipped samples
+    pid->integrator += trigger->owed;
+
+    float controlSignal = runControlAlgorithm(pid);
+
+    // The coefficients are read after the update so that a retune which has
+    // just been applied is used. While the output is clamped, the anti-windup
+    // of the controller decides what is integrated at each update, so nothing
+    // is owed in between.
+    const struct pidCoefficients *coeffs = pidActiveCoefficients(pid);
+    if (controlSignal <= coeffs->outputMin || controlSignal >= coeffs->outputMax)
+        trigger->integralStep = 0.0f;
+    else
+        trigger->integralStep = coeffs->intCoeff * error;
+    trigger->owed = 0.0f;
+    trigger->lastError = error;
+    trigger->skipped = 0;
+    trigger->updates++;
+
+    return true;
+}
+
+float eventTriggerSkipRatio(const struct eventTrigger *trigger) {
+    if (trigger == NULL || trigger->resetPending)
+        return 0.0f;
+
+    // As in eventTriggerTimeSaved()
+    uint32_t updates = trigger->updates;
+    uint32_t samples = trigger->samples;
+    if (samples == 0)
+        return 0.0f;
+
+    return 1.0f - (float)updates / (float)samples;
+}
+
+float eventTriggerTimeSaved(const struct eventTrigger *trigger, float periodicCost,
+                            float updateCost, float skipCost) {
+    if (trigger == NULL || trigger->resetPending)
+        return 0.0f;
+
+    // The interrupt counts the sample before the update, so reading the
+    // updates first never gives more updates than samples
+    uint32_t updates = trigger->updates;
+    uint32_t samples = trigger->samples;
+
+    return (float)samples * periodicCost - (float)updates * updateCost
+         - (float)(samples - updates) * skipCost;
+}
+
+void eventTriggerResetStatistics(struct eventTrigger *trigger) {
+    if (trigger == NULL)
+        return;
+
+    trigger->resetPending = true;
+}
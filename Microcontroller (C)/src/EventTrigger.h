@@ -0,0 +1,96 @@
+/*
+ * EventTrigger.h
+ *
+ * Event-triggered operation of the PID controller.
+ *
+ * At steady state the error hardly changes from one sample to the next, so
+ * recalculating the control signal (and rewriting the PWM registers) every
+ * sample does little. runEventTriggeredAlgorithm() holds the previous control
+ * signal, and the caller can skip its output, unless
+ *
+ *      - the error has changed by at least a threshold since the last update,
+ *      - the integral action owed for the skipped samples has reached an
+ *        output threshold, or
+ *      - a maximum number of samples have been skipped.
+ *
+ * The integrator would lose the error of every skipped sample, so when the
+ * controller next runs the error of the last update, multiplied by the number
+ * of samples skipped since, is added to the integrator first. As the error
+ * changed by less than the threshold while samples were skipped, this is close
+ * to the error the integrator would have accumulated. The output threshold
+ * limits how late that integral action is applied, so samples are only
+ * skipped while the error is small. Without it the delayed integral action
+ * makes the loop oscillate.
+ *
+ * No integral action is owed while the last control signal was clamped to the
+ * output limits, as adding it at the next update would bypass the anti-windup
+ * of the controller.
+ *
+ * The number of samples and updates is counted so that the fraction of
+ * skipped samples can be read at run time. eventTriggerTimeSaved() combines
+ * them with the cost of runControlAlgorithm() and of an update and a skipped
+ * sample (measured by bin/host/eventTriggerBenchmark) to give the processor
+ * time saved.
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team
+ */
+
+#ifndef EVENT_TRIGGER_H
+#define EVENT_TRIGGER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "PIDController.h"
+
+// A trigger must be set up with eventTriggerInit() before use.
+struct eventTrigger {
+    struct pidController *pid;
+
+    float threshold;
+    float outputThreshold;
+    uint32_t maxSkip;
+
+    float lastError;            // Error at the last update
+    float integralStep;         // Integral action per skipped sample
+    float owed;                 // Integral action owed for skipped samples
+    uint32_t skipped;           // Samples skipped since the last update
+
+    // Statistics, only written by runEventTriggeredAlgorithm()
+    volatile uint32_t samples;
+    volatile uint32_t updates;
+    volatile bool resetPending;
+};
+
+// Set up a trigger for a controller which has already been set up with
+// pidInit(). The controller runs when the error changes by at least threshold,
+// when the integral action owed reaches outputThreshold, and at least once
+// every maxSkip + 1 samples.
+void eventTriggerInit(struct eventTrigger *trigger, struct pidController *pid,
+                      float threshold, float outputThreshold, uint32_t maxSkip);
+
+// Run the controller if the error has changed enough. Returns true if the
+// control signal was updated.
+bool runEventTriggeredAlgorithm(struct eventTrigger *trigger);
+
+// Fraction of samples skipped since the statistics were last reset.
+float eventTriggerSkipRatio(const struct eventTrigger *trigger);
+
+// Processor time saved since the statistics were last reset, compared with
+// running runControlAlgorithm() every sample. The costs of a sample of
+// runControlAlgorithm() and of an update and a skipped sample of
+// runEventTriggeredAlgorithm() may be in any unit, such as cycles, and the
+// result is in the same unit. It is negative if the trigger costs more than it
+// saves.
+float eventTriggerTimeSaved(const struct eventTrigger *trigger, float periodicCost,
+                            float updateCost, float skipCost);
+
+// Reset the statistics. This may be called from the main program while the
+// trigger runs in an interrupt: the counts are cleared by the interrupt at the
+// start of its next sample, and until then the statistics read as zero.
+void eventTriggerResetStatistics(struct eventTrigger *trigger);
+
+#endif
@@ -0,0 +1,122 @@
+/*
+ * ExplicitMPC.c
+ *
+ * Explicit model predictive controller for the motor.
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team
+ */
+
+#include <stddef.h>
+
+#include "ExplicitMPC.h"
+#include "ControllerParameters.h"
+
+static const struct mpcRegion mpcRegions[MPC_NUM_REGIONS] = MPC_REGIONS;
+
+// Largest constraint value of a region at (w, r, d), which is not positive when
+// the point is inside the region
+static float regionViolation(const struct mpcRegion *region, float w, float r,
+                             float d);
+
+void mpcInit(struct mpcController *mpc, volatile float *setpoint,
+             volatile float *feedback, volatile float *controlSignal) {
+    if (mpc == NULL)
+        return;
+
+    mpc->regions = mpcRegions;
+    mpc->numRegions = MPC_NUM_REGIONS;
+
+    mpc->outputMin = OUTPUT_MIN;
+    mpc->outputMax = OUTPUT_MAX;
+
+    mpc->setpoint = setpoint;
+    mpc->feedback = feedback;
+    mpc->controlSignal = controlSignal;
+
+    mpc->region = 0;
+
+    mpc->disturbance = 0.0f;
+    mpc->prevFeedback = 0.0f;
+    mpc->prevControlSignal = 0.0f;
+    mpc->started = false;
+}
+
+float runMpcAlgorithm(struct mpcController *mpc) {
+    if (mpc == NULL)
+        return 0;
+
+    float w = *(mpc->feedback);
+    float r = *(mpc->setpoint);
+
+    // Disturbance estimate
+    // -------------------------------------------------------------------------
+    // Any error in the predicted speed is caused by a disturbance (or an error
+    // in the model, which acts as one). The estimate is limited to the range
+    // covered by the table.
+    if (mpc->started) {
+        float predicted = MPC_MODEL_A * mpc->prevFeedback
+                        + MPC_MODEL_B * (mpc->prevControlSignal + mpc->disturbance);
+        mpc->disturbance += MPC_OBSERVER_GAIN * (w - predicted) / MPC_MODEL_B;
+
+        if (mpc->disturbance > MPC_DISTURBANCE_LIMIT)
+            mpc->disturbance = MPC_DISTURBANCE_LIMIT;
+        else if (mpc->disturbance < -MPC_DISTURBANCE_LIMIT)
+            mpc->disturbance = -MPC_DISTURBANCE_LIMIT;
+    }
+    float d = mpc->disturbance;
+
+    // Point location
+    // -------------------------------------------------------------------------
+    // The region rarely changes between samples so it is checked first. If no
+    // region contains the point (only possible outside the range covered by
+    // the table) the region it is closest to being inside is used.
+    uint32_t found = mpc->region;
+    float best = regionViolation(&mpc->regions[found], w, r, d);
+
+    for (uint32_t i = 0; i < mpc->numRegions && best > MPC_TOLERANCE; i++) {
+        float violation = regionViolation(&mpc->regions[i], w, r, d);
+        if (violation < best) {
+            best = violation;
+            found = i;
+        }
+    }
+
+    mpc->region = found;
+
+    // Affine control law
+    // -------------------------------------------------------------------------
+    const float *law = mpc->regions[found].law;
+    float controlSignal = law[0] * w + law[1] * r + law[2] * d + law[3];
+
+    // Saturate control signal in case the point was outside the table
+    if (controlSignal < mpc->outputMin)
+        controlSignal = mpc->outputMin;
+    else if (controlSignal > mpc->outputMax)
+        controlSignal = mpc->outputMax;
+
+    *(mpc->controlSignal) = controlSignal;
+
+    mpc->prevFeedback = w;
+    mpc->prevControlSignal = controlSignal;
+    mpc->started = true;
+
+    return controlSignal;
+}
+
+static float regionViolation(const struct mpcRegion *region, float w, float r,
+                             float d) {
+    float violation = region->constraints[0][0] * w + region->constraints[0][1] * r
+                    + region->constraints[0][2] * d + region->constraints[0][3];
+
+    for (uint32_t i = 1; i < region->numConstraints; i++) {
+        const float *c = region->constraints[i];
+        float value = c[0] * w + c[1] * r + c[2] * d + c[3];
+        if (value > violation)
+            violation = value;
+    }
+
+    return violation;
+}
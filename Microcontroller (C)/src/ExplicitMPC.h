@@ -0,0 +1,84 @@
+/*
+ * ExplicitMPC.h
+ *
+ * Explicit model predictive controller for the motor.
+ *
+ * The constrained optimisation of a model predictive controller is solved
+ * offline by Scripts/generate_mpc_table.py for every speed, setpoint and
+ * disturbance. The solution is a piecewise-affine function: the space of
+ * (speed, setpoint, disturbance) is divided into convex regions, each with its
+ * own affine control law. The regions are stored in MPCTable.h, so running the
+ * controller only requires finding the region containing the current point,
+ * then evaluating one affine law.
+ *
+ * The disturbance is a constant voltage at the input of the motor. It is
+ * estimated each sample from the error in the speed predicted by the model, so
+ * it absorbs both loads and errors in the model. The steady-state voltage is
+ * corrected by the estimate, which gives the controller integral action: there
+ * is no steady-state error for a constant load or a wrong static gain.
+ *
+ * Regions are searched starting with the region found in the previous sample,
+ * then in the order of the table (most common first). At most every constraint
+ * of every region is checked once, so the worst case cost is bounded by
+ * MPC_NUM_REGIONS * MPC_MAX_CONSTRAINTS constraint evaluations.
+ *
+ * The controller takes the same inputs and output as the PID controller so it
+ * can be used in place of runControlAlgorithm(). The table must be regenerated
+ * whenever MotorParameters.h or the output limits change.
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team
+ */
+
+#ifndef EXPLICIT_MPC_H
+#define EXPLICIT_MPC_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "MPCTable.h"
+
+// Allowed constraint violation (in rpm) when checking whether a point is inside
+// a region, so that points on a shared boundary are found despite rounding
+#define MPC_TOLERANCE   1E-3f
+
+// One region of the piecewise-affine control law. A point (w, r, d) is inside
+// the region if c[0] * w + c[1] * r + c[2] * d + c[3] <= 0 for each constraint
+// c, where the constraints are normalised so that the value is a distance in
+// rpm.
+struct mpcRegion {
+    float constraints[MPC_MAX_CONSTRAINTS][4];
+    uint32_t numConstraints;
+    float law[4];
+};
+
+// A controller must be set up with mpcInit() before use.
+struct mpcController {
+    const struct mpcRegion *regions;
+    uint32_t numRegions;
+
+    float outputMin, outputMax;
+
+    volatile float *setpoint;
+    volatile float *feedback;
+    volatile float *controlSignal;
+
+    uint32_t region;            // Region found in the previous sample
+
+    // Disturbance estimate (in V), and the speed and control signal of the
+    // previous sample used to predict the current speed
+    float disturbance;
+    float prevFeedback, prevControlSignal;
+    bool started;               // Whether there is a previous sample
+};
+
+// Set up a controller using the generated region table and the memory
+// locations of its inputs and output.
+void mpcInit(struct mpcController *mpc, volatile float *setpoint,
+             volatile float *feedback, volatile float *controlSignal);
+
+float runMpcAlgorithm(struct mpcController *mpc);
+
+#endif
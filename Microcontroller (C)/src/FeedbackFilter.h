@@ -0,0 +1,27 @@
+/*
+ * FeedbackFilter.h
+ *
+ * Cascaded biquad filter coefficients for Biquad.h, generated by
+ * Scripts/generate_biquad.py. Do not edit this file by hand.
+ *
+ * Sample frequency: 50 Hz
+ * Butterworth low-pass, 10 Hz, order 2
+ */
+
+#ifndef FEEDBACK_FILTER_H
+#define FEEDBACK_FILTER_H
+
+#include "fix_t.h"
+
+#define FEEDBACK_FILTER_SECTIONS 1
+
+// Each section is { b0, b1, b2, a1, a2 }
+#define FEEDBACK_FILTER_COEFFS { \
+        { 0.206572084f, 0.413144168f, 0.206572084f, -0.369527377f, 0.195815713f } \
+    }
+
+#define FEEDBACK_FILTER_FIX_COEFFS { \
+        { FIX_POINT(0.206572084), FIX_POINT(0.413144168), FIX_POINT(0.206572084), FIX_POINT(-0.369527377), FIX_POINT(0.195815713) } \
+    }
+
+#endif
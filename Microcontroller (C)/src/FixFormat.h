@@ -0,0 +1,209 @@
+/*
+ * FixFormat.h
+ *
+ * Families of fixed point formats with different numbers of fraction bits,
+ * which can be used together in one build.
+ *
+ * fix_t has a single format (Q16), so every intermediate of a calculation has
+ * the same resolution and range. Small coefficients such as the proportional
+ * gain (0.0165, stored as 1081 / 65536) then lose most of their precision,
+ * while the FPGA already uses Q8 for voltageCoeff in System.v. With these
+ * families each value can use the format which keeps the most fraction bits
+ * without overflowing.
+ *
+ * FIX_DEFINE_FORMAT() generates a format. Each value is wrapped in a
+ * structure, so a value of one format cannot be passed where another format
+ * is expected, and mixing formats without a conversion is a compile error.
+ * Conversions between formats are made with FIX_RESCALE(), which rounds to
+ * the nearest value and saturates, or FIX_RESCALE_EXACT(), which fails to
+ * compile unless the destination can hold every value of the source exactly.
+ * FIX_MULTIPLY() multiplies values of two formats into a third, shifting the
+ * double length product once.
+ *
+ * All operations saturate on overflow and set a flag in fixStatus (see
+ * fix_t.h). Products are truncated, as in fixMultiply(). The number of
+ * fraction bits is a constant in every function, so after inlining each
+ * conversion is a single shift.
+ *
+ * The formats defined below are:
+ *
+ *      q8      Q23.8  in 32 bits   (System.v voltageCoeff)
+ *      q14     Q17.14 in 32 bits
+ *      q15     Q0.15  in 16 bits   (often written Q1.15)
+ *      q16     Q15.16 in 32 bits   (the same layout as fix_t)
+ *      q24     Q7.24  in 32 bits
+ *
+ * Usage:
+ *      static const q24_t kp = { FIX_Q(q24, KP) };
+ *      q16_t error = q16Sub(setpoint, feedback);
+ *      q16_t pTerm = FIX_MULTIPLY(q16, q24, kp, q16, error);
+ *      q14_t coarse = FIX_RESCALE(q14, q16, pTerm);
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team
+ */
+
+#ifndef FIX_FORMAT_H
+#define FIX_FORMAT_H
+
+#include <stdint.h>
+
+#include "fix_t.h"
+
+// Fail to compile if the constant condition is false. FIX_STATIC_ASSERT() is
+// used at file scope and FIX_STATIC_CHECK() in an expression.
+#define FIX_STATIC_ASSERT(cond, name) typedef char name[(cond) ? 1 : -1]
+#define FIX_STATIC_CHECK(cond) ((void)sizeof(char[(cond) ? 1 : -1]))
+
+// Largest value of a signed integer type
+#define FIX_STORAGE_MAX(storage) \
+    ((dint_t)(((uint64_t)1 << (8 * sizeof(storage) - 1)) - 1))
+
+// Raw value of a constant (integer or floating point) in a format, rounded to
+// the nearest value as in FIX_POINT(). For use in initialisers:
+//
+//      static const q24_t kp = { FIX_Q(q24, 0.0165) };
+#define FIX_Q(name, x) (                                                        \
+        ((x) >= 0)                                                              \
+        ? ((x) * (double)((int64_t)1 << name##_FRAC_BITS) + 0.5)                \
+        : ((x) * (double)((int64_t)1 << name##_FRAC_BITS) - 0.5)                \
+    )
+
+// Convert x from format `from` to format `to`, rounding to the nearest value
+// and saturating (setting FIX_STATUS_RESCALE_OVERFLOW). Passing a value which
+// is not of format `from` is an error.
+#define FIX_RESCALE(to, from, x) \
+    to##Rescale(from##Raw(x), from##_FRAC_BITS, FIX_STATUS_RESCALE_OVERFLOW)
+
+// Convert x from format `from` to format `to`, which must have at least as
+// many integer and fraction bits, so that the conversion is exact
+#define FIX_RESCALE_EXACT(to, from, x) (                                        \
+        FIX_STATIC_CHECK((int)to##_FRAC_BITS >= (int)from##_FRAC_BITS           \
+                         && (int)to##_INT_BITS >= (int)from##_INT_BITS),        \
+        FIX_RESCALE(to, from, x)                                                \
+    )
+
+// Multiply x of format xf by y of format yf, giving a value of format `to`.
+// The double length product is shifted once, so this is more precise than
+// rescaling either operand first.
+#define FIX_MULTIPLY(to, xf, x, yf, y)                                          \
+    to##Rescale((dint_t)xf##Raw(x) * yf##Raw(y),                                \
+                xf##_FRAC_BITS + yf##_FRAC_BITS, FIX_STATUS_MULTIPLY_OVERFLOW)
+
+// Define a format called `name` with fracBits fraction bits, stored in the
+// signed integer type `storage`, with products formed in `wide`, which must
+// be at least twice the size of `storage`. This defines
+//
+//      typedef struct { storage raw; } name_t;
+//      name_FRAC_BITS, name_INT_BITS           Fraction and integer bits
+//      name_t  nameFromRaw(storage raw);       Wrap a raw value
+//      storage nameRaw(name_t x);              Unwrap a raw value
+//      name_t  nameFromFloat(float x);         Round to nearest and saturate
+//      float   nameToFloat(name_t x);
+//      name_t  nameAdd(name_t x, name_t y);    Saturating arithmetic
+//      name_t  nameSub(name_t x, name_t y);
+//      name_t  nameMul(name_t x, name_t y);
+//      name_t  nameRescale(dint_t raw, int fracBits, word_t flag);
+//
+// nameRescale() converts a raw value with fracBits fraction bits, setting
+// `flag` in fixStatus if it saturates. Use FIX_RESCALE() rather than calling
+// it directly.
+#define FIX_DEFINE_FORMAT(name, storage, wide, fracBits)                        \
+    typedef struct {                                                            \
+        storage raw;                                                            \
+    } name##_t;                                                                 \
+                                                                                \
+    enum {                                                                      \
+        name##_FRAC_BITS = (fracBits),                                          \
+        name##_INT_BITS = 8 * sizeof(storage) - 1 - (fracBits)                  \
+    };                                                                          \
+                                                                                \
+    FIX_STATIC_ASSERT((fracBits) > 0 && (fracBits) < 8 * sizeof(storage),       \
+                      name##FracBitsValid);                                     \
+    FIX_STATIC_ASSERT(sizeof(wide) >= 2 * sizeof(storage), name##WideValid);    \
+                                                                                \
+    static inline name##_t name##FromRaw(storage raw) {                         \
+        return (name##_t){ raw };                                               \
+    }                                                                           \
+                                                                                \
+    static inline storage name##Raw(name##_t x) {                               \
+        return x.raw;                                                           \
+    }                                                                           \
+                                                                                \
+    /* Clamp to the range of the format, setting flag on overflow */            \
+    static inline name##_t name##Saturate(dint_t value, word_t flag) {          \
+        const dint_t max = FIX_STORAGE_MAX(storage), min = -max - 1;            \
+        fixStatus |= (word_t)(value > max || value < min) * flag;               \
+        return (name##_t){                                                      \
+            (storage)(value > max ? max : value < min ? min : value)            \
+        };                                                                      \
+    }                                                                           \
+                                                                                \
+    static inline name##_t name##FromFloat(float x) {                           \
+        const float scale = (float)((int64_t)1 << (fracBits));                  \
+        const float max = (float)FIX_STORAGE_MAX(storage);                      \
+        float scaled = x * scale + (x >= 0.0f ? 0.5f : -0.5f);                  \
+        if (scaled >= max)                                                      \
+            return name##Saturate(FIX_STORAGE_MAX(storage) + 1,                 \
+                                  FIX_STATUS_RESCALE_OVERFLOW);                 \
+        if (scaled <= -max)                                                     \
+            return name##Saturate(-FIX_STORAGE_MAX(storage) - 2,                \
+                                  FIX_STATUS_RESCALE_OVERFLOW);                 \
+        return (name##_t){ (storage)scaled };                                   \
+    }                                                                           \
+                                                                                \
+    static inline float name##ToFloat(name##_t x) {                             \
+        return (float)x.raw / (float)((int64_t)1 << (fracBits));                \
+    }                                                                           \
+                                                                                \
+    static inline name##_t name##Add(name##_t x, name##_t y) {                  \
+        return name##Saturate((dint_t)x.raw + y.raw, FIX_STATUS_ADD_OVERFLOW);  \
+    }                                                                           \
+                                                                                \
+    static inline name##_t name##Sub(name##_t x, name##_t y) {                  \
+        return name##Saturate((dint_t)x.raw - y.raw,                            \
+                              FIX_STATUS_SUBTRACT_OVERFLOW);                    \
+    }                                                                           \
+                                                                                \
+    static inline name##_t name##Mul(name##_t x, name##_t y) {                  \
+        wide product = (wide)x.raw * y.raw;                                     \
+        return name##Saturate(product >> (fracBits),                            \
+                              FIX_STATUS_MULTIPLY_OVERFLOW);                    \
+    }                                                                           \
+                                                                                \
+    static inline name##_t name##Rescale(dint_t raw, int srcFracBits,           \
+                                         word_t flag) {                         \
+        if (srcFracBits > (fracBits)) {                                         \
+            /* Round to the nearest value by adding half of the last bit */     \
+            int shift = srcFracBits - (fracBits);                               \
+            return name##Saturate((raw + ((dint_t)1 << (shift - 1))) >> shift,  \
+                                  flag);                                        \
+        } else {                                                                \
+            /* Clamp first so that the shift cannot overflow */                 \
+            int shift = (fracBits) - srcFracBits;                               \
+            const dint_t limit = ((FIX_STORAGE_MAX(storage) + 1) >> shift) + 1; \
+            dint_t clamped = raw > limit ? limit : raw < -limit ? -limit : raw; \
+            return name##Saturate(clamped * ((dint_t)1 << shift), flag);        \
+        }                                                                       \
+    }
+
+FIX_DEFINE_FORMAT(q8, int32_t, int64_t, 8)
+FIX_DEFINE_FORMAT(q14, int32_t, int64_t, 14)
+FIX_DEFINE_FORMAT(q15, int16_t, int32_t, 15)
+FIX_DEFINE_FORMAT(q16, int32_t, int64_t, 16)
+FIX_DEFINE_FORMAT(q24, int32_t, int64_t, 24)
+
+// q16 has the same layout as fix_t
+FIX_STATIC_ASSERT(q16_FRAC_BITS == Q_POINT, q16MatchesFix);
+
+static inline q16_t q16FromFix(fix_t x) {
+    return q16FromRaw(x);
+}
+
+static inline fix_t q16ToFix(q16_t x) {
+    return q16Raw(x);
+}
+
+#endif
@@ -0,0 +1,132 @@
+/*
+ * GainSchedule.c
+ *
+ * Gain scheduling for the PID controller.
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team
+ */
+
+#include <stddef.h>
+
+#include "GainSchedule.h"
+
+// Kept in RAM so that breakpoints can be replaced by gainScheduleRetune()
+static struct gainSchedulePoint gainScheduleTable[GAIN_SCHEDULE_POINTS] =
+    GAIN_SCHEDULE_TABLE;
+
+// Write the pending breakpoint into the table
+static void applyPendingPoint(struct gainSchedule *schedule);
+
+void gainScheduleInit(struct gainSchedule *schedule, struct pidController *pid,
+                      volatile float *variable) {
+    if (schedule == NULL)
+        return;
+
+    schedule->table = gainScheduleTable;
+    schedule->numPoints = GAIN_SCHEDULE_POINTS;
+    schedule->inverseSpacing = 1.0f / GAIN_SCHEDULE_SPACING;
+
+    schedule->variable = variable;
+    schedule->pid = pid;
+
+    schedule->pendingIndex = 0;
+    schedule->updatePending = false;
+}
+
+float runGainScheduledAlgorithm(struct gainSchedule *schedule) {
+    if (schedule == NULL)
+        return 0;
+
+    struct pidController *pid = schedule->pid;
+
+    if (schedule->updatePending)
+        applyPendingPoint(schedule);
+
+    // Position in the table, in breakpoint spacings
+    float position = *(schedule->variable) * schedule->inverseSpacing;
+    if (position < 0.0f)
+        position = -position;
+
+    const struct gainSchedulePoint *point;
+    float fraction;
+
+    if (position < (float)(schedule->numPoints - 1)) {
+        uint32_t index = (uint32_t)position;
+        point = &schedule->table[index];
+        fraction = position - (float)index;
+    } else {
+        point = &schedule->table[schedule->numPoints - 1];
+        fraction = 0.0f;
+    }
+
+    float kp = point->kp + fraction * point->kpSlope;
+
+    // The active bank is only used by this interrupt, so it can be written
+    // directly. The integrator absorbs the change in the proportional term.
+    struct pidCoefficients *coeffs = &pid->banks[pid->activeBank];
+    float error = coeffs->setWeightB * *(pid->setpoint) - *(pid->feedback);
+    pid->integrator += (coeffs->kp - kp) * error;
+
+    coeffs->kp = kp;
+    coeffs->intCoeff = point->intCoeff + fraction * point->intCoeffSlope;
+    coeffs->derCoeff1 = point->derCoeff1 + fraction * point->derCoeff1Slope;
+
+    return runControlAlgorithm(pid);
+}
+
+bool gainScheduleRetune(struct gainSchedule *schedule, float variable,
+                        const struct pidParameters *params) {
+    if (schedule == NULL || params == NULL || schedule->updatePending)
+        return false;
+
+    // Nearest breakpoint
+    float position = variable * schedule->inverseSpacing;
+    if (position < 0.0f)
+        position = -position;
+
+    if (position > (float)schedule->numPoints - 0.5f)
+        return false;
+
+    schedule->pendingIndex = (uint32_t)(position + 0.5f);
+    schedule->pending.kp = params->kp;
+    schedule->pending.intCoeff = params->ki / params->sampleFreq;
+    schedule->pending.derCoeff1 = params->kd * params->filterCoeff;
+
+    // The interrupt only reads the pending point once this is set
+    COMPILER_BARRIER();
+    schedule->updatePending = true;
+
+    return true;
+}
+
+static void applyPendingPoint(struct gainSchedule *schedule) {
+    uint32_t index = schedule->pendingIndex;
+    struct gainSchedulePoint *point = &schedule->table[index];
+
+    point->kp = schedule->pending.kp;
+    point->intCoeff = schedule->pending.intCoeff;
+    point->derCoeff1 = schedule->pending.derCoeff1;
+
+    // Slope from the previous breakpoint, and to the next. The last breakpoint
+    // has no slope.
+    if (index > 0) {
+        struct gainSchedulePoint *previous = point - 1;
+        previous->kpSlope = point->kp - previous->kp;
+        previous->intCoeffSlope = point->intCoeff - previous->intCoeff;
+        previous->derCoeff1Slope = point->derCoeff1 - previous->derCoeff1;
+    }
+
+    if (index < schedule->numPoints - 1) {
+        const struct gainSchedulePoint *next = point + 1;
+        point->kpSlope = next->kp - point->kp;
+        point->intCoeffSlope = next->intCoeff - point->intCoeff;
+        point->derCoeff1Slope = next->derCoeff1 - point->derCoeff1;
+    }
+
+    // The pending point may be overwritten once this is cleared
+    COMPILER_BARRIER();
+    schedule->updatePending = false;
+}
@@ -0,0 +1,88 @@
+/*
+ * GainSchedule.h
+ *
+ * Gain scheduling for the PID controller.
+ *
+ * The proportional, integral and derivative gains are interpolated from a
+ * table indexed by the magnitude of a scheduling variable, normally the speed
+ * (feedback) or the setpoint. The breakpoints of the table are uniformly
+ * spaced from zero, so the interval containing the variable is found with one
+ * multiplication, and the slope of each gain over each interval is stored in
+ * the table. A lookup therefore takes the same time for any value and table
+ * size. Beyond the last breakpoint the gains of the last breakpoint are used.
+ *
+ * The gains are stored as the coefficients used by runControlAlgorithm()
+ * (Kp, Ki * Ts and Kd * N) so they can be written straight into the active
+ * coefficient bank. When the proportional gain changes, the integrator absorbs
+ * the change in the proportional term so the control signal is continuous.
+ *
+ * The table is generated by Scripts/generate_gain_schedule.py from models of the
+ * motor at several speeds, and written to GainScheduleTable.h. It is copied
+ * to RAM, so that the breakpoints can also be built up on the board:
+ * gainScheduleRetune() replaces the gains of the breakpoint nearest a speed,
+ * such as with gains calculated by rlsTunePid() from the model identified
+ * there. Like pidRetune(), it may be called from the main program while the
+ * schedule runs in an interrupt, and the new gains are written into the table
+ * by the interrupt at the start of its next sample.
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team
+ */
+
+#ifndef GAIN_SCHEDULE_H
+#define GAIN_SCHEDULE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "PIDController.h"
+#include "GainScheduleTable.h"
+
+// One breakpoint of the table, with the slopes to the next breakpoint. Slopes
+// are per breakpoint spacing, so the gain at a fraction f of the way to the
+// next breakpoint is gain + f * slope.
+struct gainSchedulePoint {
+    float kp, intCoeff, derCoeff1;
+    float kpSlope, intCoeffSlope, derCoeff1Slope;
+};
+
+// A schedule must be set up with gainScheduleInit() before use.
+struct gainSchedule {
+    struct gainSchedulePoint *table;
+    uint32_t numPoints;
+    float inverseSpacing;
+
+    volatile float *variable;
+    struct pidController *pid;
+
+    // Gains of one breakpoint written by gainScheduleRetune(), waiting to be
+    // written into the table
+    struct gainSchedulePoint pending;
+    uint32_t pendingIndex;
+    volatile bool updatePending;
+};
+
+// Set up a schedule using the generated table for a controller which has
+// already been set up with pidInit(). The gains are looked up from the value at
+// the memory location variable.
+void gainScheduleInit(struct gainSchedule *schedule, struct pidController *pid,
+                      volatile float *variable);
+
+// Update the gains of the controller from the scheduling variable, then run
+// runControlAlgorithm(). Gains set by pidRetune() are replaced in the next
+// sample, but its other parameters are kept.
+float runGainScheduledAlgorithm(struct gainSchedule *schedule);
+
+// Replace the gains of the breakpoint nearest to a value of the scheduling
+// variable with those of params. The slopes of the intervals either side of it
+// are recalculated when the interrupt writes the new gains into the table.
+//
+// Returns false without changing the schedule if the value is more than half a
+// spacing beyond the last breakpoint, or a previous update has not been
+// written yet.
+bool gainScheduleRetune(struct gainSchedule *schedule, float variable,
+                        const struct pidParameters *params);
+
+#endif
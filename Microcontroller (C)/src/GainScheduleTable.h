@@ -0,0 +1,36 @@
+/*
+ * GainScheduleTable.h
+ *
+ * Gain schedule table for the velocity controller, generated by
+ * Scripts/generate_gain_schedule.py. Do not edit this file by hand.
+ *
+ * MotorParameters.h model at 0 rpm: gain = 23.8095, time constant = 0.229333
+ * MotorParameters.h model at 285.714 rpm: gain = 23.8095, time constant = 0.458667
+ * Design: damping = 0.2288, natural frequency = 12.94 rad/s
+ */
+
+#ifndef GAIN_SCHEDULE_TABLE_H
+#define GAIN_SCHEDULE_TABLE_H
+
+// Number of different models the table was generated from. With fewer than
+// two, every breakpoint has the same gains.
+#define GAIN_SCHEDULE_MODELS    2
+
+#define GAIN_SCHEDULE_POINTS    9
+#define GAIN_SCHEDULE_SPACING   35.7142857f     // rpm
+
+// Each breakpoint is { Kp, Ki * Ts, Kd * N, and the slope of each to the next
+// breakpoint }, starting from zero speed
+#define GAIN_SCHEDULE_TABLE { \
+        { 0.0165f, 0.032904f, 0.0f, 0.00672593568f, 0.00378308013f, 0.0f },   /* 0.0 rpm */ \
+        { 0.0232259357f, 0.0366870801f, 0.0f, 0.00672593568f, 0.00378308013f, 0.0f },   /* 35.7 rpm */ \
+        { 0.0299518714f, 0.0404701603f, 0.0f, 0.00672593568f, 0.00378308013f, 0.0f },   /* 71.4 rpm */ \
+        { 0.036677807f, 0.0442532404f, 0.0f, 0.00672593568f, 0.00378308013f, 0.0f },   /* 107.1 rpm */ \
+        { 0.0434037427f, 0.0480363205f, 0.0f, 0.00672593568f, 0.00378308013f, 0.0f },   /* 142.9 rpm */ \
+        { 0.0501296784f, 0.0518194007f, 0.0f, 0.00672593568f, 0.00378308013f, 0.0f },   /* 178.6 rpm */ \
+        { 0.0568556141f, 0.0556024808f, 0.0f, 0.00672593568f, 0.00378308013f, 0.0f },   /* 214.3 rpm */ \
+        { 0.0635815498f, 0.0593855609f, 0.0f, 0.00672593568f, 0.00378308013f, 0.0f },   /* 250.0 rpm */ \
+        { 0.0703074855f, 0.0631686411f, 0.0f, 0.0f, 0.0f, 0.0f }   /* 285.7 rpm */ \
+    }
+
+#endif
@@ -0,0 +1,124 @@
+/*
+ * MPCTable.h
+ *
+ * Region table for the explicit model predictive controller, generated by
+ * Scripts/generate_mpc_table.py. Do not edit this file by hand.
+ *
+ * Model: DC_GAIN = 23.8095, TIME_CONSTANT = 0.229333, FS = 50
+ * Output limits: [-12, 12], disturbance limit: 6
+ * Horizon: 4, Q = 1, R = 1, P = 1.18846
+ */
+
+#ifndef MPC_TABLE_H
+#define MPC_TABLE_H
+
+#define MPC_HORIZON             4
+#define MPC_WEIGHT_Q            1.0f
+#define MPC_WEIGHT_R            1.0f
+#define MPC_WEIGHT_P            1.18846337f
+
+// Discrete model of the motor, w[k+1] = a w[k] + b (u[k] + d[k]), used to
+// estimate the disturbance d
+#define MPC_MODEL_A             0.919786076f
+#define MPC_MODEL_B             1.90985533f
+#define MPC_DISTURBANCE_LIMIT   6.0f
+
+#define MPC_NUM_REGIONS         9
+#define MPC_MAX_CONSTRAINTS     8
+
+// Each region is { { constraints }, number of constraints, { law } } where a
+// point (w, r, d) is inside the region if c[0] w + c[1] r + c[2] d + c[3] <= 0
+// for every constraint and the control signal is
+// law[0] w + law[1] r + law[2] d + law[3]
+#define MPC_REGIONS { \
+        { { \
+            { 0.624262852f, -0.767896627f, 3.41985179f, 41.0382215f }, \
+            { 0.602571072f, -0.77844492f, 4.18747256f, 50.2496707f }, \
+            { 0.580906659f, -0.787354316f, 4.91542041f, 58.985045f }, \
+            { 0.558669276f, -0.795005541f, 5.62705394f, 67.5246472f } \
+          }, \
+          4, \
+          { 0.0f, 0.0f, 0.0f, 12.0f } }, \
+        { { \
+            { -0.624262852f, 0.767896627f, -3.41985179f, 41.0382215f }, \
+            { -0.602571072f, 0.77844492f, -4.18747256f, 50.2496707f }, \
+            { -0.580906659f, 0.787354316f, -4.91542041f, 58.985045f }, \
+            { -0.558669276f, 0.795005541f, -5.62705394f, 67.5246472f } \
+          }, \
+          4, \
+          { 0.0f, 0.0f, 0.0f, -12.0f } }, \
+        { { \
+            { -0.66849759f, 0.740245382f, -1.70828076f, -20.4993691f }, \
+            { 0.66849759f, -0.740245382f, 1.70828076f, -20.4993691f }, \
+            { -0.498747899f, 0.809229199f, -7.3924119f, -88.7089428f }, \
+            { 0.498747899f, -0.809229199f, 7.3924119f, -88.7089428f }, \
+            { -0.168318472f, 0.776078067f, -14.4704665f, -173.645599f }, \
+            { 0.168318472f, -0.776078067f, 14.4704665f, -173.645599f }, \
+            { -0.0329487462f, 0.723005183f, -16.4299152f, -197.158982f }, \
+            { 0.0329487462f, -0.723005183f, 16.4299152f, -197.158982f } \
+          }, \
+          8, \
+          { -0.391327706f, 0.433327706f, -1.0f, 0.0f } }, \
+        { { \
+            { 0.66849759f, -0.740245382f, 1.70828076f, 20.4993691f }, \
+            { -0.633604715f, 0.762794284f, -3.07594213f, -36.9113055f }, \
+            { 0.633604715f, -0.762794284f, 3.07594213f, -5.3363112f }, \
+            { -0.461486788f, 0.814072168f, -8.39488999f, -100.73868f }, \
+            { 0.461486788f, -0.814072168f, 8.39488999f, -77.7409931f }, \
+            { -0.153878817f, 0.771375138f, -14.7022934f, -176.42752f }, \
+            { 0.153878817f, -0.771375138f, 14.7022934f, -168.759139f } \
+          }, \
+          7, \
+          { 0.0f, 0.0f, 0.0f, 12.0f } }, \
+        { { \
+            { -0.66849759f, 0.740245382f, -1.70828076f, 20.4993691f }, \
+            { -0.633604715f, 0.762794284f, -3.07594213f, -5.3363112f }, \
+            { 0.633604715f, -0.762794284f, 3.07594213f, -36.9113055f }, \
+            { -0.461486788f, 0.814072168f, -8.39488999f, -77.7409931f }, \
+            { 0.461486788f, -0.814072168f, 8.39488999f, -100.73868f }, \
+            { -0.153878817f, 0.771375138f, -14.7022934f, -168.759139f }, \
+            { 0.153878817f, -0.771375138f, 14.7022934f, -176.42752f } \
+          }, \
+          7, \
+          { 0.0f, 0.0f, 0.0f, -12.0f } }, \
+        { { \
+            { 0.654229799f, -0.750184076f, 2.28462565f, 27.4155078f }, \
+            { 0.633604715f, -0.762794284f, 3.07594213f, 36.9113055f }, \
+            { -0.596698989f, 0.78101163f, -4.38839621f, -52.6607545f }, \
+            { 0.596698989f, -0.78101163f, 4.38839621f, 9.404164f }, \
+            { -0.42560315f, 0.816247073f, -9.30104579f, -111.61255f }, \
+            { 0.42560315f, -0.816247073f, 9.30104579f, -67.3439563f } \
+          }, \
+          6, \
+          { 0.0f, 0.0f, 0.0f, 12.0f } }, \
+        { { \
+            { -0.654229799f, 0.750184076f, -2.28462565f, 27.4155078f }, \
+            { -0.633604715f, 0.762794284f, -3.07594213f, 36.9113055f }, \
+            { -0.596698989f, 0.78101163f, -4.38839621f, 9.404164f }, \
+            { 0.596698989f, -0.78101163f, 4.38839621f, -52.6607545f }, \
+            { -0.42560315f, 0.816247073f, -9.30104579f, -67.3439563f }, \
+            { 0.42560315f, -0.816247073f, 9.30104579f, -111.61255f } \
+          }, \
+          6, \
+          { 0.0f, 0.0f, 0.0f, -12.0f } }, \
+        { { \
+            { 0.639220308f, -0.759551114f, 2.86501919f, 34.3802303f }, \
+            { 0.618389441f, -0.770926108f, 3.63182543f, 43.5819051f }, \
+            { 0.596698989f, -0.78101163f, 4.38839621f, 52.6607545f }, \
+            { -0.558669276f, 0.795005541f, -5.62705394f, -67.5246472f }, \
+            { 0.558669276f, -0.795005541f, 5.62705394f, 23.4929993f } \
+          }, \
+          5, \
+          { 0.0f, 0.0f, 0.0f, 12.0f } }, \
+        { { \
+            { -0.639220308f, 0.759551114f, -2.86501919f, 34.3802303f }, \
+            { -0.618389441f, 0.770926108f, -3.63182543f, 43.5819051f }, \
+            { -0.596698989f, 0.78101163f, -4.38839621f, 52.6607545f }, \
+            { -0.558669276f, 0.795005541f, -5.62705394f, 23.4929993f }, \
+            { 0.558669276f, -0.795005541f, 5.62705394f, -67.5246472f } \
+          }, \
+          5, \
+          { 0.0f, 0.0f, 0.0f, -12.0f } } \
+    }
+
+#endif
@@ -7,6 +7,16 @@
 #define DC_GAIN             23.8095238095f
 #define TIME_CONSTANT        0.2293332714f
 
+// Time constant at full speed (DC_GAIN * OUTPUT_MAX). The load on the wheel
+// grows with speed, so the time constant is taken to rise linearly from
+// TIME_CONSTANT at rest to this. It is an estimate until the motor is measured
+// at several speeds, and is used to generate GainScheduleTable.h.
+#define TIME_CONSTANT_FULL_SPEED    0.4586665428f
+
+// Inverse of the static gain of the motor, used as the feedforward gain of the
+// velocity controller (in V/rpm)
+#define FEEDFORWARD_GAIN    (1.0f / DC_GAIN)
+
 #define COEFF_V             TS * DC_GAIN / (TS + TIME_CONSTANT)
 #define COEFF_W             TIME_CONSTANT / (TS + TIME_CONSTANT)
 
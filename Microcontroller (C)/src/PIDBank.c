@@ -0,0 +1,62 @@
+/*
+ * PIDBank.c
+ *
+ * A bank of PID controllers which share the same gains, such as the wheel
+ * motors of a rover, and are all updated in a single call.
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team
+ */
+
+#include <stddef.h>
+
+#include "PIDBank.h"
+
+// Run the control algorithm over arrays of channels. This is separate from
+// runPidBank() so that the arrays can be declared restrict as parameters, which
+// is what allows the compiler to process several channels at once.
+static void runChannels(uint32_t numChannels,
+                        float kp, float setWeightB, float setWeightC,
+                        float outputMin, float outputMax,
+                        float intCoeff, float derCoeff1, float derCoeff2,
+                        const float *restrict setpoint,
+                        const float *restrict feedback,
+                        float *restrict controlSignal,
+                        float *restrict integrator,
+                        float *restrict differentiator,
+                        float *restrict prevError) {
+    for (uint32_t i = 0; i < numChannels; i++) {
+        float pTerm = kp * (setWeightB * setpoint[i] - feedback[i]);
+        float iTerm = intCoeff * (setpoint[i] - feedback[i]) + integrator[i];
+        float swcError = setWeightC * setpoint[i] - feedback[i];
+        float dTerm = derCoeff2 * (differentiator[i] + derCoeff1 * (swcError - prevError[i]));
+
+        float control = pTerm + iTerm + dTerm;
+
+        // Saturate control signal if required. Written as two independent
+        // selections (rather than if/else) so they map to min/max instructions.
+        control = (control < outputMin) ? outputMin : control;
+        control = (control > outputMax) ? outputMax : control;
+
+        // Update pid states
+        integrator[i] = iTerm;
+        differentiator[i] = dTerm;
+        prevError[i] = swcError;
+
+        controlSignal[i] = control;
+    }
+}
+
+void runPidBank(struct pidBank *bank) {
+    if (bank == NULL)
+        return;
+
+    runChannels(bank->numChannels,
+                bank->kp, bank->setWeightB, bank->setWeightC,
+                bank->outputMin, bank->outputMax,
+                bank->intCoeff, bank->derCoeff1, bank->derCoeff2,
+                bank->setpoint, bank->feedback, bank->controlSignal,
+                bank->integrator, bank->differentiator, bank->prevError);
+}
@@ -0,0 +1,49 @@
+/*
+ * PIDBank.h
+ *
+ * A bank of PID controllers which share the same gains, such as the wheel
+ * motors of a rover, and are all updated in a single call.
+ *
+ * Controller inputs, outputs and states are stored as one contiguous array per
+ * quantity (struct of arrays) rather than one struct per controller. This lets
+ * the compiler process several channels per instruction where the processor
+ * supports it, and avoids repeating the coefficient loads for every channel.
+ *
+ * The algorithm for each channel is identical to runControlAlgorithm().
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team
+ */
+
+#ifndef PID_BANK_H
+#define PID_BANK_H
+
+#include <stdint.h>
+
+// Arrays are provided by the caller and must each hold at least numChannels
+// elements. The arrays must not overlap.
+struct pidBank {
+    const float kp;
+    const float setWeightB, setWeightC;
+    const float outputMin, outputMax;
+
+    const float intCoeff;
+    const float derCoeff1, derCoeff2;
+
+    const uint32_t numChannels;
+
+    const float *const setpoint;
+    const float *const feedback;
+    float *const controlSignal;
+
+    float *const integrator;
+    float *const differentiator;
+    float *const prevError;
+};
+
+// Run the control algorithm once for every channel in the bank.
+void runPidBank(struct pidBank *bank);
+
+#endif
@@ -20,17 +20,197 @@
 #include <stddef.h>
 
 #include "PIDController.h"
+#include "PIDProfile.h"
+
+// Calculate control algorithm coefficients from a set of parameters.
+static void calculateCoefficients(const struct pidParameters *params,
+                                  struct pidCoefficients *coeffs);
+
+// Make the inactive coefficient bank active, adjusting the controller states
+// so that the control signal is continuous.
+static void swapCoefficientBanks(struct pidController *pid);
+
+void pidInit(struct pidController *pid, const struct pidParameters *params,
+             volatile float *setpoint, volatile float *feedback,
+             volatile float *controlSignal) {
+    if (pid == NULL || params == NULL)
+        return;
+
+    calculateCoefficients(params, &pid->banks[0]);
+    pid->banks[1] = pid->banks[0];
+
+    pid->activeBank = 0;
+    pid->swapPending = false;
+
+    pid->setpoint = setpoint;
+    pid->feedback = feedback;
+    pid->controlSignal = controlSignal;
+
+    pid->integrator = 0.0f;
+    pid->differentiator = 0.0f;
+    pid->prevError = 0.0f;
+
+    pid->feedforwardSetpoint = 0.0f;
+    pid->feedforward = 0.0f;
+}
+
+bool pidRetune(struct pidController *pid, const struct pidParameters *params) {
+    if (pid == NULL || params == NULL)
+        return false;
+
+    // The inactive bank may be about to become active
+    if (pid->swapPending)
+        return false;
+
+    calculateCoefficients(params, &pid->banks[pid->activeBank ^ 1]);
+
+    COMPILER_BARRIER();
+    pid->swapPending = true;
+
+    return true;
+}
 
 float runControlAlgorithm(struct pidController *pid) {
     if (pid == NULL)
         return 0;
 
-    float pTerm = pid->kp * (pid->setWeightB * *(pid->setpoint) - *(pid->feedback));
-    float iTerm = pid->intCoeff * (*(pid->setpoint) - *(pid->feedback)) + pid->integrator;
-    float swcError = pid->setWeightC * *(pid->setpoint) - *(pid->feedback);
-    float dTerm = pid->derCoeff2 * (pid->differentiator + pid->derCoeff1 * (swcError - pid->prevError));
+    // Apply new coefficients at the sample boundary
+    if (pid->swapPending)
+        swapCoefficientBanks(pid);
+
+    const struct pidCoefficients *coeffs = &pid->banks[pid->activeBank];
+
+    float pTerm = coeffs->kp * (coeffs->setWeightB * *(pid->setpoint) - *(pid->feedback));
+    float iTerm = coeffs->intCoeff * (*(pid->setpoint) - *(pid->feedback)) + pid->integrator;
+    float swcError = coeffs->setWeightC * *(pid->setpoint) - *(pid->feedback);
+    float dTerm = coeffs->derCoeff2 * (pid->differentiator + coeffs->derCoeff1 * (swcError - pid->prevError));
+
+    // Record the ranges of the intermediate values in a profiling build (see
+    // PIDProfile.h)
+    PID_PROFILE_RECORD(PID_PROFILE_SETPOINT, *(pid->setpoint));
+    PID_PROFILE_RECORD(PID_PROFILE_FEEDBACK, *(pid->feedback));
+    PID_PROFILE_RECORD(PID_PROFILE_P_TERM, pTerm);
+    PID_PROFILE_RECORD(PID_PROFILE_I_TERM, iTerm);
+    PID_PROFILE_RECORD(PID_PROFILE_SWC_ERROR, swcError);
+    PID_PROFILE_RECORD(PID_PROFILE_D_TERM, dTerm);
+
+    // The feedforward term is only recalculated when the setpoint changes. This
+    // saves a multiplication while the setpoint is held, but not while it is
+    // moved by a trajectory generator (SETPOINT_TRAJECTORY in system.c), which
+    // changes it every sample.
+    if (*(pid->setpoint) != pid->feedforwardSetpoint) {
+        pid->feedforwardSetpoint = *(pid->setpoint);
+        pid->feedforward = coeffs->feedforwardGain * pid->feedforwardSetpoint;
+    }
+
+    float controlSignal = pTerm + iTerm + dTerm + pid->feedforward;
+
+    // Saturate control signal if required
+    float unsaturated = controlSignal;
+    PID_PROFILE_RECORD(PID_PROFILE_CONTROL, unsaturated);
+
+    if (controlSignal < coeffs->outputMin)
+        controlSignal = coeffs->outputMin;
+    else if (controlSignal > coeffs->outputMax)
+        controlSignal = coeffs->outputMax;
+
+    // Limit integrator windup while saturated
+    if (controlSignal != unsaturated) {
+        if (coeffs->antiWindup == PID_ANTI_WINDUP_BACK_CALCULATION) {
+            iTerm += coeffs->trackCoeff * (controlSignal - unsaturated);
+        } else if (coeffs->antiWindup == PID_ANTI_WINDUP_CONDITIONAL) {
+            // Integrating the error would only increase the excess if it has
+            // the same sign
+            float excess = unsaturated - controlSignal;
+            float error = *(pid->setpoint) - *(pid->feedback);
+            if ((excess > 0.0f) == (error > 0.0f))
+                iTerm = pid->integrator;
+        }
+    }
+
+    // Update pid states
+    // -------------------------------------------------------------------------
+    pid->integrator = iTerm;
+    pid->differentiator = dTerm;
+    pid->prevError = swcError;
+
+    *(pid->controlSignal) = controlSignal;
+
+    return controlSignal;
+}
+
+void pidIncrementalInit(struct pidIncrementalController *pid,
+                        const struct pidParameters *params,
+                        volatile float *setpoint, volatile float *feedback,
+                        volatile float *controlSignal) {
+    if (pid == NULL || params == NULL)
+        return;
+
+    float sampleTime = 1.0f / params->sampleFreq;
+    float derGain = params->kd * params->sampleFreq;    // Kd / Ts
+
+    pid->q0 = params->kp + params->ki * sampleTime + derGain;
+    pid->q1 = -params->kp - 2.0f * derGain;
+    pid->q2 = derGain;
+
+    pid->outputMin = params->outputMin;
+    pid->outputMax = params->outputMax;
+
+    pid->setpoint = setpoint;
+    pid->feedback = feedback;
+    pid->controlSignal = controlSignal;
+
+    pid->prevError1 = 0.0f;
+    pid->prevError2 = 0.0f;
+    pid->prevControl = 0.0f;
+}
+
+float runIncrementalControlAlgorithm(struct pidIncrementalController *pid) {
+    if (pid == NULL)
+        return 0;
+
+    float error = *(pid->setpoint) - *(pid->feedback);
+
+    float controlSignal = pid->prevControl + pid->q0 * error
+                        + pid->q1 * pid->prevError1 + pid->q2 * pid->prevError2;
+
+    // Saturate control signal if required
+    if (controlSignal < pid->outputMin)
+        controlSignal = pid->outputMin;
+    else if (controlSignal > pid->outputMax)
+        controlSignal = pid->outputMax;
+
+    // Update pid states
+    // -------------------------------------------------------------------------
+    pid->prevError2 = pid->prevError1;
+    pid->prevError1 = error;
+    pid->prevControl = controlSignal;
+
+    *(pid->controlSignal) = controlSignal;
+
+    return controlSignal;
+}
+
+fix_t runFixControlAlgorithm(struct fixPidController *pid) {
+    if (pid == NULL)
+        return 0;
+
+    fix_t setpoint = *(pid->setpoint);
+    fix_t feedback = *(pid->feedback);
 
-    float controlSignal = pTerm + iTerm + dTerm;
+    // Each operation saturates on overflow, so an out of range term is held at
+    // the limit with the correct sign rather than becoming fixOverflow
+    fix_t pTerm = fixSubtractSat(fixMultiplySat(setpoint, pid->propCoeff1),
+                                 fixMultiplySat(feedback, pid->propCoeff2));
+    fix_t iTerm = fixAddSat(fixMultiplySat(fixSubtractSat(setpoint, feedback),
+                                           pid->intCoeff),
+                            pid->integrator);
+    fix_t dwError = fixSubtractSat(fixMultiplySat(setpoint, pid->derCoeff1),
+                                   fixMultiplySat(feedback, pid->derCoeff2));
+    fix_t dTerm = fixAddSat(fixSubtractSat(dwError, pid->prevError),
+                            fixMultiplySat(pid->differentiator, pid->derCoeff3));
+
+    fix_t controlSignal = fixAddSat(fixAddSat(pTerm, iTerm), dTerm);
 
     // Saturate control signal if required
     if (controlSignal < pid->outputMin)
@@ -38,14 +218,70 @@ float runControlAlgorithm(struct pidController *pid) {
     else if (controlSignal > pid->outputMax)
         controlSignal = pid->outputMax;
 
+    // Saturate integrator to the same limits as the FPGA implementation
+    if (iTerm < pid->outputMin)
+        iTerm = pid->outputMin;
+    else if (iTerm > pid->outputMax)
+        iTerm = pid->outputMax;
+
     // Update pid states
     // -------------------------------------------------------------------------
     pid->integrator = iTerm;
     pid->differentiator = dTerm;
-    pid->prevError = swcError;
+    pid->prevError = dwError;
 
     *(pid->controlSignal) = controlSignal;
 
     return controlSignal;
 }
 
+static void calculateCoefficients(const struct pidParameters *params,
+                                  struct pidCoefficients *coeffs) {
+    float sampleTime = 1.0f / params->sampleFreq;
+
+    coeffs->kp = params->kp;
+    coeffs->setWeightB = params->setWeightB;
+    coeffs->setWeightC = params->setWeightC;
+    coeffs->outputMin = params->outputMin;
+    coeffs->outputMax = params->outputMax;
+
+    coeffs->intCoeff = params->ki * sampleTime;
+    coeffs->derCoeff1 = params->kd * params->filterCoeff;
+    coeffs->derCoeff2 = 1.0f / (1.0f + params->filterCoeff * sampleTime);
+
+    coeffs->feedforwardGain = params->feedforwardGain;
+
+    coeffs->antiWindup = params->antiWindup;
+    coeffs->trackCoeff = params->trackingGain * sampleTime;
+}
+
+static void swapCoefficientBanks(struct pidController *pid) {
+    uint32_t next = pid->activeBank ^ 1;
+    const struct pidCoefficients *current = &pid->banks[pid->activeBank];
+    const struct pidCoefficients *new = &pid->banks[next];
+
+    float setpoint = *(pid->setpoint);
+    float feedback = *(pid->feedback);
+
+    // The integrator absorbs the change in the proportional term so that the
+    // control signal is the same as if the gains had not changed.
+    float currentPTerm = current->kp * (current->setWeightB * setpoint - feedback);
+    float newPTerm = new->kp * (new->setWeightB * setpoint - feedback);
+    pid->integrator += currentPTerm - newPTerm;
+
+    // Likewise for the feedforward term, which is recalculated for the
+    // current setpoint with the new gain
+    float currentFeedforward = current->feedforwardGain * setpoint;
+    float newFeedforward = new->feedforwardGain * setpoint;
+    pid->integrator += currentFeedforward - newFeedforward;
+    pid->feedforwardSetpoint = setpoint;
+    pid->feedforward = newFeedforward;
+
+    // The differentiator is left unchanged so that only new changes in the
+    // error are affected by the new derivative gain. A change in the derivative
+    // setpoint weight must not appear as a step in the error.
+    pid->prevError += (new->setWeightC - current->setWeightC) * setpoint;
+
+    pid->activeBank = next;
+    pid->swapPending = false;
+}
@@ -20,25 +20,188 @@
 #ifndef PID_CONTROLLER_H
 #define PID_CONTROLLER_H
 
-struct pidController {
-    const float kp, ki, kd;
-    const float setWeightB, setWeightC;
-    const float filterCoeff;
-    const float sampleTime, sampleFreq;
-    const float outputMin, outputMax;
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "fix_t.h"
+
+// Methods of preventing integrator windup while the control signal is
+// saturated.
+//
+//      - PID_ANTI_WINDUP_NONE: the integrator is always updated
+//      - PID_ANTI_WINDUP_BACK_CALCULATION: the amount by which the control
+//        signal exceeds the limits, multiplied by the tracking gain, is fed
+//        back into the integrator
+//      - PID_ANTI_WINDUP_CONDITIONAL: the integrator is held while the control
+//        signal is saturated and the error would drive it further into
+//        saturation
+enum pidAntiWindup {
+    PID_ANTI_WINDUP_NONE,
+    PID_ANTI_WINDUP_BACK_CALCULATION,
+    PID_ANTI_WINDUP_CONDITIONAL
+};
+
+// Prevent the compiler from moving memory accesses across this point. Used to
+// make sure data shared with an interrupt, such as a coefficient bank, is
+// completely written before a volatile flag marks it as ready to be used.
+#define COMPILER_BARRIER() __asm volatile("" ::: "memory")
+
+// Basic controller parameters from which the coefficients used by the control
+// algorithm are calculated.
+struct pidParameters {
+    float kp, ki, kd;
+    float setWeightB, setWeightC;
+    float filterCoeff;
+    float sampleFreq;
+    float outputMin, outputMax;
+
+    // Gain from the setpoint directly to the control signal, normally the
+    // inverse of the static gain of the plant (see FEEDFORWARD_GAIN in
+    // MotorParameters.h). Zero disables feedforward.
+    float feedforwardGain;
+
+    enum pidAntiWindup antiWindup;
+    float trackingGain;         // Back-calculation tracking gain Kt (in 1/s)
+};
+
+// Coefficients used directly by the control algorithm. These are calculated
+// from a struct pidParameters ahead of time so that running the algorithm does
+// not require any division.
+struct pidCoefficients {
+    float kp;
+    float setWeightB, setWeightC;
+    float outputMin, outputMax;
+
+    float intCoeff;
+    float derCoeff1, derCoeff2;
+
+    float feedforwardGain;
 
-    const float intCoeff;
-    const float derCoeff1, derCoeff2;
+    enum pidAntiWindup antiWindup;
+    float trackCoeff;
+};
+
+#define PID_NUM_COEFF_BANKS 2
+
+// The controller holds two coefficient banks. The control algorithm only uses
+// the active bank while pidRetune() writes to the inactive bank, then the banks
+// are swapped at the start of the next sample. This allows the controller to be
+// retuned from the main program while the control algorithm runs in an
+// interrupt, without disabling interrupts.
+//
+// A controller must be set up with pidInit() before use.
+struct pidController {
+    struct pidCoefficients banks[PID_NUM_COEFF_BANKS];
+    volatile uint32_t activeBank;
+    volatile bool swapPending;
 
-    volatile float *const setpoint;
-    volatile float *const feedback;
-    volatile float *const controlSignal;
+    volatile float *setpoint;
+    volatile float *feedback;
+    volatile float *controlSignal;
 
     float integrator;
     float differentiator;
     float prevError;
+
+    // Feedforward term and the setpoint it was calculated for. It is only
+    // recalculated when the setpoint changes.
+    float feedforwardSetpoint;
+    float feedforward;
 };
 
+// Set up a controller with an initial set of parameters and the memory
+// locations of its inputs and output. All controller states are reset.
+void pidInit(struct pidController *pid, const struct pidParameters *params,
+             volatile float *setpoint, volatile float *feedback,
+             volatile float *controlSignal);
+
+// Calculate coefficients for a new set of parameters into the inactive bank.
+// The new coefficients take effect at the start of the next call to
+// runControlAlgorithm(), at which point the controller states are adjusted so
+// that the control signal does not jump (bumpless transfer).
+//
+// Returns false without changing the controller if a previous retune has not
+// yet taken effect.
+//
+// This must not be called from the interrupt which runs the control algorithm.
+bool pidRetune(struct pidController *pid, const struct pidParameters *params);
+
+// Obtain the coefficients currently used by the control algorithm.
+static inline const struct pidCoefficients *pidActiveCoefficients(const struct pidController *pid) {
+    return &pid->banks[pid->activeBank];
+}
+
 float runControlAlgorithm(struct pidController *pid);
 
+// Incremental (velocity form) PID controller.
+//
+// Instead of calculating the control signal directly, the change in control
+// signal is calculated from the three most recent errors:
+//
+//      u[k] = u[k-1] + q0 * e[k] + q1 * e[k-1] + q2 * e[k-2]
+//
+// The stored previous control signal is the saturated value, so the integral
+// action stops as soon as the output saturates and the controller cannot wind
+// up.
+//
+// The integral uses the same approximation as runControlAlgorithm() (which
+// includes the current error), so q0 and q1 differ from those given by
+// convert_parameters.py by Ki * Ts. The derivative is unfiltered and setpoint
+// weights are not supported. With no derivative action and no saturation, both
+// controllers produce the same control signal.
+//
+// A controller must be set up with pidIncrementalInit() before use.
+struct pidIncrementalController {
+    float q0, q1, q2;
+    float outputMin, outputMax;
+
+    volatile float *setpoint;
+    volatile float *feedback;
+    volatile float *controlSignal;
+
+    float prevError1, prevError2;
+    float prevControl;
+};
+
+// Set up an incremental controller from a set of parameters and the memory
+// locations of its inputs and output. The filter coefficient and setpoint
+// weights are ignored. All controller states are reset.
+void pidIncrementalInit(struct pidIncrementalController *pid,
+                        const struct pidParameters *params,
+                        volatile float *setpoint, volatile float *feedback,
+                        volatile float *controlSignal);
+
+float runIncrementalControlAlgorithm(struct pidIncrementalController *pid);
+
+// Fixed point PID controller for processors without an FPU.
+//
+// The algorithm mirrors the FPGA implementation (Controller.v) term for term
+// so that, given the same Q16 inputs, both produce bit-identical control
+// signals while every intermediate value is within the range of fix_t. Beyond
+// that the operations saturate (and set a flag in fixStatus), whereas
+// Controller.v wraps, so the outputs differ. All coefficients should be created with the FIX_POINT() macro and
+// the FIX_* definitions in ControllerParameters.h provide the values matching
+// the floating point controller.
+//
+// As in the FPGA implementation, the integrator is clamped to the output
+// limits after every sample.
+struct fixPidController {
+    const fix_t propCoeff1, propCoeff2;             // Kp * b, Kp
+    const fix_t intCoeff;                           // Ki * Ts
+    const fix_t derCoeff1, derCoeff2, derCoeff3;    // Kd * N * c / (1 + N * Ts),
+                                                    // Kd * N / (1 + N * Ts),
+                                                    // 1 / (1 + N * Ts)
+    const fix_t outputMin, outputMax;
+
+    volatile fix_t *const setpoint;
+    volatile fix_t *const feedback;
+    volatile fix_t *const controlSignal;
+
+    fix_t integrator;
+    fix_t differentiator;
+    fix_t prevError;
+};
+
+fix_t runFixControlAlgorithm(struct fixPidController *pid);
+
 #endif
@@ -0,0 +1,87 @@
+/*
+ * PIDProfile.c
+ *
+ * Dynamic range profiling of the intermediate values of the PID controller.
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team
+ */
+
+#include "PIDProfile.h"
+
+// Largest number of integer bits reported, for infinite values
+#define MAX_INT_BITS    128
+
+struct pidProfileRange pidProfileRanges[PID_PROFILE_NUM_VARIABLES];
+
+const char *const pidProfileNames[PID_PROFILE_NUM_VARIABLES] = {
+    [PID_PROFILE_SETPOINT] = "setpoint",
+    [PID_PROFILE_FEEDBACK] = "feedback",
+    [PID_PROFILE_P_TERM] = "pTerm",
+    [PID_PROFILE_I_TERM] = "iTerm",
+    [PID_PROFILE_SWC_ERROR] = "swcError",
+    [PID_PROFILE_D_TERM] = "dTerm",
+    [PID_PROFILE_CONTROL] = "controlSignal"
+};
+
+void pidProfileClear(void) {
+    for (int v = 0; v < PID_PROFILE_NUM_VARIABLES; v++) {
+        struct pidProfileRange *range = &pidProfileRanges[v];
+
+        range->min = 0.0f;
+        range->max = 0.0f;
+        range->count = 0;
+
+        for (int i = 0; i < PID_PROFILE_BINS; i++)
+            range->histogram[i] = 0;
+    }
+}
+
+void pidProfileRecord(enum pidProfileVariable variable, float value) {
+    struct pidProfileRange *range = &pidProfileRanges[variable];
+
+    if (range->count == 0 || value < range->min)
+        range->min = value;
+    if (range->count == 0 || value > range->max)
+        range->max = value;
+    range->count++;
+
+    // The magnitude lies in [2^exponent, 2^(exponent + 1)), which is read
+    // from the bits of the float rather than with frexpf() so that this does
+    // not depend on the maths library
+    union {
+        float f;
+        uint32_t u;
+    } bits = { value };
+    int exponent = (int)((bits.u >> 23) & 0xFF) - 127;
+
+    int bin = exponent + 1 - PID_PROFILE_MIN_EXP;
+    if (bin < 0)
+        bin = 0;
+    else if (bin >= PID_PROFILE_BINS)
+        bin = PID_PROFILE_BINS - 1;
+
+    range->histogram[bin]++;
+}
+
+int pidProfileIntBits(float magnitude) {
+    // Smallest n for which magnitude < 2^n
+    int bits = PID_PROFILE_MIN_EXP;
+    float limit = 1.0f / (float)(1L << -PID_PROFILE_MIN_EXP);
+
+    while (magnitude >= limit && bits < MAX_INT_BITS) {
+        limit *= 2.0f;
+        bits++;
+    }
+
+    return bits;
+}
+
+int pidProfileFracBits(enum pidProfileVariable variable, int guardBits) {
+    const struct pidProfileRange *range = &pidProfileRanges[variable];
+    float magnitude = -range->min > range->max ? -range->min : range->max;
+
+    return 31 - guardBits - pidProfileIntBits(magnitude);
+}
@@ -0,0 +1,89 @@
+/*
+ * PIDProfile.h
+ *
+ * Dynamic range profiling of the intermediate values of the PID controller,
+ * for choosing the fixed point format of each value.
+ *
+ * When PIDController.c is compiled with PID_PROFILE defined,
+ * runControlAlgorithm() passes each of its intermediate values to
+ * pidProfileRecord(), which keeps their minimum, maximum and a histogram of
+ * their magnitudes in powers of two. After a long simulated run,
+ * pidProfileFracBits() gives the number of fraction bits each value can have
+ * in a 32-bit word without overflowing. Without PID_PROFILE the hooks compile
+ * to nothing, so the controller on the microcontroller is unchanged.
+ *
+ * Usage:
+ *      // Build PIDController.c with -DPID_PROFILE
+ *      pidProfileClear();
+ *      for (...)
+ *          runControlAlgorithm(pid);
+ *      int fracBits = pidProfileFracBits(PID_PROFILE_I_TERM, 1);
+ *
+ * bin/host/pidProfile runs the velocity controller with the simulated motor
+ * and prints the recommended formats (see `make pidProfileReport`).
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team
+ */
+
+#ifndef PID_PROFILE_H
+#define PID_PROFILE_H
+
+#include <stdint.h>
+
+// The histogram has one bin for each power of two from 2^PID_PROFILE_MIN_EXP
+// to 2^PID_PROFILE_MAX_EXP. Bin i holds magnitudes below
+// 2^(PID_PROFILE_MIN_EXP + i), and at least the limit of the bin before it.
+// Smaller magnitudes (including zero) are counted in bin 0 and larger ones in
+// the last bin.
+#define PID_PROFILE_MIN_EXP     -24
+#define PID_PROFILE_MAX_EXP     24
+#define PID_PROFILE_BINS        (PID_PROFILE_MAX_EXP - PID_PROFILE_MIN_EXP + 1)
+
+enum pidProfileVariable {
+    PID_PROFILE_SETPOINT,
+    PID_PROFILE_FEEDBACK,
+    PID_PROFILE_P_TERM,
+    PID_PROFILE_I_TERM,
+    PID_PROFILE_SWC_ERROR,
+    PID_PROFILE_D_TERM,
+    PID_PROFILE_CONTROL,            // Before saturation
+    PID_PROFILE_NUM_VARIABLES
+};
+
+struct pidProfileRange {
+    float min, max;
+    uint32_t count;
+    uint32_t histogram[PID_PROFILE_BINS];
+};
+
+// Ranges recorded since the last call to pidProfileClear()
+extern struct pidProfileRange pidProfileRanges[PID_PROFILE_NUM_VARIABLES];
+
+// Names of the variables, as used in the controller
+extern const char *const pidProfileNames[PID_PROFILE_NUM_VARIABLES];
+
+#ifdef PID_PROFILE
+#define PID_PROFILE_RECORD(variable, value) pidProfileRecord((variable), (value))
+#else
+#define PID_PROFILE_RECORD(variable, value) ((void)0)
+#endif
+
+// Forget all recorded values
+void pidProfileClear(void);
+
+// Record one value of a variable
+void pidProfileRecord(enum pidProfileVariable variable, float value);
+
+// Number of integer bits (excluding the sign) needed to hold every value from
+// -magnitude to magnitude
+int pidProfileIntBits(float magnitude);
+
+// Number of fraction bits a variable can have in a signed 32-bit word, with
+// guardBits integer bits left spare for values beyond those recorded. May be
+// more than 31 for a variable which is always small.
+int pidProfileFracBits(enum pidProfileVariable variable, int guardBits);
+
+#endif
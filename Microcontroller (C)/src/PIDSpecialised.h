@@ -0,0 +1,112 @@
+/*
+ * PIDSpecialised.h
+ *
+ * Generation of PID controller step functions which are specialised for one
+ * fixed set of parameters at compile time.
+ *
+ * The generic runControlAlgorithm() reads every coefficient from memory and
+ * always evaluates every term. When the parameters are known at compile time,
+ * PID_DEFINE_SPECIALISED() generates a static inline step function in which:
+ *
+ *      - Every coefficient is a constant folded into the instructions
+ *      - Terms with a zero gain (and their states) are removed
+ *      - Multiplications by a unit setpoint weight are removed
+ *      - Derived coefficients (including divisions) are computed by the
+ *        compiler rather than at run time
+ *      - Inputs are passed by value so there are no pointer indirections or
+ *        NULL checks
+ *
+ * The generated function is equivalent to runControlAlgorithm() for the same
+ * parameters within rounding. Its derived coefficients are folded by the
+ * compiler, so the output can differ in the last bits. It has no feedforward
+ * term and always uses PID_ANTI_WINDUP_NONE.
+ *
+ * Usage:
+ *      PID_DEFINE_SPECIALISED(wheelStep, KP, KI, KD, SW_B, SW_C, N, FS,
+ *                             OUTPUT_MIN, OUTPUT_MAX)
+ *
+ *      struct pidState state = { 0 };
+ *      controlReg = wheelStep(&state, setpointReg, feedbackReg);
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team
+ */
+
+#ifndef PID_SPECIALISED_H
+#define PID_SPECIALISED_H
+
+#include "ControllerParameters.h"
+
+// Controller states for a specialised controller. The coefficients are part of
+// the generated function so only the states need to be stored.
+struct pidState {
+    float integrator;
+    float differentiator;
+    float prevError;
+};
+
+// Generic specialised step. This must always be inlined so that the parameters
+// become compile-time constants and the conditions on them are resolved by the
+// compiler. It should not be called directly; use PID_DEFINE_SPECIALISED().
+static inline __attribute__((always_inline))
+float pidSpecialisedStep(struct pidState *state, float setpoint, float feedback,
+                         const float kp, const float ki, const float kd,
+                         const float setWeightB, const float setWeightC,
+                         const float filterCoeff, const float sampleFreq,
+                         const float outputMin, const float outputMax) {
+    float controlSignal = 0.0f;
+
+    // A weight of exactly 1 is folded away by the compiler
+    if (kp != 0.0f)
+        controlSignal += kp * (setWeightB * setpoint - feedback);
+
+    if (ki != 0.0f) {
+        float iTerm = (ki / sampleFreq) * (setpoint - feedback) + state->integrator;
+        state->integrator = iTerm;
+        controlSignal += iTerm;
+    }
+
+    if (kd != 0.0f) {
+        float swcError = setWeightC * setpoint - feedback;
+        float dTerm = (1.0f / (1.0f + filterCoeff / sampleFreq))
+                    * (state->differentiator + kd * filterCoeff * (swcError - state->prevError));
+        state->differentiator = dTerm;
+        state->prevError = swcError;
+        controlSignal += dTerm;
+    }
+
+    // Saturate control signal if required
+    if (controlSignal < outputMin)
+        controlSignal = outputMin;
+    else if (controlSignal > outputMax)
+        controlSignal = outputMax;
+
+    return controlSignal;
+}
+
+// Define a static inline step function called `name` for the given parameters,
+// which must all be compile-time constants. The generated function has the
+// signature
+//
+//      float name(struct pidState *state, float setpoint, float feedback);
+//
+// and returns the saturated control signal.
+#define PID_DEFINE_SPECIALISED(name, kp, ki, kd, setWeightB, setWeightC,        \
+                               filterCoeff, sampleFreq, outputMin, outputMax)   \
+    static inline float name(struct pidState *state, float setpoint,            \
+                             float feedback) {                                  \
+        return pidSpecialisedStep(state, setpoint, feedback,                    \
+                                  (kp), (ki), (kd), (setWeightB), (setWeightC), \
+                                  (filterCoeff), (sampleFreq),                  \
+                                  (outputMin), (outputMax));                    \
+    }
+
+// Define a specialised step function using the parameters from
+// ControllerParameters.h
+#define PID_DEFINE_SPECIALISED_DEFAULT(name)                                    \
+    PID_DEFINE_SPECIALISED(name, KP, KI, KD, SW_B, SW_C, N, FS,                 \
+                           OUTPUT_MIN, OUTPUT_MAX)
+
+#endif
@@ -0,0 +1,52 @@
+/*
+ * PositionLoop.c
+ *
+ * Outer position loop of the cascaded controller.
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team
+ */
+
+#include <stddef.h>
+
+#include "PositionLoop.h"
+
+// Angles on one side of the setpoint, in degrees
+#define HALF_REV 180.0f
+#define FULL_REV 360.0f
+
+void positionLoopInit(struct positionLoop *loop, struct pidController *pid,
+                      uint32_t divider) {
+    if (loop == NULL)
+        return;
+
+    loop->pid = pid;
+    loop->divider = divider;
+    loop->count = 0;
+}
+
+bool runPositionLoop(struct positionLoop *loop, degrees position) {
+    if (loop == NULL || ++loop->count < loop->divider)
+        return false;
+
+    loop->count = 0;
+
+    // The controller calculates the error as setpoint - feedback, so the
+    // feedback is offset to give the wrapped error
+    struct pidController *pid = loop->pid;
+    *(pid->feedback) = *(pid->setpoint) - wrapAngle(*(pid->setpoint) - position);
+    runControlAlgorithm(pid);
+
+    return true;
+}
+
+degrees wrapAngle(degrees angle) {
+    while (angle >= HALF_REV)
+        angle -= FULL_REV;
+    while (angle < -HALF_REV)
+        angle += FULL_REV;
+
+    return angle;
+}
@@ -0,0 +1,60 @@
+/*
+ * PositionLoop.h
+ *
+ * Outer position loop of the cascaded controller, which sets the velocity
+ * setpoint so that the wheel is driven to an angle.
+ *
+ * The position controller runs once every `divider` velocity samples, so it
+ * needs no timer of its own. The measured angle lies in [0, 360), so the error
+ * is wrapped to [-180, 180) and the wheel takes the shortest path to the
+ * setpoint, including across 0 degrees.
+ *
+ * Usage:
+ *      struct positionLoop loop;
+ *      pidInit(&positionPid, &params, &positionSetpointReg,
+ *              &positionFeedbackReg, &commandReg);
+ *      positionLoopInit(&loop, &positionPid, POSITION_LOOP_DIVIDER);
+ *
+ *      // In the control interrupt, before the velocity controller
+ *      runPositionLoop(&loop, qeiGetPosition(QEI1));
+ *      runControlAlgorithm(pid);
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team
+ */
+
+#ifndef POSITION_LOOP_H
+#define POSITION_LOOP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "PIDController.h"
+#include "units.h"
+
+// The position controller reads its setpoint (in degrees) and writes its
+// output (the velocity setpoint) through the memory locations given to
+// pidInit(). Its feedback location is written by runPositionLoop().
+//
+// A position loop must be set up with positionLoopInit() before use.
+struct positionLoop {
+    struct pidController *pid;
+
+    uint32_t divider;
+    uint32_t count;             // Velocity samples since the last update
+};
+
+// Set up a position loop which runs pid once every `divider` samples
+void positionLoopInit(struct positionLoop *loop, struct pidController *pid,
+                      uint32_t divider);
+
+// Count one velocity sample, and run the position controller if it is due
+// with the measured angle `position` in [0, 360). Returns true if it ran.
+bool runPositionLoop(struct positionLoop *loop, degrees position);
+
+// Wrap an angle in degrees to the range [-180, 180)
+degrees wrapAngle(degrees angle);
+
+#endif
@@ -309,6 +309,31 @@ struct AngularVel qeiGetVelocity(enum QEIModule qei) {
     return velocity;
 }   
 
+// Obtain the raw number of edges counted in the most recent velocity sample,
+// negative for anticlockwise rotation.
+int32_t qeiGetVelocityTicks(enum QEIModule qei) {
+    if (!QEI_DATA(qei).measureVelocity) {
+        return 0;
+    }
+
+    int32_t ticks = (int32_t)QEIVelocityGet(QEI_BASE(qei));
+
+    return QEIDirectionGet(QEI_BASE(qei)) < 0 ? -ticks : ticks;
+}
+
+// Convert a number of edges counted over one velocity sample to a signed speed
+// in rpm, using the same scaling as qeiGetVelocity.
+rpm qeiTicksToSpeed(enum QEIModule qei, float ticks) {
+    struct QEIModuleData data = QEI_DATA(qei);
+
+    if (!data.measureVelocity) {
+        return 0.0f;
+    }
+
+    return ticks * (float)secondsPerMin * khzToHz(data.sampleFrequency)
+           / (2.0f * (float)data.pulsesPerRev);
+}
+
 // Enable or disable a QEI module. This must be called after configuring the
 // module for an encoder (required) and for velocity capture (optional).
 //
@@ -188,6 +188,19 @@ degrees qeiGetPosition(enum QEIModule qei);
 // but that which was measured in the last sample.
 struct AngularVel qeiGetVelocity(enum QEIModule qei);
 
+// Obtain the raw number of edges counted in the most recent velocity sample,
+// negative for anticlockwise rotation. Unlike qeiGetVelocity(), this does no
+// floating point calculations, so it is suited to sampling the velocity at a
+// multiple of the control rate and decimating the counts (see CICDecimator.h).
+//
+// Returns 0 if velocity capture is not configured.
+int32_t qeiGetVelocityTicks(enum QEIModule qei);
+
+// Convert a number of edges counted over one velocity sample to a signed speed
+// in rpm. The count does not need to be a whole number, so a mean count from a
+// decimator can be converted.
+rpm qeiTicksToSpeed(enum QEIModule qei, float ticks);
+
 // Enable or disable a QEI module. This must be called after configuring the
 // module for an encoder (required) and for velocity capture (optional).
 //
@@ -0,0 +1,163 @@
+/*
+ * RLSEstimator.c
+ *
+ * Online identification of the first-order motor model by recursive least
+ * squares, and adaptation of the PID gains to the identified model.
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team
+ */
+
+#include <stddef.h>
+
+#include "RLSEstimator.h"
+
+void rlsInit(struct rlsEstimator *rls, float dcGain, float timeConstant,
+             float sampleFreq, float forgetting) {
+    if (rls == NULL)
+        return;
+
+    float sampleTime = 1.0f / sampleFreq;
+
+    // Same discretisation as MotorParameters.h
+    rls->theta[0] = timeConstant / (sampleTime + timeConstant);
+    rls->theta[1] = sampleTime * dcGain / (sampleTime + timeConstant);
+
+    rls->cov[0][0] = RLS_INITIAL_COV;
+    rls->cov[0][1] = 0.0f;
+    rls->cov[1][0] = 0.0f;
+    rls->cov[1][1] = RLS_INITIAL_COV;
+
+    rls->forgetting = forgetting;
+    rls->invForgetting = 1.0f / forgetting;
+    rls->prevFeedback = 0.0f;
+
+    rls->sequence = 0;
+    rls->samples = 0;
+}
+
+void rlsUpdate(struct rlsEstimator *rls, float control, float feedback) {
+    if (rls == NULL)
+        return;
+
+    // Regressor
+    float phi0 = rls->prevFeedback;
+    float phi1 = control;
+
+    // P * phi
+    float p0 = rls->cov[0][0] * phi0 + rls->cov[0][1] * phi1;
+    float p1 = rls->cov[1][0] * phi0 + rls->cov[1][1] * phi1;
+
+    // Gain vector
+    float denominator = rls->forgetting + phi0 * p0 + phi1 * p1;
+    float scale = 1.0f / denominator;
+    float gain0 = p0 * scale;
+    float gain1 = p1 * scale;
+
+    float predictionError = feedback - (rls->theta[0] * phi0 + rls->theta[1] * phi1);
+
+    // Covariance update P = (P - K phi' P) / lambda, keeping P symmetric.
+    // phi' P is the transpose of P phi since P is symmetric.
+    float cov00 = rls->cov[0][0] - gain0 * p0;
+    float cov01 = rls->cov[0][1] - gain0 * p1;
+    float cov11 = rls->cov[1][1] - gain1 * p1;
+
+    if (cov00 + cov11 < RLS_MAX_TRACE) {
+        cov00 *= rls->invForgetting;
+        cov01 *= rls->invForgetting;
+        cov11 *= rls->invForgetting;
+    }
+
+    // Update estimates
+    // -------------------------------------------------------------------------
+    rls->sequence++;
+    COMPILER_BARRIER();
+
+    rls->theta[0] += gain0 * predictionError;
+    rls->theta[1] += gain1 * predictionError;
+
+    COMPILER_BARRIER();
+    rls->sequence++;
+
+    rls->cov[0][0] = cov00;
+    rls->cov[0][1] = cov01;
+    rls->cov[1][0] = cov01;
+    rls->cov[1][1] = cov11;
+
+    rls->prevFeedback = feedback;
+    rls->samples++;
+}
+
+bool rlsGetModel(const struct rlsEstimator *rls, float sampleFreq,
+                 float *dcGain, float *timeConstant) {
+    if (rls == NULL || dcGain == NULL || timeConstant == NULL)
+        return false;
+
+    // Retry if the estimates were updated while being read
+    float a, b;
+    uint32_t sequence;
+    do {
+        sequence = rls->sequence;
+        COMPILER_BARRIER();
+        a = rls->theta[0];
+        b = rls->theta[1];
+        COMPILER_BARRIER();
+    } while ((sequence & 1) || sequence != rls->sequence);
+
+    // A stable first-order motor with a positive gain
+    if (a <= 0.0f || a >= 1.0f || b <= 0.0f)
+        return false;
+
+    *dcGain = b / (1.0f - a);
+    *timeConstant = a / ((1.0f - a) * sampleFreq);
+
+    return true;
+}
+
+bool rlsTunePid(const struct pidParameters *nominal,
+                float nominalGain, float nominalTimeConstant,
+                float dcGain, float timeConstant,
+                struct pidParameters *tuned) {
+    if (nominal == NULL || tuned == NULL)
+        return false;
+
+    float sampleTime = 1.0f / nominal->sampleFreq;
+
+    // Discrete models of both motors
+    float nominalA = nominalTimeConstant / (sampleTime + nominalTimeConstant);
+    float nominalB = sampleTime * nominalGain / (sampleTime + nominalTimeConstant);
+    float a = timeConstant / (sampleTime + timeConstant);
+    float b = sampleTime * dcGain / (sampleTime + timeConstant);
+
+    // The PI controller is Kp + Ki Ts z / (z - 1) (runControlAlgorithm() adds
+    // the current error to the integrator before using it), so with the motor
+    // b / (z - a) the closed loop characteristic polynomial is
+    //
+    //      z^2 + (b (Kp + Ki Ts) - 1 - a) z + (a - b Kp)
+    //
+    // The coefficients for the nominal gains and motor are matched by
+    float c1 = nominalB * (nominal->kp + nominal->ki * sampleTime) - 1.0f - nominalA;
+    float c0 = nominalA - nominalB * nominal->kp;
+
+    float kp = (a - c0) / b;
+
+    // A motor much faster than the closed loop would need a negative
+    // proportional gain. Without proportional action only c1 is matched.
+    if (kp < 0.0f)
+        kp = 0.0f;
+
+    float ki = ((c1 + 1.0f + a) / b - kp) / sampleTime;
+
+    // An even faster motor would need a negative integral gain as well, which
+    // would make the loop unstable
+    if (ki < 0.0f)
+        return false;
+
+    *tuned = *nominal;
+    tuned->kp = kp;
+    tuned->ki = ki;
+
+    return true;
+}
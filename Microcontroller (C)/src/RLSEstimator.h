@@ -0,0 +1,92 @@
+/*
+ * RLSEstimator.h
+ *
+ * Online identification of the first-order motor model by recursive least
+ * squares (RLS), and adaptation of the PID gains to the identified model.
+ *
+ * The motor is modelled in the same way as the simulation (test/Motor.c):
+ *
+ *      w[k] = a * w[k-1] + b * u[k-1]
+ *
+ * where w is the speed and u the control signal. Each sample, rlsUpdate()
+ * updates the estimates of a and b and their 2x2 covariance, which takes a fixed
+ * number of operations (including one division). Old samples are gradually
+ * forgotten so that the estimates follow changes in battery voltage and load.
+ * While the loop is not excited (e.g. a constant setpoint) forgetting would make
+ * the covariance grow without bound, so it is only applied while the trace of
+ * the covariance is below a limit.
+ *
+ * The DC gain and time constant are recovered from
+ *
+ *      K = b / (1 - a),  tau = Ts * a / (1 - a)
+ *
+ * and rlsTunePid() calculates PI gains which place the closed loop poles of the
+ * identified motor where the nominal gains place those of the nominal motor.
+ *
+ * rlsUpdate() is meant to be called in the control interrupt, while
+ * rlsGetModel() may be called from the main program.
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team
+ */
+
+#ifndef RLS_ESTIMATOR_H
+#define RLS_ESTIMATOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "PIDController.h"
+
+// Initial covariance of the estimates, which sets how quickly the initial
+// estimates are corrected
+#define RLS_INITIAL_COV     100.0f
+
+// Largest trace of the covariance for which forgetting is applied
+#define RLS_MAX_TRACE       1000.0f
+
+// An estimator must be set up with rlsInit() before use.
+struct rlsEstimator {
+    float theta[2];             // Estimates of a and b
+    float cov[2][2];
+
+    float forgetting;
+    float invForgetting;
+
+    float prevFeedback;         // Speed at the previous sample
+
+    // Incremented before and after each update so that the estimates can be
+    // read consistently outside the interrupt
+    volatile uint32_t sequence;
+    volatile uint32_t samples;
+};
+
+// Set up an estimator starting from the model with the given DC gain and time
+// constant (usually the values in MotorParameters.h).
+void rlsInit(struct rlsEstimator *rls, float dcGain, float timeConstant,
+             float sampleFreq, float forgetting);
+
+// Update the estimates with the control signal applied over the last sample
+// and the speed measured at the end of it.
+void rlsUpdate(struct rlsEstimator *rls, float control, float feedback);
+
+// Obtain the current DC gain and time constant estimates. Returns false if the
+// estimates do not describe a stable first-order motor, in which case the
+// outputs are not changed.
+bool rlsGetModel(const struct rlsEstimator *rls, float sampleFreq,
+                 float *dcGain, float *timeConstant);
+
+// Calculate PI gains for the identified model which give the same closed loop
+// poles as the nominal gains with the nominal model. The derivative gain and
+// all other parameters are copied from the nominal parameters. If the model is
+// too fast for the poles to be placed with a non-negative proportional gain,
+// the proportional gain is zero. Returns false if the integral gain would also
+// be negative, in which case tuned is not changed.
+bool rlsTunePid(const struct pidParameters *nominal,
+                float nominalGain, float nominalTimeConstant,
+                float dcGain, float timeConstant,
+                struct pidParameters *tuned);
+
+#endif
@@ -0,0 +1,65 @@
+/*
+ * SmithPredictor.c
+ *
+ * Smith predictor for the delay between the controller output and the measured
+ * speed.
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team
+ */
+
+#include <stddef.h>
+
+#include "SmithPredictor.h"
+
+void smithInit(struct smithPredictor *smith, float dcGain, float timeConstant,
+               float sampleFreq, uint32_t delay, volatile float *measured,
+               volatile float *predicted, volatile float *controlSignal) {
+    if (smith == NULL)
+        return;
+
+    float ts = 1.0f / sampleFreq;
+    smith->coeffW = timeConstant / (ts + timeConstant);
+    smith->coeffV = ts * dcGain / (ts + timeConstant);
+
+    if (delay > SMITH_MAX_DELAY)
+        delay = SMITH_MAX_DELAY;
+    smith->delay = delay;
+
+    smith->measured = measured;
+    smith->predicted = predicted;
+    smith->controlSignal = controlSignal;
+
+    smith->model = *measured;
+    for (uint32_t i = 0; i < SMITH_MAX_DELAY; i++)
+        smith->history[i] = smith->model;
+    smith->index = 0;
+
+    *(smith->predicted) = *(smith->measured);
+}
+
+void smithPredict(struct smithPredictor *smith) {
+    if (smith == NULL)
+        return;
+
+    // history[index] is the model output from `delay` samples ago, which is
+    // the model's estimate of the measurement in this sample
+    float delayed = smith->delay > 0 ? smith->history[smith->index] : smith->model;
+
+    *(smith->predicted) = *(smith->measured) + smith->model - delayed;
+}
+
+void smithUpdate(struct smithPredictor *smith) {
+    if (smith == NULL)
+        return;
+
+    if (smith->delay > 0) {
+        smith->history[smith->index] = smith->model;
+        if (++smith->index >= smith->delay)
+            smith->index = 0;
+    }
+
+    smith->model = smith->coeffW * smith->model + smith->coeffV * *(smith->controlSignal);
+}
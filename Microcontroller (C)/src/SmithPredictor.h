@@ -0,0 +1,82 @@
+/*
+ * SmithPredictor.h
+ *
+ * Smith predictor for the transport delay between the controller output and
+ * the measured speed (the PWM period, the ESC and the QEI sample).
+ *
+ * The first-order motor model is run alongside the plant without the delay:
+ *
+ *      m[k+1] = a m[k] + b u[k],   a = tau / (Ts + tau),  b = Ts K / (Ts + tau)
+ *
+ * and the controller is given the feedback
+ *
+ *      y[k] + m[k] - m[k - d]
+ *
+ * where d is the delay in samples. When the model matches the plant,
+ * m[k - d] = y[k], so the controller sees the undelayed model output and
+ * can be tuned as if there were no delay. Any difference between the plant
+ * and the delayed model, such as a load disturbance or model error, still
+ * passes through to the controller.
+ *
+ * smithPredict() writes the predicted feedback before the controller runs and
+ * smithUpdate() advances the model with the control signal applied afterwards,
+ * so the predictor can be used with any of the velocity controllers which
+ * read their feedback from memory.
+ *
+ * Usage:
+ *      struct smithPredictor smith;
+ *      smithInit(&smith, DC_GAIN, TIME_CONSTANT, FS, SMITH_DELAY,
+ *                &feedbackReg, &predictedFeedbackReg, &controlReg);
+ *      pidInit(&pid, &params, &setpointReg, &predictedFeedbackReg, &controlReg);
+ *
+ *      smithPredict(&smith);
+ *      runControlAlgorithm(&pid);
+ *      smithUpdate(&smith);
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team
+ */
+
+#ifndef SMITH_PREDICTOR_H
+#define SMITH_PREDICTOR_H
+
+#include <stdint.h>
+
+// Longest delay which can be compensated, in samples
+#define SMITH_MAX_DELAY 8
+
+// A predictor must be set up with smithInit() before use.
+struct smithPredictor {
+    // Discrete motor model
+    float coeffW;
+    float coeffV;
+
+    uint32_t delay;
+
+    volatile float *measured;
+    volatile float *predicted;
+    volatile float *controlSignal;
+
+    float model;                        // Model output without the delay
+    float history[SMITH_MAX_DELAY];     // Last `delay` model outputs
+    uint32_t index;                     // Oldest model output in history
+};
+
+// Set up a predictor for the first-order model with the given static gain and
+// time constant, sampled at sampleFreq, with the output delayed by `delay`
+// samples (at most SMITH_MAX_DELAY). The model starts at the current measured
+// value as if the plant were at rest there.
+void smithInit(struct smithPredictor *smith, float dcGain, float timeConstant,
+               float sampleFreq, uint32_t delay, volatile float *measured,
+               volatile float *predicted, volatile float *controlSignal);
+
+// Write the predicted feedback for this sample. Call before the controller.
+void smithPredict(struct smithPredictor *smith);
+
+// Advance the model with the control signal applied in this sample. Call
+// after the controller.
+void smithUpdate(struct smithPredictor *smith);
+
+#endif
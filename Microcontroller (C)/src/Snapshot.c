@@ -0,0 +1,117 @@
+/*
+ * Snapshot.c
+ *
+ * Snapshots of the PID controller states for a warm restart.
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team
+ */
+
+#include "Snapshot.h"
+
+// Bytes of a snapshot covered by its CRC
+#define SNAPSHOT_CRC_LENGTH offsetof(struct snapshot, crc)
+
+// CRC-32 of each value of a nibble, for the reflected polynomial 0xEDB88320.
+// Processing four bits at a time needs a much smaller table than a byte at a
+// time, which matters more than speed for a few dozen bytes.
+static const uint32_t crcTable[16] = {
+    0x00000000u, 0x1DB71064u, 0x3B6E20C8u, 0x26D930ACu,
+    0x76DC4190u, 0x6B6B51F4u, 0x4DB26158u, 0x5005713Cu,
+    0xEDB88320u, 0xF00F9344u, 0xD6D6A3E8u, 0xCB61B38Cu,
+    0x9B64C2B0u, 0x86D3D2D4u, 0xA00AE278u, 0xBDBDF21Cu
+};
+
+// Check the magic number, size and CRC of a slot
+static bool snapshotValid(const struct snapshot *slot, uint32_t numControllers);
+
+void snapshotSave(struct snapshotStore *store, struct pidController *const *controllers,
+                  uint32_t numControllers) {
+    if (store == NULL || controllers == NULL || numControllers > SNAPSHOT_MAX_CONTROLLERS)
+        return;
+
+    // Slots are written alternately, so this overwrites the older slot and the
+    // latest one survives a reset during the save
+    uint32_t sequence = store->nextSequence++;
+    struct snapshot *slot = &store->slots[sequence & 1];
+
+    slot->magic = SNAPSHOT_MAGIC;
+    slot->sequence = sequence;
+    slot->numControllers = numControllers;
+
+    for (uint32_t i = 0; i < numControllers; i++) {
+        slot->states[i].integrator = controllers[i]->integrator;
+        slot->states[i].differentiator = controllers[i]->differentiator;
+        slot->states[i].prevError = controllers[i]->prevError;
+    }
+
+    // Clear unused states so that they do not carry garbage into the CRC
+    for (uint32_t i = numControllers; i < SNAPSHOT_MAX_CONTROLLERS; i++)
+        slot->states[i] = (struct pidState){ 0.0f, 0.0f, 0.0f };
+
+    slot->crc = snapshotCrc32(slot, SNAPSHOT_CRC_LENGTH);
+}
+
+bool snapshotRestore(struct snapshotStore *store, struct pidController *const *controllers,
+                     uint32_t numControllers) {
+    if (store == NULL || controllers == NULL || numControllers > SNAPSHOT_MAX_CONTROLLERS)
+        return false;
+
+    store->nextSequence = 0;
+
+    const struct snapshot *a = &store->slots[0];
+    const struct snapshot *b = &store->slots[1];
+
+    bool aValid = snapshotValid(a, numControllers);
+    bool bValid = snapshotValid(b, numControllers);
+
+    const struct snapshot *slot;
+    if (aValid && bValid)
+        slot = (int32_t)(b->sequence - a->sequence) > 0 ? b : a;
+    else if (aValid)
+        slot = a;
+    else if (bValid)
+        slot = b;
+    else
+        return false;
+
+    store->nextSequence = slot->sequence + 1;
+
+    for (uint32_t i = 0; i < numControllers; i++) {
+        controllers[i]->integrator = slot->states[i].integrator;
+        controllers[i]->differentiator = slot->states[i].differentiator;
+        controllers[i]->prevError = slot->states[i].prevError;
+    }
+
+    return true;
+}
+
+void snapshotClear(struct snapshotStore *store) {
+    if (store == NULL)
+        return;
+
+    store->slots[0].magic = 0;
+    store->slots[1].magic = 0;
+    store->nextSequence = 0;
+}
+
+uint32_t snapshotCrc32(const void *data, size_t length) {
+    const uint8_t *bytes = data;
+    uint32_t crc = 0xFFFFFFFFu;
+
+    for (size_t i = 0; i < length; i++) {
+        crc ^= bytes[i];
+        crc = (crc >> 4) ^ crcTable[crc & 0x0F];
+        crc = (crc >> 4) ^ crcTable[crc & 0x0F];
+    }
+
+    return ~crc;
+}
+
+static bool snapshotValid(const struct snapshot *slot, uint32_t numControllers) {
+    return slot->magic == SNAPSHOT_MAGIC
+           && slot->numControllers == numControllers
+           && slot->crc == snapshotCrc32(slot, SNAPSHOT_CRC_LENGTH);
+}
@@ -0,0 +1,99 @@
+/*
+ * Snapshot.h
+ *
+ * Snapshots of the PID controller states for a warm restart after a watchdog
+ * or brown-out reset.
+ *
+ * Without a snapshot the controllers restart with their integrators cleared,
+ * and the wheel lurches while the integrator winds back up. snapshotSave()
+ * copies the integrator, differentiator and previous error of each controller
+ * into a store which is not cleared at reset, and snapshotRestore() copies
+ * them back before the first control interrupt.
+ *
+ * The store is placed in the .noinit section (see linker.ld), which the
+ * startup code neither loads nor zeroes, with SNAPSHOT_NOINIT. Its contents
+ * are random after a power-on reset, so each snapshot carries a magic number,
+ * the number of controllers and a CRC-32. The store has two slots which are
+ * written alternately, each with a sequence number, so a reset in the middle
+ * of a save leaves the previous snapshot intact. The valid slot with the
+ * latest sequence number is restored.
+ *
+ * Usage:
+ *      static struct snapshotStore store SNAPSHOT_NOINIT;
+ *      struct pidController *controllers[] = { pid, positionPid };
+ *
+ *      // At startup, after pidInit() and before enabling the interrupt
+ *      snapshotRestore(&store, controllers, 2);
+ *
+ *      // At the end of each sample
+ *      snapshotSave(&store, controllers, 2);
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team
+ */
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "PIDController.h"
+
+// Place a variable in the section which is not initialised at reset
+#define SNAPSHOT_NOINIT __attribute__((section(".noinit")))
+
+// Largest number of controllers in one snapshot
+#define SNAPSHOT_MAX_CONTROLLERS    2
+
+// Marks a slot which has been written by snapshotSave()
+#define SNAPSHOT_MAGIC              0x534E4150u     // "SNAP"
+
+struct pidState {
+    float integrator;
+    float differentiator;
+    float prevError;
+};
+
+struct snapshot {
+    uint32_t magic;
+    uint32_t sequence;
+    uint32_t numControllers;
+    struct pidState states[SNAPSHOT_MAX_CONTROLLERS];
+
+    uint32_t crc;               // CRC-32 of all of the above
+};
+
+// Snapshot number i is written to slot i % 2
+struct snapshotStore {
+    struct snapshot slots[2];
+    uint32_t nextSequence;
+};
+
+// Save the states of numControllers controllers into the older slot of the
+// store. snapshotRestore() or snapshotClear() must have been called first.
+// This must be called from the interrupt which runs the controllers, or with
+// it disabled, so that the states are consistent.
+void snapshotSave(struct snapshotStore *store, struct pidController *const *controllers,
+                  uint32_t numControllers);
+
+// Restore the states of numControllers controllers from the latest valid slot
+// of the store, and continue its sequence numbers. The controllers must
+// already be set up with pidInit().
+//
+// Returns false, leaving the controllers unchanged, if neither slot holds a
+// valid snapshot of the same number of controllers, as after a power-on reset.
+bool snapshotRestore(struct snapshotStore *store, struct pidController *const *controllers,
+                     uint32_t numControllers);
+
+// Invalidate both slots, so that the next restore fails, and start the
+// sequence numbers again
+void snapshotClear(struct snapshotStore *store);
+
+// CRC-32 (IEEE 802.3, as used by zlib) of a block of memory
+uint32_t snapshotCrc32(const void *data, size_t length);
+
+#endif
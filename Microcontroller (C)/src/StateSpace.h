@@ -0,0 +1,178 @@
+/*
+ * StateSpace.h
+ *
+ * Generic discrete state-space controller engine:
+ *
+ *      x[k+1] = A x[k] + B u[k]
+ *      y[k]   = C x[k] + D u[k]
+ *
+ * where x has NX states, u has NU inputs and y has NY outputs. This allows any
+ * linear controller designed in MATLAB (lead-lag, observer-based, LQR, ...) to
+ * be deployed through the same kernel. A PID controller can also be written in
+ * this form (see StateSpacePID.h).
+ *
+ * The dimensions and matrices are fixed at compile time. STATE_SPACE_DEFINE()
+ * (floating point) or STATE_SPACE_DEFINE_FIX() (fixed point) generates a static
+ * inline step function for one controller. Every loop has a constant trip count
+ * and is fully unrolled, so the kernel is a straight sequence of
+ * multiply-accumulates. When the matrices are static const arrays their entries
+ * become constants in the instructions, and terms multiplied by a zero entry
+ * are removed.
+ *
+ * The fixed point kernel accumulates each row in double length and only rounds
+ * (by truncation) once per row. It does not check for overflow, so the
+ * matrices, inputs and states must stay within the range of fix_t.
+ *
+ * Matrices can be exported from MATLAB with exportStateSpace.m in the
+ * PIDVerification folder, which writes a header containing the dimensions and
+ * matrices of a discrete state-space model.
+ *
+ * Usage:
+ *      static const float leadA[2][2] = { ... };
+ *      ...
+ *      STATE_SPACE_DEFINE(leadStep, 2, 2, 1, leadA, leadB, leadC, leadD)
+ *
+ *      struct leadStepState state = { { 0 } };
+ *      float u[2] = { setpointReg, feedbackReg };
+ *      leadStep(&state, u, &controlReg);
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team
+ */
+
+#ifndef STATE_SPACE_H
+#define STATE_SPACE_H
+
+#include <stdint.h>
+
+#include "fix_t.h"
+
+// Ask the compiler to completely unroll the following loop. The trip counts are
+// compile-time constants once the step function has been inlined.
+#define STATE_SPACE_UNROLL _Pragma("GCC unroll 16")
+
+// Largest number of states of a controller. The new states are calculated into
+// an array of this size, so the stack used by a step is fixed and every loop is
+// short enough to be unrolled.
+#define STATE_SPACE_MAX_STATES 16
+
+// Generic floating point step. The matrices are stored row-major. This must
+// always be inlined so that the dimensions become compile-time constants; use
+// STATE_SPACE_DEFINE() instead of calling it directly.
+static inline __attribute__((always_inline))
+void stateSpaceStep(float *restrict x, const float *restrict u, float *restrict y,
+                    const uint32_t nx, const uint32_t nu, const uint32_t ny,
+                    const float *a, const float *b,
+                    const float *c, const float *d) {
+    // Outputs use the current state
+    STATE_SPACE_UNROLL
+    for (uint32_t i = 0; i < ny; i++) {
+        float acc = 0.0f;
+        STATE_SPACE_UNROLL
+        for (uint32_t j = 0; j < nx; j++)
+            if (c[i * nx + j] != 0)
+                acc += c[i * nx + j] * x[j];
+        STATE_SPACE_UNROLL
+        for (uint32_t j = 0; j < nu; j++)
+            if (d[i * nu + j] != 0)
+                acc += d[i * nu + j] * u[j];
+        y[i] = acc;
+    }
+
+    // Calculate every new state before overwriting any of the current states
+    float next[STATE_SPACE_MAX_STATES];
+
+    STATE_SPACE_UNROLL
+    for (uint32_t i = 0; i < nx; i++) {
+        float acc = 0.0f;
+        STATE_SPACE_UNROLL
+        for (uint32_t j = 0; j < nx; j++)
+            if (a[i * nx + j] != 0)
+                acc += a[i * nx + j] * x[j];
+        STATE_SPACE_UNROLL
+        for (uint32_t j = 0; j < nu; j++)
+            if (b[i * nu + j] != 0)
+                acc += b[i * nu + j] * u[j];
+        next[i] = acc;
+    }
+
+    STATE_SPACE_UNROLL
+    for (uint32_t i = 0; i < nx; i++)
+        x[i] = next[i];
+}
+
+// Generic fixed point step, as for stateSpaceStep(). Use
+// STATE_SPACE_DEFINE_FIX() instead of calling it directly.
+static inline __attribute__((always_inline))
+void stateSpaceStepFix(fix_t *restrict x, const fix_t *restrict u, fix_t *restrict y,
+                       const uint32_t nx, const uint32_t nu, const uint32_t ny,
+                       const fix_t *a, const fix_t *b,
+                       const fix_t *c, const fix_t *d) {
+    STATE_SPACE_UNROLL
+    for (uint32_t i = 0; i < ny; i++) {
+        dint_t acc = 0;
+        STATE_SPACE_UNROLL
+        for (uint32_t j = 0; j < nx; j++)
+            if (c[i * nx + j] != 0)
+                acc += (dint_t)c[i * nx + j] * x[j];
+        STATE_SPACE_UNROLL
+        for (uint32_t j = 0; j < nu; j++)
+            if (d[i * nu + j] != 0)
+                acc += (dint_t)d[i * nu + j] * u[j];
+        y[i] = (fix_t)(acc >> Q_POINT);
+    }
+
+    fix_t next[STATE_SPACE_MAX_STATES];
+
+    STATE_SPACE_UNROLL
+    for (uint32_t i = 0; i < nx; i++) {
+        dint_t acc = 0;
+        STATE_SPACE_UNROLL
+        for (uint32_t j = 0; j < nx; j++)
+            if (a[i * nx + j] != 0)
+                acc += (dint_t)a[i * nx + j] * x[j];
+        STATE_SPACE_UNROLL
+        for (uint32_t j = 0; j < nu; j++)
+            if (b[i * nu + j] != 0)
+                acc += (dint_t)b[i * nu + j] * u[j];
+        next[i] = (fix_t)(acc >> Q_POINT);
+    }
+
+    STATE_SPACE_UNROLL
+    for (uint32_t i = 0; i < nx; i++)
+        x[i] = next[i];
+}
+
+// Define a floating point controller called `name` with nx states, nu inputs
+// and ny outputs. nx must be at most STATE_SPACE_MAX_STATES. The matrices a[nx][nx], b[nx][nu], c[ny][nx] and d[ny][nu]
+// must be constant arrays. This defines a state structure and a step function
+//
+//      struct nameState { float x[nx]; };
+//      void name(struct nameState *state, const float *u, float *y);
+#define STATE_SPACE_DEFINE(name, nx, nu, ny, a, b, c, d)                        \
+    typedef char name##StatesValid[((nx) <= STATE_SPACE_MAX_STATES) ? 1 : -1];  \
+    struct name##State {                                                        \
+        float x[nx];                                                            \
+    };                                                                          \
+    static inline void name(struct name##State *state,                          \
+                            const float *restrict u, float *restrict y) {       \
+        stateSpaceStep(state->x, u, y, (nx), (nu), (ny),                        \
+                       &(a)[0][0], &(b)[0][0], &(c)[0][0], &(d)[0][0]);         \
+    }
+
+// Define a fixed point controller, as for STATE_SPACE_DEFINE() but with fix_t
+// matrices, inputs, states and outputs.
+#define STATE_SPACE_DEFINE_FIX(name, nx, nu, ny, a, b, c, d)                    \
+    typedef char name##StatesValid[((nx) <= STATE_SPACE_MAX_STATES) ? 1 : -1];  \
+    struct name##State {                                                        \
+        fix_t x[nx];                                                            \
+    };                                                                          \
+    static inline void name(struct name##State *state,                          \
+                            const fix_t *restrict u, fix_t *restrict y) {       \
+        stateSpaceStepFix(state->x, u, y, (nx), (nu), (ny),                     \
+                          &(a)[0][0], &(b)[0][0], &(c)[0][0], &(d)[0][0]);      \
+    }
+
+#endif
@@ -0,0 +1,87 @@
+/*
+ * StateSpacePID.h
+ *
+ * The PID controller from ControllerParameters.h written as a discrete
+ * state-space controller for the engine in StateSpace.h.
+ *
+ * The inputs are u = [r; y] (setpoint and feedback) and the states are the
+ * states of runControlAlgorithm():
+ *
+ *      x1 = integrator, x2 = differentiator, x3 = previous (weighted) error
+ *
+ * Expanding the equations of runControlAlgorithm() gives
+ *
+ *          [ 1   0    0   ]        [ Ki*Ts      -Ki*Ts ]
+ *      A = [ 0   d2  -d   ]    B = [ c*d        -d     ]
+ *          [ 0   0    0   ]        [ c          -1     ]
+ *
+ *      C = [ 1   d2  -d   ]    D = [ Kp*b + Ki*Ts + c*d    -Kp - Ki*Ts - d ]
+ *
+ * where d2 = DER_COEFF2 and d = DER_COEFF1 * DER_COEFF2. The output must be
+ * saturated by the caller, as the engine is purely linear.
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team
+ */
+
+#ifndef STATE_SPACE_PID_H
+#define STATE_SPACE_PID_H
+
+#include "ControllerParameters.h"
+
+#define SS_PID_NX   3
+#define SS_PID_NU   2
+#define SS_PID_NY   1
+
+// Combined derivative coefficient
+#define SS_PID_DER  ((DER_COEFF1) * (DER_COEFF2))
+
+#define SS_PID_A {                                                  \
+            { 1.0f, 0.0f,           0.0f         },                 \
+            { 0.0f, (DER_COEFF2),   -SS_PID_DER  },                 \
+            { 0.0f, 0.0f,           0.0f         }                  \
+        }
+
+#define SS_PID_B {                                                  \
+            { (INT_COEFF),          -(INT_COEFF) },                 \
+            { SW_C * SS_PID_DER,    -SS_PID_DER  },                 \
+            { SW_C,                 -1.0f        }                  \
+        }
+
+#define SS_PID_C {                                                  \
+            { 1.0f, (DER_COEFF2),   -SS_PID_DER  }                  \
+        }
+
+#define SS_PID_D {                                                  \
+            { KP * SW_B + (INT_COEFF) + SW_C * SS_PID_DER,          \
+              -KP - (INT_COEFF) - SS_PID_DER }                      \
+        }
+
+// Fixed point versions of the matrices
+#define SS_PID_FIX_A {                                              \
+            { FIX_POINT(1.0), 0, 0 },                               \
+            { 0, FIX_POINT(DER_COEFF2), FIX_POINT(-SS_PID_DER) },   \
+            { 0, 0, 0 }                                             \
+        }
+
+#define SS_PID_FIX_B {                                              \
+            { FIX_POINT(INT_COEFF), FIX_POINT(-(INT_COEFF)) },      \
+            { FIX_POINT(SW_C * SS_PID_DER),                         \
+              FIX_POINT(-SS_PID_DER) },                             \
+            { FIX_POINT(SW_C), FIX_POINT(-1.0) }                    \
+        }
+
+#define SS_PID_FIX_C {                                              \
+            { FIX_POINT(1.0), FIX_POINT(DER_COEFF2),                \
+              FIX_POINT(-SS_PID_DER) }                              \
+        }
+
+#define SS_PID_FIX_D {                                              \
+            { FIX_POINT(KP * SW_B + (INT_COEFF)                     \
+                        + SW_C * SS_PID_DER),                       \
+              FIX_POINT(-KP - (INT_COEFF) - SS_PID_DER) }           \
+        }
+
+#endif
@@ -0,0 +1,133 @@
+/*
+ * Trajectory.c
+ *
+ * Setpoint trajectory generator with ramp and S-curve profiles.
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "Trajectory.h"
+
+// Conversion between floating point and fixed point values at run time. Unlike
+// FIX_POINT() and fix2float() these only use single precision multiplication.
+#define TO_FIX(x)       (fix_t)((x) * (float)CONVERSION_FACTOR)
+#define TO_FLOAT(x)     ((float)(x) * (float)(1.0 / CONVERSION_FACTOR))
+
+// Check whether, after moving by `rate` in the next sample, the setpoint can
+// still be stopped at `remaining` by reducing the rate by `jerk` each sample.
+// Both `remaining` and `rate` are measured towards the commanded value.
+static bool canStop(fix_t remaining, fix_t rate, fix_t jerk);
+
+// Calculate the rate of a ramp profile
+static fix_t rampRate(fix_t remaining, fix_t rateIncrement);
+
+// Calculate the rate of an S-curve profile
+static fix_t sCurveRate(fix_t remaining, fix_t rate, fix_t rateIncrement,
+                        fix_t jerkIncrement);
+
+void trajectoryInit(struct trajectory *traj, enum trajectoryProfile profile,
+                    fix_t rateIncrement, fix_t jerkIncrement,
+                    volatile float *command, volatile float *setpointOut) {
+    if (traj == NULL)
+        return;
+
+    traj->profile = profile;
+    traj->rateIncrement = rateIncrement;
+    traj->jerkIncrement = jerkIncrement;
+
+    traj->command = command;
+    traj->setpointOut = setpointOut;
+
+    traj->setpoint = TO_FIX(*command);
+    traj->rate = 0;
+
+    *(traj->setpointOut) = *(traj->command);
+}
+
+float runTrajectory(struct trajectory *traj) {
+    if (traj == NULL)
+        return 0;
+
+    fix_t target = TO_FIX(*(traj->command));
+    fix_t remaining = target - traj->setpoint;
+
+    if (traj->profile == TRAJECTORY_RAMP)
+        traj->rate = rampRate(remaining, traj->rateIncrement);
+    else
+        traj->rate = sCurveRate(remaining, traj->rate, traj->rateIncrement,
+                                traj->jerkIncrement);
+
+    traj->setpoint += traj->rate;
+
+    float setpoint = TO_FLOAT(traj->setpoint);
+
+    // Output the commanded value itself once it is reached so that it is not
+    // affected by conversion to and from fixed point
+    if (traj->setpoint == target)
+        setpoint = *(traj->command);
+
+    *(traj->setpointOut) = setpoint;
+
+    return setpoint;
+}
+
+static bool canStop(fix_t remaining, fix_t rate, fix_t jerk) {
+    // Moving away from (or stopped at) the commanded value
+    if (rate <= 0)
+        return true;
+
+    // Reducing the rate by the jerk increment each sample after this one, the
+    // setpoint moves a further (rate - jerk) + (rate - 2 jerk) + ... so the
+    // total distance including this sample is rate * (rate + jerk) / (2 jerk).
+    // This is compared without division.
+    dint_t distance = (dint_t)rate * (rate + jerk);
+    dint_t available = 2 * (dint_t)jerk * remaining;
+
+    return distance <= available;
+}
+
+static fix_t rampRate(fix_t remaining, fix_t rateIncrement) {
+    if (remaining > rateIncrement)
+        return rateIncrement;
+    else if (remaining < -rateIncrement)
+        return -rateIncrement;
+    else
+        return remaining;
+}
+
+static fix_t sCurveRate(fix_t remaining, fix_t rate, fix_t rateIncrement,
+                        fix_t jerkIncrement) {
+    // Work in the direction of the commanded value so that only one case needs
+    // to be considered
+    bool negative = remaining < 0;
+    if (negative) {
+        remaining = -remaining;
+        rate = -rate;
+    }
+
+    // Finish once the commanded value can be reached within one jerk increment
+    if (remaining <= jerkIncrement && rate <= jerkIncrement && rate >= -jerkIncrement)
+        return negative ? -remaining : remaining;
+
+    // Accelerate if possible, otherwise hold the current rate, otherwise brake
+    fix_t faster = rate + jerkIncrement;
+    if (faster > rateIncrement)
+        faster = rateIncrement;
+
+    fix_t slower = rate - jerkIncrement;
+    if (slower < -rateIncrement)
+        slower = -rateIncrement;
+
+    if (canStop(remaining, faster, jerkIncrement))
+        rate = faster;
+    else if (!canStop(remaining, rate, jerkIncrement))
+        rate = slower;
+
+    return negative ? -rate : rate;
+}
@@ -0,0 +1,83 @@
+/*
+ * Trajectory.h
+ *
+ * Setpoint trajectory generator which limits how quickly the setpoint of a
+ * controller changes, so that a step in the commanded value does not saturate
+ * the controller output.
+ *
+ * Two profiles are available:
+ *
+ *      - TRAJECTORY_RAMP limits the change in setpoint per sample (the
+ *        acceleration, when the setpoint is a velocity)
+ *      - TRAJECTORY_SCURVE also limits the change in that rate per sample (the
+ *        jerk), giving an S-shaped transition
+ *
+ * The generator works in fixed point with increments calculated ahead of time,
+ * so the setpoint always lands exactly on the commanded value. Each step takes
+ * a bounded number of operations with no loops or division, so it is suitable
+ * for running in the control interrupt just before the controller.
+ *
+ * Usage:
+ *      struct trajectory traj;
+ *      trajectoryInit(&traj, TRAJECTORY_SCURVE,
+ *                     TRAJECTORY_RATE_INCREMENT(TRAJ_MAX_ACCEL, FS),
+ *                     TRAJECTORY_JERK_INCREMENT(TRAJ_MAX_JERK, FS),
+ *                     &commandReg, &setpointReg);
+ *
+ *      // In the control interrupt
+ *      runTrajectory(&traj);
+ *      runControlAlgorithm(pid);
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team
+ */
+
+#ifndef TRAJECTORY_H
+#define TRAJECTORY_H
+
+#include "fix_t.h"
+
+// Maximum change in setpoint per sample for a maximum rate of change (in
+// setpoint units per second) and sampling frequency
+#define TRAJECTORY_RATE_INCREMENT(maxRate, sampleFreq)                          \
+            FIX_POINT((maxRate) / (sampleFreq))
+
+// Maximum change in the setpoint rate per sample for a maximum second
+// derivative (in setpoint units per second squared) and sampling frequency
+#define TRAJECTORY_JERK_INCREMENT(maxJerk, sampleFreq)                          \
+            FIX_POINT((maxJerk) / ((sampleFreq) * (sampleFreq)))
+
+enum trajectoryProfile {
+    TRAJECTORY_RAMP,
+    TRAJECTORY_SCURVE
+};
+
+// The trajectory takes one input, the commanded value, and provides one output,
+// the setpoint. As with the PID controller these are memory locations.
+//
+// A trajectory must be set up with trajectoryInit() before use.
+struct trajectory {
+    enum trajectoryProfile profile;
+
+    fix_t rateIncrement;        // Maximum change in setpoint per sample
+    fix_t jerkIncrement;        // Maximum change in rate per sample (S-curve)
+
+    volatile float *command;
+    volatile float *setpointOut;
+
+    fix_t setpoint;
+    fix_t rate;                 // Change in setpoint in the last sample
+};
+
+// Set up a trajectory. The setpoint starts at the current commanded value.
+void trajectoryInit(struct trajectory *traj, enum trajectoryProfile profile,
+                    fix_t rateIncrement, fix_t jerkIncrement,
+                    volatile float *command, volatile float *setpointOut);
+
+// Move the setpoint one sample towards the commanded value and write it to the
+// output. Returns the new setpoint.
+float runTrajectory(struct trajectory *traj);
+
+#endif
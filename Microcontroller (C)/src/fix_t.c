@@ -11,10 +11,78 @@
 #include "fix_t.h"
 
 #include <stdbool.h>
+#include <stddef.h>
+
+word_t fixStatus = 0;
 
 // Obtain the sign of a fixed point number.
 static Sign getSign(fix_t x);
 
+// sin(i * pi / 512) in Q16 for a quarter of a turn, as in utils/sine.c.
+// sin(pi / 2) is stored as 0xFFFF rather than 1.0 to fit 16 bits. The Q16
+// values are converted to Q_POINT by sineTurns().
+static const uint16_t sineTable[257] = {
+    0x0000, 0x0192, 0x0324, 0x04B6, 0x0648, 0x07DA, 0x096C, 0x0AFE,
+    0x0C90, 0x0E21, 0x0FB3, 0x1144, 0x12D5, 0x1466, 0x15F7, 0x1787,
+    0x1918, 0x1AA8, 0x1C38, 0x1DC7, 0x1F56, 0x20E5, 0x2274, 0x2402,
+    0x2590, 0x271E, 0x28AB, 0x2A38, 0x2BC4, 0x2D50, 0x2EDC, 0x3067,
+    0x31F1, 0x337C, 0x3505, 0x368E, 0x3817, 0x399F, 0x3B27, 0x3CAE,
+    0x3E34, 0x3FBA, 0x413F, 0x42C3, 0x4447, 0x45CB, 0x474D, 0x48CF,
+    0x4A50, 0x4BD1, 0x4D50, 0x4ECF, 0x504D, 0x51CB, 0x5348, 0x54C3,
+    0x563E, 0x57B9, 0x5932, 0x5AAA, 0x5C22, 0x5D99, 0x5F0F, 0x6084,
+    0x61F8, 0x636B, 0x64DD, 0x664E, 0x67BE, 0x692D, 0x6A9B, 0x6C08,
+    0x6D74, 0x6EDF, 0x7049, 0x71B2, 0x731A, 0x7480, 0x75E6, 0x774A,
+    0x78AD, 0x7A10, 0x7B70, 0x7CD0, 0x7E2F, 0x7F8C, 0x80E8, 0x8243,
+    0x839C, 0x84F5, 0x864C, 0x87A1, 0x88F6, 0x8A49, 0x8B9A, 0x8CEB,
+    0x8E3A, 0x8F88, 0x90D4, 0x921F, 0x9368, 0x94B0, 0x95F7, 0x973C,
+    0x9880, 0x99C2, 0x9B03, 0x9C42, 0x9D80, 0x9EBC, 0x9FF7, 0xA130,
+    0xA268, 0xA39E, 0xA4D2, 0xA605, 0xA736, 0xA866, 0xA994, 0xAAC1,
+    0xABEB, 0xAD14, 0xAE3C, 0xAF62, 0xB086, 0xB1A8, 0xB2C9, 0xB3E8,
+    0xB505, 0xB620, 0xB73A, 0xB852, 0xB968, 0xBA7D, 0xBB8F, 0xBCA0,
+    0xBDAF, 0xBEBC, 0xBFC7, 0xC0D1, 0xC1D8, 0xC2DE, 0xC3E2, 0xC4E4,
+    0xC5E4, 0xC6E2, 0xC7DE, 0xC8D9, 0xC9D1, 0xCAC7, 0xCBBC, 0xCCAE,
+    0xCD9F, 0xCE8E, 0xCF7A, 0xD065, 0xD14D, 0xD234, 0xD318, 0xD3FB,
+    0xD4DB, 0xD5BA, 0xD696, 0xD770, 0xD848, 0xD91E, 0xD9F2, 0xDAC4,
+    0xDB94, 0xDC62, 0xDD2D, 0xDDF7, 0xDEBE, 0xDF83, 0xE046, 0xE107,
+    0xE1C6, 0xE282, 0xE33C, 0xE3F4, 0xE4AA, 0xE55E, 0xE610, 0xE6BF,
+    0xE76C, 0xE817, 0xE8BF, 0xE966, 0xEA0A, 0xEAAB, 0xEB4B, 0xEBE8,
+    0xEC83, 0xED1C, 0xEDB3, 0xEE47, 0xEED9, 0xEF68, 0xEFF5, 0xF080,
+    0xF109, 0xF18F, 0xF213, 0xF295, 0xF314, 0xF391, 0xF40C, 0xF484,
+    0xF4FA, 0xF56E, 0xF5DF, 0xF64E, 0xF6BA, 0xF724, 0xF78C, 0xF7F1,
+    0xF854, 0xF8B4, 0xF913, 0xF96E, 0xF9C8, 0xFA1F, 0xFA73, 0xFAC5,
+    0xFB15, 0xFB62, 0xFBAD, 0xFBF5, 0xFC3B, 0xFC7F, 0xFCC0, 0xFCFE,
+    0xFD3B, 0xFD74, 0xFDAC, 0xFDE1, 0xFE13, 0xFE43, 0xFE71, 0xFE9C,
+    0xFEC4, 0xFEEB, 0xFF0E, 0xFF30, 0xFF4E, 0xFF6B, 0xFF85, 0xFF9C,
+    0xFFB1, 0xFFC4, 0xFFD4, 0xFFE1, 0xFFEC, 0xFFF5, 0xFFFB, 0xFFFF,
+    0xFFFF
+};
+
+// atan(2^-i) in Q29 radians, for CORDIC. Angles are accumulated with more
+// fraction bits than fix_t so that the rounding of each step does not add up.
+// Each iteration adds about one bit to the angle, so Q_POINT + 4 iterations
+// leave an error well below the last place of the result (20 in Q16).
+#define CORDIC_MAX_ITERATIONS   29
+#define CORDIC_ITERATIONS       (Q_POINT + 4 < CORDIC_MAX_ITERATIONS \
+                                 ? Q_POINT + 4 : CORDIC_MAX_ITERATIONS)
+#define CORDIC_Q_POINT          29
+#define CORDIC_HALF_PI          843314857
+static const int32_t cordicAngles[CORDIC_MAX_ITERATIONS] = {
+    421657428, 248918915, 131521918, 66762579, 33510843, 16771758, 8387925,
+    4194219, 2097141, 1048575, 524288, 262144, 131072, 65536, 32768, 16384,
+    8192, 4096, 2048, 1024, 512, 256, 128, 64, 32, 16, 8, 4, 2
+};
+
+// Sine of an angle as a fraction of a turn in 0.32 format
+static fix_t sineTurns(word_t turns);
+
+// Convert an angle in radians to a fraction of a turn in 0.32 format. Angles
+// outside one turn wrap.
+static word_t radiansToTurns(fix_t angle);
+
+// Truncate a double length accumulator to a fixed point number, saturating
+// and setting FIX_STATUS_ACCUMULATE_OVERFLOW if it is out of range.
+static fix_t saturateAccumulator(dint_t acc);
+
 // Check whether two fixed point numbers have the same sign.
 // Return true if both numbers are positive or both are negative; false
 // otherwise.
@@ -102,6 +170,205 @@ fix_t fixMultiply(fix_t x, fix_t y) {
 
 }
 
+fix_t fixDot(const fix_t *x, const fix_t *y, uint32_t length) {
+    if (x == NULL || y == NULL)
+        return 0;
+
+    dint_t acc = 0;
+    for (uint32_t i = 0; i < length; i++)
+        acc += (dint_t)x[i] * y[i];
+
+    return saturateAccumulator(acc);
+}
+
+void fixFir(const fix_t *coeffs, fix_t *state, uint32_t numTaps,
+            const fix_t *input, fix_t *output, uint32_t length) {
+    if (coeffs == NULL || state == NULL || input == NULL || output == NULL || numTaps == 0)
+        return;
+
+    // Number of previous inputs needed
+    uint32_t history = numTaps - 1;
+
+    for (uint32_t n = 0; n < length; n++) {
+        dint_t acc = 0;
+
+        // Taps over inputs in this block, then over inputs before it. Input
+        // n - k is in state[history + n - k] when n < k.
+        uint32_t inBlock = n < history ? n + 1 : numTaps;
+        for (uint32_t k = 0; k < inBlock; k++)
+            acc += (dint_t)coeffs[k] * input[n - k];
+        for (uint32_t k = inBlock; k < numTaps; k++)
+            acc += (dint_t)coeffs[k] * state[history + n - k];
+
+        output[n] = saturateAccumulator(acc);
+    }
+
+    // Keep the last `history` inputs for the next block
+    if (length >= history) {
+        for (uint32_t i = 0; i < history; i++)
+            state[i] = input[length - history + i];
+    } else {
+        for (uint32_t i = 0; i < history - length; i++)
+            state[i] = state[i + length];
+        for (uint32_t i = 0; i < length; i++)
+            state[history - length + i] = input[i];
+    }
+}
+
+void fixMacBlock(fix_t *acc, const fix_t *x, const fix_t *y, uint32_t length) {
+    if (acc == NULL || x == NULL || y == NULL)
+        return;
+
+    // The accumulator is scaled by a multiplication, as left shifting a
+    // negative value is undefined
+    for (uint32_t i = 0; i < length; i++)
+        acc[i] = saturateAccumulator((dint_t)acc[i] * ((dint_t)1 << Q_POINT)
+                                     + (dint_t)x[i] * y[i]);
+}
+
+fix_t fixDivide(fix_t x, fix_t y) {
+    Sign sign = getSign(x ^ y);
+    word_t ux = getSign(x) ? -(word_t)x : (word_t)x;
+    word_t uy = getSign(y) ? -(word_t)y : (word_t)y;
+
+    if (uy == 0) {
+        fixStatus |= FIX_STATUS_DIVIDE_OVERFLOW;
+        return getSign(x) ? FIX_MIN : FIX_MAX;
+    }
+
+    // Normalise the divisor to d in [0.5, 1) in 0.32 format
+    uint32_t shift = __builtin_clz(uy);
+    word_t d = uy << shift;
+
+    // Reciprocal r of d in Q30, starting from the linear estimate
+    // 48/17 - 32/17 d, which is within 1/17 on [0.5, 1). Each iteration of
+    // r = r (2 - d r) doubles the number of correct bits.
+    word_t r = 3031741621u - (word_t)(((dword_t)2021161080u * d) >> 32);
+    for (int i = 0; i < 3; i++) {
+        word_t dr = (word_t)(((dword_t)d * r) >> 32);
+        r = (word_t)(((dword_t)r * (((word_t)1 << 31) - dr)) >> 30);
+    }
+
+    // Estimate |x| 2^Q_POINT / |y| = |x| r 2^Q_POINT / 2^(30 + 32 - shift)
+    dword_t quotient = ((dword_t)ux * r) >> (30 + WORD_SIZE - Q_POINT - shift);
+
+    // Largest magnitude of the result, which is one more for a negative result
+    dword_t limit = (dword_t)INT32_MAX + (sign == SIGN_NEGATIVE);
+
+    // The estimate is within a few units of the exact quotient, so only an
+    // estimate close to the limit needs to be corrected before checking it
+    if (quotient <= limit + 8) {
+        // Correct the estimate to the exact quotient from its remainder
+        dint_t remainder = ((dint_t)ux << Q_POINT) - (dint_t)(quotient * uy);
+        while (remainder < 0) {
+            quotient--;
+            remainder += uy;
+        }
+        while (remainder >= (dint_t)uy) {
+            quotient++;
+            remainder -= uy;
+        }
+    }
+
+    if (quotient > limit) {
+        fixStatus |= FIX_STATUS_DIVIDE_OVERFLOW;
+        return sign ? FIX_MIN : FIX_MAX;
+    }
+
+    return sign ? (fix_t)-(word_t)quotient : (fix_t)quotient;
+}
+
+fix_t fixSqrt(fix_t x) {
+    if (x < 0) {
+        fixStatus |= FIX_STATUS_DOMAIN_ERROR;
+        return 0;
+    }
+
+    if (x == 0)
+        return 0;
+
+    // Root of x 2^Q_POINT, which has Q_POINT fraction bits. Two bits of the
+    // radicand are brought down for each bit of the root, as in isqrt(),
+    // skipping pairs of leading zeros. The radicand has WORD_SIZE + Q_POINT
+    // bits, so for an odd Q_POINT a leading zero is added to pair them up.
+    const int pad = Q_POINT & 1;
+    const int radicandBits = WORD_SIZE + Q_POINT + pad;
+    int zeroPairs = (__builtin_clz((word_t)x) + pad) / 2;
+    dword_t value = (dword_t)x << (Q_POINT + 64 - radicandBits + 2 * zeroPairs);
+    dword_t remainder = 0;
+    word_t root = 0;
+
+    for (int i = zeroPairs; i < radicandBits / 2; i++) {
+        root <<= 1;
+        remainder = (remainder << 2) | (value >> 62);
+        value <<= 2;
+
+        // Set the next bit if (2 root + 1)^2 - (2 root)^2 = 4 root + 1 fits in
+        // the remainder, without a branch as the bits are unpredictable
+        dword_t trial = ((dword_t)root << 1) | 1;
+        word_t bit = trial <= remainder;
+        remainder -= trial & -(dword_t)bit;
+        root |= bit;
+    }
+
+    return (fix_t)root;
+}
+
+fix_t fixSin(fix_t angle) {
+    return sineTurns(radiansToTurns(angle));
+}
+
+fix_t fixCos(fix_t angle) {
+    return sineTurns(radiansToTurns(angle) + ((word_t)1 << 30));
+}
+
+fix_t fixAtan2(fix_t y, fix_t x) {
+    if (x == 0 && y == 0)
+        return 0;
+
+    // Work in double length so that scaling and the CORDIC gain (about 1.65)
+    // cannot overflow
+    dint_t vx = x, vy = y;
+    dint_t angle = 0;
+
+    // Rotate into the right half plane, by +/- pi / 2, where CORDIC converges
+    if (vx < 0) {
+        dint_t t = vx;
+        if (vy >= 0) {
+            vx = vy;
+            vy = -t;
+            angle = CORDIC_HALF_PI;
+        } else {
+            vx = -vy;
+            vy = t;
+            angle = -CORDIC_HALF_PI;
+        }
+    }
+
+    // Scale small vectors up so that the last iterations still have bits to
+    // shift
+    while (vx < ((dint_t)1 << 40) && vy < ((dint_t)1 << 40) && vy > -((dint_t)1 << 40))
+        vx <<= 8, vy <<= 8;
+
+    // Rotate the vector onto the x axis, accumulating the angle turned
+    for (int i = 0; i < CORDIC_ITERATIONS; i++) {
+        dint_t dx = vy >> i, dy = vx >> i;
+        if (vy > 0) {
+            vx += dx;
+            vy -= dy;
+            angle += cordicAngles[i];
+        } else {
+            vx -= dx;
+            vy += dy;
+            angle -= cordicAngles[i];
+        }
+    }
+
+    // Round from CORDIC_Q_POINT fraction bits to Q_POINT
+    const int shift = CORDIC_Q_POINT - Q_POINT;
+    return (fix_t)((angle + ((dint_t)1 << (shift - 1))) >> shift);
+}
+
 /* fix_t fixMultiply_preshift(fix_t x, fix_t y, uint8_t shift, ShiftDirection direction) { */
 /*     return x * y; // Placeholder */
 /* } */
@@ -116,6 +383,50 @@ static Sign getSign(fix_t x) {
     }
 }
 
+static fix_t sineTurns(word_t turns) {
+    // Position within the quarter turn, mirrored in the second and fourth
+    // quarters
+    word_t position = turns & 0x3FFFFFFF;
+    if (turns & 0x40000000)
+        position = 0x40000000 - position;
+
+    // 256 table steps per quarter turn, each of 2^22
+    word_t index = position >> 22;
+    word_t fraction = position & 0x3FFFFF;
+    int32_t s0 = sineTable[index];
+    int32_t s1 = sineTable[index < 256 ? index + 1 : 256];
+
+    // The interpolated value has 16 + 22 fraction bits, and is rounded to
+    // Q_POINT fraction bits. In Q16 this only rounds the interpolation.
+    dint_t interpolated = ((dint_t)s0 << 22) + (dint_t)(s1 - s0) * fraction;
+    fix_t value = (fix_t)((interpolated + ((dint_t)1 << (37 - Q_POINT))) >> (38 - Q_POINT));
+
+    return (turns & 0x80000000) ? -value : value;
+}
+
+static word_t radiansToTurns(fix_t angle) {
+    // Multiply by 2^32 / (2 pi) = 683565275 + 2475754826 / 2^32, with the
+    // fraction of the constant kept so that large angles are still accurate.
+    // The fraction of a turn is the low word of the product, which wraps once
+    // per turn.
+    dint_t product = (dint_t)angle * 683565275 + (((dint_t)angle * 2475754826u) >> 32);
+    return (word_t)(product >> Q_POINT);
+}
+
+static fix_t saturateAccumulator(dint_t acc) {
+    dint_t result = acc >> Q_POINT;
+
+    if (result > INT32_MAX) {
+        fixStatus |= FIX_STATUS_ACCUMULATE_OVERFLOW;
+        return FIX_MAX;
+    } else if (result < INT32_MIN) {
+        fixStatus |= FIX_STATUS_ACCUMULATE_OVERFLOW;
+        return FIX_MIN;
+    }
+
+    return (fix_t)result;
+}
+
 static bool haveSameSign(fix_t x, fix_t y) {
     // The value x ^ y will have a sign bit of 0 if the sign bits of both
     // values (x and y separately) are the same [1 ^ 1 = 0 and 0 ^ 0 = 0]. If
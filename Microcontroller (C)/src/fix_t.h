@@ -13,15 +13,31 @@
 
 #include <stdint.h>
 
+#if defined(__ARM_FEATURE_DSP) && __ARM_FEATURE_DSP
+#include <arm_acle.h>
+#endif
+
 // ============================================================================
 // Note:
 //
 // If changing the format of the fixed point representation such as the number
 // of bits or location of the decimal point then the following definitions must
 // be changed.
+//
+// The Q16 format matches the FPGA controller (Controller.v) so that both
+// implementations produce identical results from identical inputs.
 
-// Number of fraction bits in fixed point numbers
-#define Q_POINT 14
+// Number of fraction bits in fixed point numbers. It may also be given on the
+// command line, as for the Q14 and Q15 builds of test/fixPropertyTest.c.
+#ifndef Q_POINT
+#define Q_POINT 16
+#endif
+
+// fixMultiplySat() needs at least one fraction bit, and fixAtan2() fewer than
+// its CORDIC angles have
+#if Q_POINT < 1 || Q_POINT > 28
+#error "Q_POINT must be from 1 to 28"
+#endif
 
 // Number of bits in fixed point number
 #define WORD_SIZE 32
@@ -30,7 +46,7 @@
 // representation. Equal to 2^Q_POINT which when multiplying, has the same
 // effect as bit shifting Q_POINT bits to the left.  Used in the FIX_POINT(x) macro
 // and is a floating point type to allow conversion of decimal values.
-#define CONVERSION_FACTOR 16384.0
+#define CONVERSION_FACTOR ((double)(1ULL << Q_POINT))
 
 // Fixed point number type.
 // The fix_t type is only for fixed point number representation. Any other data
@@ -82,18 +98,187 @@ static const word_t signMask = (word_t)1 << (WORD_SIZE - 1);
 // legitimately calculated.
 static const fix_t fixOverflow = (fix_t)0 | signMask;
 
+// Largest and smallest representable values, which saturating operations
+// return on overflow
+#define FIX_MAX ((fix_t)INT32_MAX)
+#define FIX_MIN ((fix_t)INT32_MIN)
+
+// Flags in fixStatus, set by the saturating operations which overflowed
+#define FIX_STATUS_ADD_OVERFLOW         0x1u
+#define FIX_STATUS_SUBTRACT_OVERFLOW    0x2u
+#define FIX_STATUS_MULTIPLY_OVERFLOW    0x4u
+#define FIX_STATUS_RESCALE_OVERFLOW     0x8u    // See FixFormat.h
+#define FIX_STATUS_ACCUMULATE_OVERFLOW  0x10u
+#define FIX_STATUS_DIVIDE_OVERFLOW      0x20u   // Including division by zero
+#define FIX_STATUS_DOMAIN_ERROR         0x40u   // Square root of a negative number
+
+// Angles in radians
+#define FIX_PI          FIX_POINT(3.14159265358979)
+#define FIX_HALF_PI     FIX_POINT(1.57079632679490)
+
+// Sticky status word of the saturating operations. Flags are only ever set by
+// the operations, so a value of 0 after a calculation means that no result in
+// it was saturated. Use fixStatusClear() to reset it.
+//
+// The flags are set with a read-modify-write, so a flag set in an interrupt
+// can be lost if the interrupted code is itself part way through a saturating
+// operation.
+extern word_t fixStatus;
+
 // ============================================================================
 // Function Definitions
 // ============================================================================
 
+// The following return fixOverflow on overflow. As fixOverflow is also a valid
+// value, the saturating operations below should be preferred in new code.
 fix_t fixAdd(fix_t x, fix_t y);
 
 fix_t fixSubtract(fix_t x, fix_t y);
 
 fix_t fixMultiply(fix_t x, fix_t y);
 
+// Saturating operations, which return FIX_MAX or FIX_MIN on overflow and set a
+// flag in fixStatus. On a Cortex-M4 these use the QADD, QSUB, SMULL and SSAT
+// instructions. Elsewhere they are calculated without branches.
+static inline fix_t fixAddSat(fix_t x, fix_t y);
+
+static inline fix_t fixSubtractSat(fix_t x, fix_t y);
+
+static inline fix_t fixMultiplySat(fix_t x, fix_t y);
+
+static inline word_t fixStatusGet(void) {
+    return fixStatus;
+}
+
+static inline void fixStatusClear(void) {
+    fixStatus = 0;
+}
+
+// Vector kernels, which accumulate products in double length (a single SMLAL
+// per term on the Cortex-M4) and truncate and saturate only once per result.
+// On overflow of a result they set FIX_STATUS_ACCUMULATE_OVERFLOW. The double
+// length accumulator itself is not checked. It holds the products with
+// 2 * Q_POINT fraction bits, so the sum and every partial sum must stay below
+// 2^(63 - 2 * Q_POINT) in magnitude (2^31 in Q16), such as a sum of 2^30
+// products of values within +/- 1.0. Two products of values near FIX_MAX
+// already overflow it.
+
+// Dot product of x and y, of `length` values each
+fix_t fixDot(const fix_t *x, const fix_t *y, uint32_t length);
+
+// FIR filter with numTaps coefficients over a block of `length` inputs
+//
+//      output[n] = coeffs[0] * input[n] + ... + coeffs[numTaps - 1] * input[n - numTaps + 1]
+//
+// `state` holds the numTaps - 1 inputs before the block, oldest first, and is
+// updated with the last inputs of the block, so consecutive blocks are
+// filtered as one signal. It should start at zero. output must not overlap
+// input.
+void fixFir(const fix_t *coeffs, fix_t *state, uint32_t numTaps,
+            const fix_t *input, fix_t *output, uint32_t length);
+
+// Multiply-accumulate over a block, such as one term of several channels of a
+// controller: acc[i] = acc[i] + x[i] * y[i]
+void fixMacBlock(fix_t *acc, const fix_t *x, const fix_t *y, uint32_t length);
+
+// Division and elementary functions, for unit conversions and odometry without
+// the FPU. These saturate, setting a flag in fixStatus, rather than returning
+// fixOverflow.
+
+// x / y, truncated towards zero as in integer division. The reciprocal of y is
+// found by Newton-Raphson iteration and the quotient then corrected to be
+// exact, which avoids the 64-bit division of the C library. Division by zero
+// saturates in the direction of x.
+fix_t fixDivide(fix_t x, fix_t y);
+
+// Square root, rounded down, of a non-negative number. Calculated a bit at a
+// time, as isqrt() in utils/isqrt.c but over the WORD_SIZE + Q_POINT bits
+// needed for the fraction bits of the result (rounded up to an even number).
+// Negative numbers give 0.
+fix_t fixSqrt(fix_t x);
+
+// Sine and cosine of an angle in radians, from a quarter-wave table with
+// linear interpolation between its 257 entries, as sine() in utils/sine.c.
+// The table is in Q16, so the error is at most 1.5 * 2^-Q_POINT in formats up
+// to Q16, and 1.5 * 2^-16 in formats with more fraction bits.
+fix_t fixSin(fix_t angle);
+
+fix_t fixCos(fix_t angle);
+
+// Angle of the point (x, y) in radians, between -FIX_PI and FIX_PI, by CORDIC
+// vectoring. The error is at most 2^-Q_POINT in formats up to Q24, beyond
+// which the precision of the CORDIC angles limits it. fixAtan2(0, 0) is 0.
+fix_t fixAtan2(fix_t y, fix_t x);
+
 /* #ifdef DEBUG */
 float fix2float(fix_t x);
 /* #endif */
 
+// ============================================================================
+// Saturating Operations
+// ============================================================================
+
+// Select `saturated` if `overflow` is 1 or `result` if it is 0, without a
+// branch
+static inline fix_t fixSelect(word_t overflow, word_t result, word_t saturated) {
+    word_t mask = -overflow;
+    return (fix_t)((result & ~mask) | (saturated & mask));
+}
+
+// FIX_MAX if the sign bit of `sign` is clear, otherwise FIX_MIN
+static inline word_t fixSaturated(word_t sign) {
+    return (word_t)INT32_MAX ^ (word_t)-(sign >> (WORD_SIZE - 1));
+}
+
+static inline fix_t fixAddSat(fix_t x, fix_t y) {
+    word_t sum = (word_t)x + (word_t)y;
+
+#if defined(__ARM_FEATURE_DSP) && __ARM_FEATURE_DSP
+    fix_t result = __qadd(x, y);
+    fixStatus |= (word_t)(result != (fix_t)sum) * FIX_STATUS_ADD_OVERFLOW;
+    return result;
+#else
+    // Overflow if x and y have the same sign and the sum does not
+    word_t overflow = (((word_t)x ^ sum) & ((word_t)y ^ sum)) >> (WORD_SIZE - 1);
+    fixStatus |= overflow * FIX_STATUS_ADD_OVERFLOW;
+    return fixSelect(overflow, sum, fixSaturated((word_t)x));
+#endif
+}
+
+static inline fix_t fixSubtractSat(fix_t x, fix_t y) {
+    word_t difference = (word_t)x - (word_t)y;
+
+#if defined(__ARM_FEATURE_DSP) && __ARM_FEATURE_DSP
+    fix_t result = __qsub(x, y);
+    fixStatus |= (word_t)(result != (fix_t)difference) * FIX_STATUS_SUBTRACT_OVERFLOW;
+    return result;
+#else
+    // Overflow if x and y have different signs and the difference does not
+    // have the sign of x
+    word_t overflow = (((word_t)x ^ (word_t)y) & ((word_t)x ^ difference)) >> (WORD_SIZE - 1);
+    fixStatus |= overflow * FIX_STATUS_SUBTRACT_OVERFLOW;
+    return fixSelect(overflow, difference, fixSaturated((word_t)x));
+#endif
+}
+
+static inline fix_t fixMultiplySat(fix_t x, fix_t y) {
+    // A single SMULL on the Cortex-M4
+    dint_t product = (dint_t)x * y;
+    word_t result = (word_t)(product >> Q_POINT);
+
+    // The result is the product without its lowest Q_POINT bits, so it fits if
+    // the product is a (WORD_SIZE + Q_POINT)-bit signed number. That is, if the
+    // upper word of the product is within the range of a Q_POINT-bit signed
+    // number.
+    int32_t hi = (int32_t)(product >> WORD_SIZE);
+#if defined(__ARM_FEATURE_DSP) && __ARM_FEATURE_DSP
+    word_t overflow = __ssat(hi, Q_POINT) != hi;
+#else
+    word_t overflow = ((word_t)(hi >> (Q_POINT - 1)) + 1) > 1;
+#endif
+
+    fixStatus |= overflow * FIX_STATUS_MULTIPLY_OVERFLOW;
+    return fixSelect(overflow, result, fixSaturated((word_t)hi));
+}
+
 #endif
@@ -16,23 +16,188 @@
 #include "driverlib/qei.h"
 
 #include "PIDController.h"
+#include "PositionLoop.h"
+#include "Autotune.h"
+#include "Biquad.h"
+#include "CICDecimator.h"
+#include "EventTrigger.h"
+#include "ExplicitMPC.h"
+#include "GainSchedule.h"
+#include "RLSEstimator.h"
+#include "SmithPredictor.h"
+#include "Snapshot.h"
+#include "Trajectory.h"
 #include "PWMControl.h"
 #include "QEIControl.h"
 
 #include "units.h"
 #include "ControllerParameters.h"
+#include "MotorParameters.h"
+#include "FeedbackFilter.h"
 
 #define ZERO 0.0f
 
+// When defined, an outer position loop sets the velocity setpoint so that the
+// wheel is driven to an angle (see PositionLoop.h), and GPIO A7 selects an
+// angle of 0 or 90 degrees instead of a speed of 10 or 20 rpm
+// #define CASCADED_POSITION_CONTROL
+
+// When defined, the velocity controller adds a feedforward term calculated from
+// the motor model so that setpoint changes need less integral action, and the
+// velocity gains are replaced by FF_KP and FF_KI (see feedforwardBenchmark)
+// #define MODEL_FEEDFORWARD
+
+// When defined, changes in the commanded velocity are limited in acceleration
+// and jerk before reaching the velocity controller
+// #define SETPOINT_TRAJECTORY
+
+// When defined, the velocity controller is given the feedback of a Smith
+// predictor (see SmithPredictor.h) and its gains are raised by SMITH_GAIN_SCALE
+// #define SMITH_PREDICTOR
+
+// When defined, the velocity is sampled QEI_OVERSAMPLE times per control sample
+// and decimated to FS (see CICDecimator.h)
+// #define OVERSAMPLE_FEEDBACK
+
+// When defined, the measured speed is low-pass filtered (see FeedbackFilter.h)
+// before it reaches the controllers, to reduce encoder quantisation noise
+// #define FILTER_FEEDBACK
+
+// When defined, the explicit model predictive controller is used for velocity
+// control instead of the PID controller
+// #define EXPLICIT_MPC
+
+// When defined, the velocity controller gains are interpolated from the table
+// in GainScheduleTable.h using the velocity setpoint. The table is generated
+// from models of the motor at several speeds, or built up on the board with
+// ONLINE_IDENTIFICATION. The gains are replaced every sample, so this cannot be
+// used with AUTOTUNE.
+// #define GAIN_SCHEDULING
+
+// When defined, the velocity PID controller and PWM output are only updated
+// when the error changes (see EventTrigger.h). It cannot be used with
+// EXPLICIT_MPC or GAIN_SCHEDULING.
+// #define EVENT_TRIGGERED
+
+// When defined, the motor model is identified online and the velocity
+// controller gains are periodically recalculated from it. With GAIN_SCHEDULING
+// the gains are written to the breakpoint nearest the speed instead.
+// #define ONLINE_IDENTIFICATION
+
+// When defined, a relay experiment is run at startup and the velocity
+// controller gains are calculated from it before the controller starts
+// #define AUTOTUNE
+
+// When defined, the controller states are saved at the end of each sample and
+// restored after a watchdog, brown-out or software reset (see Snapshot.h)
+// #define WARM_RESTART
+
+// A table generated from the nominal model alone has the same gains at every
+// speed, which would schedule nothing
+#if defined(GAIN_SCHEDULING) && !defined(ONLINE_IDENTIFICATION) && \
+    GAIN_SCHEDULE_MODELS < 2
+#error "GAIN_SCHEDULING needs a table generated from models at several speeds, or ONLINE_IDENTIFICATION"
+#endif
+
+// Only one algorithm can calculate the velocity control signal
+#if defined(EXPLICIT_MPC) + defined(GAIN_SCHEDULING) + defined(EVENT_TRIGGERED) > 1
+#error "Only one of EXPLICIT_MPC, GAIN_SCHEDULING and EVENT_TRIGGERED can be defined"
+#endif
+
+// The schedule would replace the gains found by the autotuner in the first
+// sample after it hands over
+#if defined(GAIN_SCHEDULING) && defined(AUTOTUNE)
+#error "GAIN_SCHEDULING cannot be used with AUTOTUNE"
+#endif
+
+// Memory location of the commanded velocity, which is written by the main loop
+// or the position controller
+#ifdef SETPOINT_TRAJECTORY
+#define VELOCITY_COMMAND commandReg
+#else
+#define VELOCITY_COMMAND setpointReg
+#endif
+
+// Memory location of the feedback of the velocity controller
+#ifdef SMITH_PREDICTOR
+#define VELOCITY_FEEDBACK predictedFeedbackReg
+#else
+#define VELOCITY_FEEDBACK feedbackReg
+#endif
+
 static void setupGPIO(void);
 static void setupPWM(void);
 static void setupQEI(void);
 
 static void qei_isr(void);
 
+static bool runControllers(void);
+
 volatile float setpointReg, feedbackReg, controlReg;
 
 struct pidController *pid;
+
+#ifdef EXPLICIT_MPC
+struct mpcController *mpc;
+#endif
+
+#ifdef GAIN_SCHEDULING
+struct gainSchedule *schedule;
+#endif
+
+#ifdef EVENT_TRIGGERED
+struct eventTrigger *eventTrigger;
+#endif
+
+#ifdef CASCADED_POSITION_CONTROL
+volatile float positionSetpointReg, positionFeedbackReg;
+
+struct pidController *positionPid;
+struct positionLoop *positionLoop;
+#endif
+
+#ifdef SETPOINT_TRAJECTORY
+volatile float commandReg;
+
+struct trajectory *trajectory;
+#endif
+
+#ifdef ONLINE_IDENTIFICATION
+struct rlsEstimator *rls;
+#endif
+
+#ifdef AUTOTUNE
+volatile float autotuneSetpointReg;
+
+struct autotuner *autotuner;
+struct pidParameters *autotuneParams;
+bool autotuneHandedOver;
+#endif
+
+#ifdef SMITH_PREDICTOR
+volatile float predictedFeedbackReg;
+
+struct smithPredictor *smith;
+#endif
+
+#ifdef OVERSAMPLE_FEEDBACK
+struct cicDecimator *decimator;
+#endif
+
+#ifdef FILTER_FEEDBACK
+static const struct biquadCoefficients feedbackFilterCoeffs[] = FEEDBACK_FILTER_COEFFS;
+
+struct biquadFilter *feedbackFilter;
+#endif
+
+#ifdef WARM_RESTART
+// Not cleared at reset
+static struct snapshotStore snapshotStore SNAPSHOT_NOINIT;
+
+struct pidController *snapshotControllers[SNAPSHOT_MAX_CONTROLLERS];
+uint32_t numSnapshotControllers;
+#endif
+
 struct Encoder *encoder;
 
 int main(void) {
@@ -40,28 +205,136 @@ int main(void) {
     enableFPU();
 
     // PID Controller initialisation
-    struct pidController _pid = {
-        .kp = KP, .ki = KI, .kd = KD,
-        .setWeightB = SW_B, .setWeightC = SW_C,
-        .filterCoeff = N,
-        .sampleTime = TS, .sampleFreq = FS,
-        .outputMin = OUTPUT_MIN, .outputMax = OUTPUT_MAX,
-
-        .intCoeff = INT_COEFF,
-        .derCoeff1 = DER_COEFF1, .derCoeff2 = DER_COEFF2,
-        
-        .setpoint = &setpointReg,
-        .feedback = &feedbackReg,
-        .controlSignal = &controlReg,
-
-        .integrator = ZERO,
-        .differentiator = ZERO,
-        .prevError = ZERO
-    };
+    struct pidController _pid;
+    struct pidParameters params = PID_DEFAULT_PARAMETERS;
+#ifdef MODEL_FEEDFORWARD
+    params.kp = FF_KP;
+    params.ki = FF_KI;
+    params.feedforwardGain = FEEDFORWARD_GAIN;
+#endif
+#ifdef SMITH_PREDICTOR
+    params.kp *= SMITH_GAIN_SCALE;
+    params.ki *= SMITH_GAIN_SCALE;
+#endif
+    pidInit(&_pid, &params, &setpointReg, &VELOCITY_FEEDBACK, &controlReg);
 
     setpointReg = 10.0f;
     pid = &_pid;
 
+#ifdef EXPLICIT_MPC
+    struct mpcController _mpc;
+    mpcInit(&_mpc, &setpointReg, &feedbackReg, &controlReg);
+    mpc = &_mpc;
+#endif
+
+#ifdef GAIN_SCHEDULING
+    // The setpoint is used rather than the feedback as it is free of
+    // measurement noise
+    struct gainSchedule _schedule;
+    gainScheduleInit(&_schedule, pid, &setpointReg);
+    schedule = &_schedule;
+#endif
+
+#ifdef EVENT_TRIGGERED
+    struct eventTrigger _eventTrigger;
+    eventTriggerInit(&_eventTrigger, pid, EVENT_THRESHOLD, EVENT_OUTPUT_THRESHOLD,
+                     EVENT_MAX_SKIP);
+    eventTrigger = &_eventTrigger;
+#endif
+
+#ifdef CASCADED_POSITION_CONTROL
+    // The position controller output is the setpoint of the velocity controller
+    struct pidController _positionPid;
+    struct pidParameters positionParams = PID_POSITION_PARAMETERS;
+    pidInit(&_positionPid, &positionParams, &positionSetpointReg,
+            &positionFeedbackReg, &VELOCITY_COMMAND);
+
+    struct positionLoop _positionLoop;
+    positionLoopInit(&_positionLoop, &_positionPid, POSITION_LOOP_DIVIDER);
+
+    setpointReg = ZERO;
+    positionSetpointReg = ZERO;
+    positionPid = &_positionPid;
+    positionLoop = &_positionLoop;
+#endif
+
+#ifdef SETPOINT_TRAJECTORY
+    // The trajectory starts at the initial setpoint
+    struct trajectory _trajectory;
+    commandReg = setpointReg;
+    trajectoryInit(&_trajectory, TRAJECTORY_SCURVE,
+                   TRAJECTORY_RATE_INCREMENT(TRAJ_MAX_ACCEL, FS),
+                   TRAJECTORY_JERK_INCREMENT(TRAJ_MAX_JERK, FS),
+                   &commandReg, &setpointReg);
+
+    trajectory = &_trajectory;
+#endif
+
+#ifdef ONLINE_IDENTIFICATION
+    // Identification starts from the nominal model
+    struct rlsEstimator _rls;
+    rlsInit(&_rls, DC_GAIN, TIME_CONSTANT, FS, RLS_FORGETTING);
+    rls = &_rls;
+
+    uint32_t nextRetune = RLS_RETUNE_SAMPLES;
+#endif
+
+#ifdef AUTOTUNE
+    // The relay starts from the voltage the motor model predicts for the
+    // setpoint and corrects it during the experiment
+    struct autotuner _autotuner;
+    autotuneSetpointReg = AUTOTUNE_SETPOINT;
+    autotuneInit(&_autotuner, AUTOTUNE_AMPLITUDE, AUTOTUNE_HYSTERESIS,
+                 AUTOTUNE_SETPOINT * FEEDFORWARD_GAIN, OUTPUT_MIN, OUTPUT_MAX,
+                 AUTOTUNE_TIMEOUT, &autotuneSetpointReg, &feedbackReg, &controlReg);
+    autotuner = &_autotuner;
+
+    // The tuned gains replace those of the controller
+    struct pidParameters _autotuneParams = params;
+    autotuneParams = &_autotuneParams;
+    autotuneHandedOver = false;
+#endif
+
+#ifdef SMITH_PREDICTOR
+    // The motor starts at rest
+    struct smithPredictor _smith;
+    smithInit(&_smith, DC_GAIN, TIME_CONSTANT, FS, SMITH_DELAY,
+              &feedbackReg, &predictedFeedbackReg, &controlReg);
+    smith = &_smith;
+#endif
+
+#ifdef OVERSAMPLE_FEEDBACK
+    struct cicDecimator _decimator;
+    cicInit(&_decimator, CIC_ORDER, QEI_OVERSAMPLE);
+    decimator = &_decimator;
+#endif
+
+#ifdef FILTER_FEEDBACK
+    // The motor starts at rest
+    struct biquadFilter _feedbackFilter;
+    biquadInit(&_feedbackFilter, feedbackFilterCoeffs, FEEDBACK_FILTER_SECTIONS, ZERO);
+    feedbackFilter = &_feedbackFilter;
+#endif
+
+#ifdef WARM_RESTART
+    // Restore the controller states before the first interrupt. The SRAM is
+    // only kept by a reset which does not remove power, and a reset from the
+    // debugger or reset pin is treated as a fresh start.
+    snapshotControllers[numSnapshotControllers++] = pid;
+#ifdef CASCADED_POSITION_CONTROL
+    snapshotControllers[numSnapshotControllers++] = positionPid;
+#endif
+
+    uint32_t resetCause = SysCtlResetCauseGet();
+    SysCtlResetCauseClear(resetCause);
+
+    if (resetCause & (SYSCTL_CAUSE_WDOG0 | SYSCTL_CAUSE_WDOG1 | SYSCTL_CAUSE_BOR
+                      | SYSCTL_CAUSE_SW))
+        snapshotRestore(&snapshotStore, snapshotControllers, numSnapshotControllers);
+    else
+        snapshotClear(&snapshotStore);
+#endif
+
     struct Encoder _encoder = {
         .pulsesPerRev = 1366,
         .hasIndexSignal = false,
@@ -74,14 +347,51 @@ int main(void) {
     setupPWM();
     setupQEI();
 
+#ifdef CASCADED_POSITION_CONTROL
+    qeiCalibratePosition(QEI1, ZERO);
+#endif
 
     // Pin 7 on port A will determine the setpoint of the controller which can
-    // be used for measuring the step response of the system.
+    // be used for measuring the step response of the system. It selects a
+    // speed of 10 or 20 rpm, or with CASCADED_POSITION_CONTROL an angle of 0
+    // or 90 degrees.
     while (true) {
+#ifdef CASCADED_POSITION_CONTROL
         if (GPIOPinRead(GPIO_PORTA_BASE, GPIO_PIN_7))
-            setpointReg = 20;
+            positionSetpointReg = 90;
         else
-            setpointReg = 10;
+            positionSetpointReg = 0;
+#else
+        if (GPIOPinRead(GPIO_PORTA_BASE, GPIO_PIN_7))
+            VELOCITY_COMMAND = 20;
+        else
+            VELOCITY_COMMAND = 10;
+#endif
+
+#ifdef ONLINE_IDENTIFICATION
+        // Recalculate the velocity gains from the latest model. The new gains
+        // are swapped in by the interrupt at the start of its next sample.
+        if ((int32_t)(rls->samples - nextRetune) >= 0) {
+            nextRetune += RLS_RETUNE_SAMPLES;
+
+            float dcGain, timeConstant;
+            struct pidParameters tuned;
+            if (rlsGetModel(rls, FS, &dcGain, &timeConstant) &&
+                rlsTunePid(&params, DC_GAIN, TIME_CONSTANT, dcGain, timeConstant,
+                           &tuned)) {
+#ifdef MODEL_FEEDFORWARD
+                tuned.feedforwardGain = 1.0f / dcGain;
+#endif
+#ifdef GAIN_SCHEDULING
+                // The schedule replaces the gains each sample, so they go to
+                // the breakpoint nearest the speed the model was identified
+                // at. The other parameters are still retuned below.
+                gainScheduleRetune(schedule, feedbackReg, &tuned);
+#endif
+                pidRetune(pid, &tuned);
+            }
+        }
+#endif
     }
     
     return 0;
@@ -110,7 +420,11 @@ static void setupPWM(void) {
 
 static void setupQEI(void) {
     qeiConfigureForEncoder(QEI1, *encoder);
+#ifdef OVERSAMPLE_FEEDBACK
+    qeiConfigureVelocityCapture(QEI1, QEI_DIVIDE_1, hzToKhz(FS * QEI_OVERSAMPLE));
+#else
     qeiConfigureVelocityCapture(QEI1, QEI_DIVIDE_1, hzToKhz(FS));
+#endif
     qeiInterruptVelocity(QEI1, qei_isr);
     // QEI1_CTL_R |= QEI_CTL_STALLEN;  // Stop quadrature module when at a
     // breakpoint when debugging
@@ -121,22 +435,107 @@ static void qei_isr(void) {
     // Clear velocity timer interrupt flag
     QEIIntClear(QEI1_BASE, QEI_INTTIMER);
 
+#ifdef OVERSAMPLE_FEEDBACK
+    // Only every QEI_OVERSAMPLE'th interrupt is a control sample. The other
+    // interrupts only add their tick count to the decimator, so they are not
+    // shown on the timing pin.
+    if (!runCicDecimator(decimator, qeiGetVelocityTicks(QEI1)))
+        return;
+#endif
+
     // Toggle timing pin to indicate calculation process has started
     GPIOPinWrite(GPIO_PORTA_BASE, GPIO_PIN_6, GPIO_PIN_6);
 
     // Receive feedback from quadrature module
+#ifdef OVERSAMPLE_FEEDBACK
+    rpm speed = qeiTicksToSpeed(QEI1, cicOutput(decimator));
+#else
     struct AngularVel velocity = qeiGetVelocity(QEI1);
-    feedbackReg = velocity.speed * velocity.direction;
+    rpm speed = velocity.speed * velocity.direction;
+#endif
 
-    // Calculate new PID control output
-    runControlAlgorithm(pid);
+#ifdef FILTER_FEEDBACK
+    feedbackReg = runBiquadFilter(feedbackFilter, speed);
+#else
+    feedbackReg = speed;
+#endif
+
+#ifdef ONLINE_IDENTIFICATION
+    // controlReg still holds the output applied over the last sample
+    rlsUpdate(rls, controlReg, feedbackReg);
+#endif
+
+#ifdef SMITH_PREDICTOR
+    smithPredict(smith);
+#endif
+
+#ifdef AUTOTUNE
+    // The relay drives the motor until the experiment finishes. The controller
+    // then takes over from the bias with the tuned gains, or with the gains in
+    // ControllerParameters.h if the experiment failed.
+    bool updated = true;
+    if (autotuner->state == AUTOTUNE_RUNNING) {
+        runAutotune(autotuner);
+    } else {
+        if (!autotuneHandedOver) {
+            autotuneHandover(autotuner, AUTOTUNE_RULE, FS, autotuneParams, pid);
+            autotuneHandedOver = true;
+        }
+        updated = runControllers();
+    }
+#else
+    bool updated = runControllers();
+#endif
+
+#ifdef SMITH_PREDICTOR
+    // The model follows the control signal applied, including the relay
+    smithUpdate(smith);
+#endif
 
     // Map output to 1.0-2.0ms pulse length where 1.5ms is neutral
-    // Assumes PID output max and min values have the same magnitude
-    percent duty = controlReg / pid->outputMax * 100.0f / 20.0f + 15.0f;
-    pwmSetDutyCycle(PWM00_B6, duty);
+    // Assumes PID output max and min values have the same magnitude. The PWM
+    // is left alone when the control output has not changed.
+    if (updated) {
+        percent duty = controlReg / pidActiveCoefficients(pid)->outputMax * 100.0f / 20.0f + 15.0f;
+        pwmSetDutyCycle(PWM00_B6, duty);
+    }
+
+#ifdef WARM_RESTART
+    snapshotSave(&snapshotStore, snapshotControllers, numSnapshotControllers);
+#endif
 
     // Toggle timing pin to indicate end of calculation process
     GPIOPinWrite(GPIO_PORTA_BASE, GPIO_PIN_6, 0x00);
 
 }
+
+// Run the position, trajectory and velocity controllers for one sample. Returns
+// false if the velocity controller held its previous output.
+static bool runControllers(void) {
+    bool updated = true;
+
+#ifdef CASCADED_POSITION_CONTROL
+    // Run the position loop at a fraction of the velocity loop rate. It runs
+    // first so the velocity loop uses the new setpoint in the same sample.
+    runPositionLoop(positionLoop, qeiGetPosition(QEI1));
+#endif
+
+#ifdef SETPOINT_TRAJECTORY
+    // Move the setpoint towards the commanded velocity
+    runTrajectory(trajectory);
+#endif
+
+    // Calculate new PID control output
+#ifdef EXPLICIT_MPC
+    runMpcAlgorithm(mpc);
+#elif defined(GAIN_SCHEDULING)
+    runGainScheduledAlgorithm(schedule);
+#elif defined(EVENT_TRIGGERED)
+    updated = runEventTriggeredAlgorithm(eventTrigger);
+#else
+    runControlAlgorithm(pid);
+#endif
+
+    return updated;
+}
+
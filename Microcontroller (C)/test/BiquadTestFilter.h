@@ -0,0 +1,32 @@
+/*
+ * BiquadTestFilter.h
+ *
+ * Cascaded biquad filter coefficients for Biquad.h, generated by
+ * Scripts/generate_biquad.py. Do not edit this file by hand.
+ *
+ * Sample frequency: 50 Hz
+ * Butterworth low-pass, 5 Hz, order 4
+ * Notch, 20 Hz, Q = 2
+ */
+
+#ifndef BIQUAD_TEST_FILTER_H
+#define BIQUAD_TEST_FILTER_H
+
+#include "fix_t.h"
+
+#define BIQUAD_TEST_FILTER_SECTIONS 3
+
+// Each section is { b0, b1, b2, a1, a2 }
+#define BIQUAD_TEST_FILTER_COEFFS { \
+        { 0.0618851953f, 0.123770391f, 0.0618851953f, -1.04859958f, 0.296140358f }, \
+        { 0.0779563405f, 0.155912681f, 0.0779563405f, -1.32091343f, 0.632738793f }, \
+        { 0.871880391f, 1.41073211f, 0.871880391f, 1.41073211f, 0.743760782f } \
+    }
+
+#define BIQUAD_TEST_FILTER_FIX_COEFFS { \
+        { FIX_POINT(0.0618851953), FIX_POINT(0.123770391), FIX_POINT(0.0618851953), FIX_POINT(-1.04859958), FIX_POINT(0.296140358) }, \
+        { FIX_POINT(0.0779563405), FIX_POINT(0.155912681), FIX_POINT(0.0779563405), FIX_POINT(-1.32091343), FIX_POINT(0.632738793) }, \
+        { FIX_POINT(0.871880391), FIX_POINT(1.41073211), FIX_POINT(0.871880391), FIX_POINT(1.41073211), FIX_POINT(0.743760782) } \
+    }
+
+#endif
@@ -0,0 +1,114 @@
+/* antiWindupBenchmark.c
+ *
+ * Host benchmark comparing how quickly the velocity controller recovers from
+ * saturation with each anti-windup method.
+ *
+ * The simulated motor is commanded to a speed it cannot reach at the maximum
+ * control signal, so the output saturates and the integrator winds up (when
+ * nothing prevents it). The setpoint is then dropped to a reachable speed and
+ * the time taken for the output to leave saturation and for the speed to
+ * settle within 2% of the new setpoint are reported, along with the overshoot.
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "PIDController.h"
+#include "Motor.h"
+
+#include "MotorParameters.h"
+#include "ControllerParameters.h"
+
+#define ZERO 0.0f
+
+// The motor reaches DC_GAIN * OUTPUT_MAX (about 286 rpm) at most
+#define UNREACHABLE_SETPOINT    400.0f
+#define FINAL_SETPOINT          100.0f
+
+#define SATURATED_SAMPLES       (2 * (int)FS)
+#define RECOVERY_SAMPLES        (10 * (int)FS)
+
+#define SETTLING_BAND           0.02f
+
+struct recovery {
+    float desaturationTime;
+    float settlingTime;
+    float overshoot;
+};
+
+volatile float setpointReg, feedbackReg, controlReg;
+
+static struct recovery measureRecovery(enum pidAntiWindup antiWindup);
+static void printRecovery(const char *name, struct recovery recovery);
+
+int main(void) {
+    printf("                   leave saturation (s)  settling (s)  overshoot (%%)\n");
+    printRecovery("none", measureRecovery(PID_ANTI_WINDUP_NONE));
+    printRecovery("back-calculation", measureRecovery(PID_ANTI_WINDUP_BACK_CALCULATION));
+    printRecovery("conditional", measureRecovery(PID_ANTI_WINDUP_CONDITIONAL));
+
+    return EXIT_SUCCESS;
+}
+
+static struct recovery measureRecovery(enum pidAntiWindup antiWindup) {
+    struct pidController pid;
+    struct pidParameters params = PID_DEFAULT_PARAMETERS;
+    params.antiWindup = antiWindup;
+    pidInit(&pid, &params, &setpointReg, &feedbackReg, &controlReg);
+
+    struct motor motor = {
+        .dcGain = DC_GAIN,
+        .timeConstant = TIME_CONSTANT,
+        .angularVelocity = ZERO,
+        .coeffV = COEFF_V,
+        .coeffW = COEFF_W
+    };
+
+    setpointReg = UNREACHABLE_SETPOINT;
+    for (int i = 0; i < SATURATED_SAMPLES; i++) {
+        feedbackReg = motor.angularVelocity;
+        runControlAlgorithm(&pid);
+        calculateAngularVelocity(&motor, controlReg);
+    }
+
+    int desaturated = -1, lastOutsideBand = -1;
+    float lowest = motor.angularVelocity;
+
+    // The speed falls towards the new setpoint, so overshoot is below it
+    setpointReg = FINAL_SETPOINT;
+    for (int i = 0; i < RECOVERY_SAMPLES; i++) {
+        feedbackReg = motor.angularVelocity;
+        runControlAlgorithm(&pid);
+        calculateAngularVelocity(&motor, controlReg);
+
+        if (desaturated < 0 && controlReg < OUTPUT_MAX && controlReg > OUTPUT_MIN)
+            desaturated = i;
+        if (fabsf(motor.angularVelocity - FINAL_SETPOINT) > SETTLING_BAND * FINAL_SETPOINT)
+            lastOutsideBand = i;
+        if (motor.angularVelocity < lowest)
+            lowest = motor.angularVelocity;
+    }
+
+    struct recovery recovery = {
+        .desaturationTime = (desaturated >= 0) ? desaturated * TS : NAN,
+        .settlingTime = (lastOutsideBand < RECOVERY_SAMPLES - 1)
+                      ? (lastOutsideBand + 1) * TS : NAN,
+        .overshoot = (FINAL_SETPOINT - lowest) / FINAL_SETPOINT * 100.0f
+    };
+
+    if (recovery.overshoot < ZERO)
+        recovery.overshoot = ZERO;
+
+    return recovery;
+}
+
+static void printRecovery(const char *name, struct recovery recovery) {
+    printf("%-17s  %20.2f  %12.2f  %13.1f\n", name, recovery.desaturationTime,
+           recovery.settlingTime, recovery.overshoot);
+}
@@ -0,0 +1,268 @@
+/* autotuneTest.c
+ * Tests for the relay feedback autotuner.
+ *
+ * The simulated motor is extended with a delay of a few samples, as the relay
+ * needs phase lag beyond that of the first-order model to oscillate at a
+ * useful frequency. The ultimate gain and period found by the relay experiment
+ * are compared with the exact values for the delayed discrete model, then the
+ * calculated gains are run in closed loop with the same motor. The controller
+ * must take over from the relay without a step in the control signal.
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team.
+ */
+
+#include "Autotune.h"
+#include "PIDController.h"
+#include "Motor.h"
+
+#include "MotorParameters.h"
+#include "ControllerParameters.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Delay of the simulated motor in samples
+#define DELAY_SAMPLES   2
+
+#define NUM_SAMPLES     1000
+
+// Relay experiment
+#define SETPOINT        15.0f
+#define AMPLITUDE       2.0f
+#define HYSTERESIS      0.1f
+
+// Largest relative errors of the describing function approximation. The
+// period is measured in whole samples.
+#define GAIN_TOLERANCE      0.1
+#define PERIOD_TOLERANCE    0.1
+
+// Largest relative error of the corrected bias
+#define BIAS_TOLERANCE      0.1f
+
+// Largest change in the control signal at the handover (in V)
+#define HANDOVER_TOLERANCE  1E-4f
+
+// Simulated motor parameters without the delay
+#define NOMINAL_MOTOR {                                                         \
+        .dcGain = DC_GAIN, .timeConstant = TIME_CONSTANT,                       \
+        .angularVelocity = 0.0f, .coeffV = COEFF_V, .coeffW = COEFF_W           \
+    }
+
+volatile float setpointReg, feedbackReg, controlReg;
+
+struct delayedMotor {
+    struct motor motor;
+    float delayLine[DELAY_SAMPLES];
+    uint32_t index;
+};
+
+static void test_ultimatePoint(void);
+static void test_handover(void);
+static void test_closedLoop(void);
+static void test_timeout(void);
+
+static void runExperiment(struct autotuner *tuner, struct delayedMotor *plant,
+                          uint32_t maxSamples);
+static float stepDelayedMotor(struct delayedMotor *plant, float voltage);
+static void exactUltimatePoint(double *gain, double *period);
+
+int main(void) {
+    printf("Testing ultimate gain and period ... ");
+    test_ultimatePoint();
+    printf("Done!\n");
+
+    printf("Testing handover ... ");
+    test_handover();
+    printf("Done!\n");
+
+    printf("Testing closed loop with tuned gains ... ");
+    test_closedLoop();
+    printf("Done!\n");
+
+    printf("Testing timeout ... ");
+    test_timeout();
+    printf("Done!\n");
+
+    printf("\nAll tests completed successfully!\n\n");
+
+    return EXIT_SUCCESS;
+}
+
+static void test_ultimatePoint(void) {
+    struct autotuner tuner;
+    struct delayedMotor plant = { .motor = NOMINAL_MOTOR };
+    runExperiment(&tuner, &plant, 10 * NUM_SAMPLES);
+
+    assert(tuner.state == AUTOTUNE_DONE);
+
+    double gain, period;
+    exactUltimatePoint(&gain, &period);
+
+    printf("\n  Ku = %.4f (exact %.4f), Tu = %.2f samples (exact %.2f), done after %u samples\n  ",
+           tuner.ultimateGain, gain, tuner.ultimatePeriod, period, (unsigned)tuner.samples);
+
+    assert(fabs(tuner.ultimateGain / gain - 1.0) < GAIN_TOLERANCE);
+    assert(fabs(tuner.ultimatePeriod / period - 1.0) < PERIOD_TOLERANCE);
+
+    // The bias has been corrected to the voltage which holds the setpoint
+    assert(fabsf(tuner.bias - SETPOINT / DC_GAIN) < BIAS_TOLERANCE * SETPOINT / DC_GAIN);
+}
+
+static void test_handover(void) {
+    const enum autotuneRule rules[] = {
+        AUTOTUNE_ZIEGLER_NICHOLS_PI,
+        AUTOTUNE_ZIEGLER_NICHOLS_PID,
+        AUTOTUNE_TYREUS_LUYBEN_PI
+    };
+
+    for (size_t r = 0; r < sizeof(rules) / sizeof(rules[0]); r++) {
+        struct autotuner tuner;
+        struct delayedMotor plant = { .motor = NOMINAL_MOTOR };
+        runExperiment(&tuner, &plant, 10 * NUM_SAMPLES);
+
+        // The controller starts with the default gains and feedforward, as in
+        // system.c
+        struct pidParameters params = PID_DEFAULT_PARAMETERS;
+        params.feedforwardGain = 1.0f / DC_GAIN;
+        struct pidController pid;
+        pidInit(&pid, &params, &setpointReg, &feedbackReg, &controlReg);
+
+        float bias = controlReg;
+        assert(bias == tuner.bias);
+
+        feedbackReg = plant.motor.angularVelocity;
+        assert(autotuneHandover(&tuner, rules[r], FS, &params, &pid));
+        runControlAlgorithm(&pid);
+
+        // The tuned gains are used from the first sample, which continues
+        // from the bias
+        assert(pidActiveCoefficients(&pid)->kp == params.kp);
+        assert(fabsf(controlReg - bias) < HANDOVER_TOLERANCE);
+
+        // The speed stays at the setpoint
+        for (int i = 0; i < NUM_SAMPLES; i++) {
+            stepDelayedMotor(&plant, controlReg);
+            feedbackReg = plant.motor.angularVelocity;
+            runControlAlgorithm(&pid);
+        }
+
+        assert(fabsf(plant.motor.angularVelocity - SETPOINT) < 0.01f * SETPOINT);
+    }
+}
+
+static void test_closedLoop(void) {
+    const enum autotuneRule rules[] = {
+        AUTOTUNE_ZIEGLER_NICHOLS_PI,
+        AUTOTUNE_ZIEGLER_NICHOLS_PID,
+        AUTOTUNE_TYREUS_LUYBEN_PI
+    };
+
+    struct autotuner tuner;
+    struct delayedMotor plant = { .motor = NOMINAL_MOTOR };
+    runExperiment(&tuner, &plant, 10 * NUM_SAMPLES);
+
+    for (size_t r = 0; r < sizeof(rules) / sizeof(rules[0]); r++) {
+        struct pidParameters params = PID_DEFAULT_PARAMETERS;
+        assert(autotuneParameters(&tuner, rules[r], FS, &params));
+
+        // Only the gains change
+        assert(params.outputMax == OUTPUT_MAX && params.sampleFreq == FS);
+        assert(params.kp > 0.0f && params.ki > 0.0f);
+        assert((params.kd > 0.0f) == (rules[r] == AUTOTUNE_ZIEGLER_NICHOLS_PID));
+
+        // Start the controller with the tuned gains, then step the setpoint
+        struct pidController pid;
+        pidInit(&pid, &params, &setpointReg, &feedbackReg, &controlReg);
+
+        setpointReg = 2.0f * SETPOINT;
+        for (int i = 0; i < NUM_SAMPLES; i++) {
+            feedbackReg = plant.motor.angularVelocity;
+            runControlAlgorithm(&pid);
+            stepDelayedMotor(&plant, controlReg);
+        }
+
+        assert(fabsf(plant.motor.angularVelocity - setpointReg) < 0.01f * setpointReg);
+    }
+}
+
+static void test_timeout(void) {
+    // A motor which is not connected never reaches the setpoint
+    struct delayedMotor plant = {
+        .motor = {
+            .dcGain = 0.0f, .timeConstant = TIME_CONSTANT,
+            .angularVelocity = 0.0f, .coeffV = 0.0f, .coeffW = COEFF_W
+        }
+    };
+
+    struct autotuner tuner;
+    runExperiment(&tuner, &plant, NUM_SAMPLES);
+
+    assert(tuner.state == AUTOTUNE_FAILED);
+    assert(tuner.samples == NUM_SAMPLES);
+
+    struct pidParameters params = PID_DEFAULT_PARAMETERS;
+    assert(!autotuneParameters(&tuner, AUTOTUNE_ZIEGLER_NICHOLS_PI, FS, &params));
+    assert(params.kp == KP && params.ki == KI);
+
+    // The controller keeps its gains but still takes over from the bias
+    struct pidController pid;
+    pidInit(&pid, &params, &setpointReg, &feedbackReg, &controlReg);
+    assert(!autotuneHandover(&tuner, AUTOTUNE_ZIEGLER_NICHOLS_PI, FS, &params, &pid));
+    assert(pidActiveCoefficients(&pid)->kp == KP);
+
+    feedbackReg = plant.motor.angularVelocity;
+    runControlAlgorithm(&pid);
+    assert(fabsf(controlReg - tuner.bias) < HANDOVER_TOLERANCE);
+}
+
+// Run the relay experiment as in system.c until it finishes, starting with no
+// bias
+static void runExperiment(struct autotuner *tuner, struct delayedMotor *plant,
+                          uint32_t maxSamples) {
+    setpointReg = SETPOINT;
+
+    autotuneInit(tuner, AMPLITUDE, HYSTERESIS, 0.0f, OUTPUT_MIN, OUTPUT_MAX,
+                 maxSamples, &setpointReg, &feedbackReg, &controlReg);
+
+    while (tuner->state == AUTOTUNE_RUNNING) {
+        feedbackReg = plant->motor.angularVelocity;
+        runAutotune(tuner);
+        stepDelayedMotor(plant, controlReg);
+    }
+}
+
+// The voltage reaches the motor DELAY_SAMPLES samples after it is calculated
+static float stepDelayedMotor(struct delayedMotor *plant, float voltage) {
+    float delayed = plant->delayLine[plant->index];
+    plant->delayLine[plant->index] = voltage;
+    plant->index = (plant->index + 1) % DELAY_SAMPLES;
+
+    return calculateAngularVelocity(&plant->motor, delayed);
+}
+
+// The delayed motor is G(z) = b z^-d / (z - a) in a loop where the speed is
+// measured one sample after the voltage is applied. Find the frequency where
+// its phase reaches -180 degrees by bisection.
+static void exactUltimatePoint(double *gain, double *period) {
+    const double a = COEFF_W, b = COEFF_V;
+    const double pi = acos(-1.0);
+
+    double low = 1E-6, high = pi;
+    for (int i = 0; i < 100; i++) {
+        double theta = 0.5 * (low + high);
+        double phase = -DELAY_SAMPLES * theta - atan2(sin(theta), cos(theta) - a);
+        if (phase > -pi)
+            low = theta;
+        else
+            high = theta;
+    }
+
+    double theta = 0.5 * (low + high);
+    *gain = hypot(cos(theta) - a, sin(theta)) / b;
+    *period = 2.0 * pi / theta;
+}
@@ -0,0 +1,50 @@
+/* benchmark.h
+ *
+ * Timing helpers for benchmark programs which run on the development machine
+ * rather than the microcontroller.
+ *
+ * Where available the x86 time stamp counter is used so that results are
+ * given in CPU cycles. Otherwise the monotonic clock is used and results are
+ * given in nanoseconds.
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdint.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_UNIT "cycles"
+#else
+#define BENCH_UNIT "ns"
+#endif
+
+// Obtain the current value of the benchmark timer
+static inline uint64_t benchTime(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+#endif
+}
+
+// Obtain the current value of the monotonic clock in seconds, for measuring
+// throughput in operations per second.
+static inline double benchSeconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec * 1E-9;
+}
+
+#endif
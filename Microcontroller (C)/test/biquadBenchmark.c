@@ -0,0 +1,230 @@
+/* biquadBenchmark.c
+ * Tests and benchmarks for the cascaded biquad filters.
+ *
+ * The frequency response of a test filter (BiquadTestFilter.h, a fourth order
+ * 5 Hz low-pass and a 20 Hz notch at 50 Hz) is measured with sine waves, and
+ * the fixed point filter is compared with the floating point filter. The
+ * feedback filter is then applied to a quantised speed measurement to show the
+ * reduction in the noise seen by the derivative term. Finally the cost of each
+ * section is measured.
+ *
+ * Regenerate BiquadTestFilter.h with:
+ *      python3 Scripts/generate_biquad.py --name BiquadTestFilter --lowpass 5 4
+ *          --notch 20 2 --fs 50 --output "Microcontroller (C)/test/BiquadTestFilter.h"
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team.
+ */
+
+#include "benchmark.h"
+
+#include "Biquad.h"
+#include "BiquadTestFilter.h"
+#include "FeedbackFilter.h"
+
+#include "ControllerParameters.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define NUM_SAMPLES     1000
+#define NUM_REPEATS     200
+
+#define PI              3.14159265358979
+
+// Sample frequency of the test filter
+#define TEST_FS         50.0
+
+// Speed resolution of one encoder tick at FS with the encoder in system.c
+#define SPEED_RESOLUTION    (60.0 * FS / (2.0 * 1366.0))
+
+static const struct biquadCoefficients testFilter[] = BIQUAD_TEST_FILTER_COEFFS;
+static const struct biquadFixCoefficients testFixFilter[] = BIQUAD_TEST_FILTER_FIX_COEFFS;
+static const struct biquadCoefficients feedbackFilter[] = FEEDBACK_FILTER_COEFFS;
+
+static float inputs[NUM_SAMPLES];
+static fix_t fixInputs[NUM_SAMPLES];
+
+static void test_frequencyResponse(void);
+static void test_initialState(void);
+static void test_fixedPoint(void);
+static void test_quantisedSpeed(void);
+static void measureCycles(void);
+
+static double gainAt(double freq);
+
+int main(void) {
+    printf("Testing frequency response ... ");
+    test_frequencyResponse();
+    printf("Done!\n");
+
+    printf("Testing initial state ... ");
+    test_initialState();
+    printf("Done!\n");
+
+    printf("Testing fixed point filter ... ");
+    test_fixedPoint();
+    printf("Done!\n");
+
+    printf("Testing quantised speed ... ");
+    test_quantisedSpeed();
+    printf("Done!\n");
+
+    printf("\nAll tests completed successfully!\n\n");
+
+    measureCycles();
+
+    return EXIT_SUCCESS;
+}
+
+static void test_frequencyResponse(void) {
+    // DC passes unchanged
+    assert(fabs(gainAt(0.0) - 1.0) < 1E-4);
+
+    // -3 dB at the low-pass cut-off, less the small attenuation of the notch
+    assert(fabs(gainAt(5.0) - sqrt(0.5) * 0.9914) < 0.01);
+
+    // Stop band and notch
+    assert(gainAt(10.0) < 0.05);
+    assert(gainAt(20.0) < 1E-3);
+}
+
+static void test_initialState(void) {
+    struct biquadFilter filter;
+    biquadInit(&filter, testFilter, BIQUAD_TEST_FILTER_SECTIONS, 15.0f);
+
+    // Starting at the current value, a constant input gives a constant output
+    for (int i = 0; i < NUM_SAMPLES; i++)
+        assert(fabsf(runBiquadFilter(&filter, 15.0f) - 15.0f) < 1E-4f);
+
+    struct biquadFixFilter fixFilter;
+    biquadFixInit(&fixFilter, testFixFilter, BIQUAD_TEST_FILTER_SECTIONS, FIX_POINT(15.0));
+
+    for (int i = 0; i < NUM_SAMPLES; i++)
+        assert(fabsf(fix2float(runBiquadFixFilter(&fixFilter, FIX_POINT(15.0))) - 15.0f) < 1E-2f);
+}
+
+static void test_fixedPoint(void) {
+    struct biquadFilter filter;
+    biquadInit(&filter, testFilter, BIQUAD_TEST_FILTER_SECTIONS, 0.0f);
+
+    struct biquadFixFilter fixFilter;
+    biquadFixInit(&fixFilter, testFixFilter, BIQUAD_TEST_FILTER_SECTIONS, 0);
+
+    // Random speeds within the range of the motor
+    srand(1);
+    float largest = 0.0f;
+    for (int i = 0; i < 10 * NUM_SAMPLES; i++) {
+        float input = 300.0f * (2.0f * rand() / RAND_MAX - 1.0f);
+        float output = runBiquadFilter(&filter, input);
+        float fixOutput = fix2float(runBiquadFixFilter(&fixFilter, FIX_POINT(input)));
+
+        if (fabsf(output - fixOutput) > largest)
+            largest = fabsf(output - fixOutput);
+    }
+
+    printf("\n  Largest fixed point error: %.4f rpm\n  ", largest);
+    assert(largest < 0.05f);
+}
+
+static void test_quantisedSpeed(void) {
+    struct biquadFilter filter;
+    biquadInit(&filter, feedbackFilter, FEEDBACK_FILTER_SECTIONS, 15.0f);
+
+    // A slowly varying speed measured in whole encoder ticks
+    double rawPrev = 15.0, filteredPrev = 15.0;
+    double rawNoise = 0.0, filteredNoise = 0.0;
+
+    for (int i = 0; i < NUM_SAMPLES; i++) {
+        double speed = 15.0 + 2.0 * sin(2.0 * PI * 0.5 * i / FS);
+        double raw = SPEED_RESOLUTION * floor(speed / SPEED_RESOLUTION + 0.5);
+        double filtered = runBiquadFilter(&filter, (float)raw);
+
+        // The derivative term acts on the difference between samples
+        rawNoise += (raw - rawPrev) * (raw - rawPrev);
+        filteredNoise += (filtered - filteredPrev) * (filtered - filteredPrev);
+        rawPrev = raw;
+        filteredPrev = filtered;
+    }
+
+    rawNoise = sqrt(rawNoise / NUM_SAMPLES);
+    filteredNoise = sqrt(filteredNoise / NUM_SAMPLES);
+
+    printf("\n  RMS change between samples: %.3f rpm raw, %.3f rpm filtered\n  ",
+           rawNoise, filteredNoise);
+    assert(filteredNoise < 0.75 * rawNoise);
+}
+
+static void measureCycles(void) {
+    // Cascades of up to BIQUAD_MAX_SECTIONS copies of one section
+    struct biquadCoefficients sections[BIQUAD_MAX_SECTIONS];
+    struct biquadFixCoefficients fixSections[BIQUAD_MAX_SECTIONS];
+    for (int i = 0; i < BIQUAD_MAX_SECTIONS; i++) {
+        sections[i] = testFilter[0];
+        fixSections[i] = testFixFilter[0];
+    }
+
+    srand(2);
+    for (int i = 0; i < NUM_SAMPLES; i++) {
+        inputs[i] = 300.0f * (2.0f * rand() / RAND_MAX - 1.0f);
+        fixInputs[i] = FIX_POINT(inputs[i]);
+    }
+
+    printf("Sections  runBiquadFilter  runBiquadFixFilter  (%s/sample)\n", BENCH_UNIT);
+
+    for (uint32_t n = 1; n <= BIQUAD_MAX_SECTIONS; n++) {
+        struct biquadFilter filter;
+        biquadInit(&filter, sections, n, 0.0f);
+
+        struct biquadFixFilter fixFilter;
+        biquadFixInit(&fixFilter, fixSections, n, 0);
+
+        uint64_t floatBest = UINT64_MAX, fixBest = UINT64_MAX;
+        volatile float floatSink;
+        volatile fix_t fixSink;
+
+        for (int r = 0; r < NUM_REPEATS; r++) {
+            uint64_t start = benchTime();
+            for (int i = 0; i < NUM_SAMPLES; i++)
+                floatSink = runBiquadFilter(&filter, inputs[i]);
+            uint64_t elapsed = benchTime() - start;
+            if (elapsed < floatBest)
+                floatBest = elapsed;
+
+            start = benchTime();
+            for (int i = 0; i < NUM_SAMPLES; i++)
+                fixSink = runBiquadFixFilter(&fixFilter, fixInputs[i]);
+            elapsed = benchTime() - start;
+            if (elapsed < fixBest)
+                fixBest = elapsed;
+        }
+
+        (void)floatSink;
+        (void)fixSink;
+
+        printf("%8u  %15.1f  %18.1f\n", (unsigned)n,
+               (double)floatBest / NUM_SAMPLES, (double)fixBest / NUM_SAMPLES);
+    }
+}
+
+// Amplitude of the steady-state response of the test filter to a sine wave
+static double gainAt(double freq) {
+    struct biquadFilter filter;
+    biquadInit(&filter, testFilter, BIQUAD_TEST_FILTER_SECTIONS, 0.0f);
+
+    double peak = 0.0;
+    for (int i = 0; i < 4 * NUM_SAMPLES; i++) {
+        double input = cos(2.0 * PI * freq * i / TEST_FS);
+        double output = runBiquadFilter(&filter, (float)input);
+
+        // Ignore the transient
+        if (i >= 2 * NUM_SAMPLES && fabs(output) > peak)
+            peak = fabs(output);
+    }
+
+    return peak;
+}
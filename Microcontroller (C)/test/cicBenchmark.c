@@ -0,0 +1,271 @@
+/* cicBenchmark.c
+ * Tests and benchmarks for the CIC decimator used to oversample the encoder
+ * velocity.
+ *
+ * The decimator is checked against a direct convolution with its impulse
+ * response, including inputs which make the integrators wrap around. A
+ * simulated encoder is then sampled at QEI_OVERSAMPLE times the control rate
+ * and the decimated speed is compared with the tick count over a whole control
+ * sample, which is what the QEI module measures at FS. Finally the cost of the
+ * decimator per control sample is measured against a PID update.
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team.
+ */
+
+#include "benchmark.h"
+
+#include "CICDecimator.h"
+#include "PIDController.h"
+
+#include "ControllerParameters.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define NUM_SAMPLES     1000
+#define NUM_REPEATS     200
+
+#define PI              3.14159265358979
+
+// Encoder in system.c, with the speed scaling used by qeiGetVelocity()
+#define PULSES_PER_REV  1366
+#define TICKS_PER_REV   (2.0 * PULSES_PER_REV)
+
+// Samples of the simulated encoder, at QEI_OVERSAMPLE * FS
+#define FAST_SAMPLES    (NUM_SAMPLES * QEI_OVERSAMPLE)
+
+volatile float setpointReg, feedbackReg, controlReg;
+
+static int32_t ticks[FAST_SAMPLES];
+
+struct speedError {
+    double rms;                 // RMS error against the true speed
+    double peak;
+};
+
+static void test_impulseResponse(void);
+static void test_constantSpeed(void);
+static void test_varyingSpeed(void);
+static void measureCycles(void);
+
+static void simulateEncoder(double (*speed)(double), double phase);
+static struct speedError measureError(uint32_t order, double (*speed)(double));
+static double constantSpeed(double t);
+static double varyingSpeed(double t);
+
+int main(void) {
+    printf("Testing impulse response ... ");
+    test_impulseResponse();
+    printf("Done!\n");
+
+    printf("Testing constant speed ... ");
+    test_constantSpeed();
+    printf("Done!\n");
+
+    printf("Testing varying speed ... ");
+    test_varyingSpeed();
+    printf("Done!\n");
+
+    printf("\nAll tests completed successfully!\n\n");
+
+    measureCycles();
+
+    return EXIT_SUCCESS;
+}
+
+static void test_impulseResponse(void) {
+    const uint32_t ratio = 5;
+
+    // Large inputs make the integrators of the higher orders wrap around
+    int32_t input[200];
+    srand(1);
+    for (int i = 0; i < 200; i++)
+        input[i] = rand() % 2000001 - 1000000;
+
+    for (uint32_t order = 1; order <= 3; order++) {
+        // Impulse response: order boxcars of length ratio convolved together
+        int32_t response[3 * 4 + 1] = { 1 };
+        uint32_t length = 1;
+        for (uint32_t n = 0; n < order; n++) {
+            int32_t next[3 * 4 + 1] = { 0 };
+            for (uint32_t i = 0; i < length; i++)
+                for (uint32_t j = 0; j < ratio; j++)
+                    next[i + j] += response[i];
+            length += ratio - 1;
+            for (uint32_t i = 0; i < length; i++)
+                response[i] = next[i];
+        }
+
+        struct cicDecimator cic;
+        cicInit(&cic, order, ratio);
+
+        uint32_t outputs = 0;
+        for (int k = 0; k < 200; k++) {
+            bool ready = runCicDecimator(&cic, input[k]);
+            assert(ready == ((k + 1) % ratio == 0));
+            if (!ready)
+                continue;
+
+            int64_t expected = 0;
+            for (uint32_t i = 0; i < length && (int)i <= k; i++)
+                expected += (int64_t)response[i] * input[k - i];
+
+            assert(cic.output == expected);
+            outputs++;
+        }
+        assert(outputs == 200 / ratio);
+    }
+
+    // The output is scaled back to the mean input
+    struct cicDecimator cic;
+    cicInit(&cic, 2, ratio);
+    for (uint32_t k = 0; k < 2 * ratio; k++)
+        runCicDecimator(&cic, 7);
+    assert(cic.output == 7 * 25 && fabsf(cicOutput(&cic) - 7.0f) < 1E-6f);
+}
+
+static void test_constantSpeed(void) {
+    struct speedError single = measureError(1, constantSpeed);
+    struct speedError order2 = measureError(2, constantSpeed);
+    struct speedError order3 = measureError(3, constantSpeed);
+
+    printf("\n  Error at a constant %.2f rpm (RMS / peak):\n", constantSpeed(0));
+    printf("    Order 1 (ticks over FS): %.3f / %.3f rpm\n", single.rms, single.peak);
+    printf("    Order 2:                 %.3f / %.3f rpm\n", order2.rms, order2.peak);
+    printf("    Order 3:                 %.3f / %.3f rpm\n  ", order3.rms, order3.peak);
+
+    // Smoother windows reduce the tick quantisation noise
+    assert(order2.rms < 0.5 * single.rms);
+    assert(order3.rms <= order2.rms);
+    assert(order2.peak < single.peak);
+}
+
+static void test_varyingSpeed(void) {
+    struct speedError single = measureError(1, varyingSpeed);
+    struct speedError order2 = measureError(2, varyingSpeed);
+    struct speedError order3 = measureError(3, varyingSpeed);
+
+    // The error against the instantaneous speed includes the group delay of
+    // the window as well as the quantisation noise
+    printf("\n  Error with a 1 Hz, 5 rpm speed variation (RMS / peak):\n");
+    printf("    Order 1 (ticks over FS): %.3f / %.3f rpm\n", single.rms, single.peak);
+    printf("    Order 2:                 %.3f / %.3f rpm\n", order2.rms, order2.peak);
+    printf("    Order 3:                 %.3f / %.3f rpm\n  ", order3.rms, order3.peak);
+
+    assert(order2.rms < single.rms);
+}
+
+static void measureCycles(void) {
+    struct cicDecimator cic;
+    cicInit(&cic, CIC_ORDER, QEI_OVERSAMPLE);
+
+    struct pidParameters params = PID_DEFAULT_PARAMETERS;
+    struct pidController pid;
+    pidInit(&pid, &params, &setpointReg, &feedbackReg, &controlReg);
+    setpointReg = 15.0f;
+
+    simulateEncoder(varyingSpeed, 0.37);
+
+    uint64_t cicBest = UINT64_MAX, pidBest = UINT64_MAX;
+    float sum = 0.0f;
+
+    for (int r = 0; r < NUM_REPEATS; r++) {
+        uint64_t start = benchTime();
+        for (int k = 0; k < FAST_SAMPLES; k++)
+            if (runCicDecimator(&cic, ticks[k]))
+                sum += cicOutput(&cic);
+        uint64_t elapsed = benchTime() - start;
+        if (elapsed < cicBest)
+            cicBest = elapsed;
+
+        start = benchTime();
+        for (int i = 0; i < NUM_SAMPLES; i++) {
+            feedbackReg = (float)ticks[i];
+            runControlAlgorithm(&pid);
+        }
+        elapsed = benchTime() - start;
+        if (elapsed < pidBest)
+            pidBest = elapsed;
+    }
+
+    // Prevent the decimator output from being optimised away
+    if (sum == 1.0f)
+        printf(" ");
+
+    double cicCost = (double)cicBest / NUM_SAMPLES;
+    double pidCost = (double)pidBest / NUM_SAMPLES;
+
+    printf("Order %d decimator at %d times FS:\n", CIC_ORDER, QEI_OVERSAMPLE);
+    printf("runCicDecimator:     %6.1f %s/input sample\n",
+           cicCost / QEI_OVERSAMPLE, BENCH_UNIT);
+    printf("                     %6.1f %s/control sample\n", cicCost, BENCH_UNIT);
+    printf("runControlAlgorithm: %6.1f %s/control sample\n", pidCost, BENCH_UNIT);
+    printf("On the target each input sample also takes an interrupt entry and exit\n");
+}
+
+// Fill ticks[] with the edges counted in each oversampled period of an encoder
+// turning at speed(t) rpm, starting part way between two edges
+static void simulateEncoder(double (*speed)(double), double phase) {
+    const double dt = 1.0 / (FS * QEI_OVERSAMPLE);
+    const double substeps = 20;
+
+    double position = phase;        // In ticks
+    double previous = floor(position);
+
+    for (int k = 0; k < FAST_SAMPLES; k++) {
+        for (int s = 0; s < substeps; s++) {
+            double t = (k + (s + 0.5) / substeps) * dt;
+            position += speed(t) / 60.0 * TICKS_PER_REV * dt / substeps;
+        }
+
+        double edge = floor(position);
+        ticks[k] = (int32_t)(edge - previous);
+        previous = edge;
+    }
+}
+
+// Decimate the simulated encoder and compare the speed at each control sample
+// with the true speed, ignoring the start-up transient
+static struct speedError measureError(uint32_t order, double (*speed)(double)) {
+    simulateEncoder(speed, 0.37);
+
+    struct cicDecimator cic;
+    cicInit(&cic, order, QEI_OVERSAMPLE);
+
+    // Speed of one tick per oversampled period
+    const double tickSpeed = 60.0 * FS * QEI_OVERSAMPLE / TICKS_PER_REV;
+
+    struct speedError error = { 0.0, 0.0 };
+    int count = 0;
+
+    for (int k = 0; k < FAST_SAMPLES; k++) {
+        if (!runCicDecimator(&cic, ticks[k]) || k < 10 * QEI_OVERSAMPLE)
+            continue;
+
+        double measured = cicOutput(&cic) * tickSpeed;
+        double e = fabs(measured - speed((k + 1) / (FS * QEI_OVERSAMPLE)));
+
+        error.rms += e * e;
+        if (e > error.peak)
+            error.peak = e;
+        count++;
+    }
+
+    error.rms = sqrt(error.rms / count);
+
+    return error;
+}
+
+static double constantSpeed(double t) {
+    (void)t;
+    return 15.3;
+}
+
+static double varyingSpeed(double t) {
+    return 15.0 + 5.0 * sin(2.0 * PI * t);
+}
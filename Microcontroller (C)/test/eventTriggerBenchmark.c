@@ -0,0 +1,343 @@
+/* eventTriggerBenchmark.c
+ * Tests and benchmarks for the event-triggered PID controller.
+ *
+ * The integrator correction is checked against the controller running every
+ * sample, including while the output is clamped. The event-triggered and
+ * periodic controllers are then run with the simulated motor, with the speed
+ * quantised to whole encoder ticks as in qeiGetVelocity(), and the fraction of
+ * samples skipped and the tracking error are reported. Finally the costs of an
+ * update and a skipped sample are measured, and the time saved given by
+ * eventTriggerTimeSaved() is compared with the time measured.
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team.
+ */
+
+#include "benchmark.h"
+
+#include "EventTrigger.h"
+#include "PIDController.h"
+#include "Motor.h"
+
+#include "MotorParameters.h"
+#include "ControllerParameters.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define NUM_SAMPLES     1000
+#define NUM_REPEATS     200
+
+// Samples between setpoint changes (10 s)
+#define STEP_SAMPLES    500
+
+// Speed resolution of one encoder tick at FS with the encoder in system.c
+#define SPEED_RESOLUTION    (60.0f * FS / (2.0f * 1366.0f))
+
+volatile float setpointReg, feedbackReg, controlReg;
+
+static float feedbacks[NUM_SAMPLES];
+
+struct closedLoopResult {
+    float absError;             // Mean absolute error
+    float finalError;           // Largest error over the last second of a step
+    uint32_t updates;
+};
+
+static void test_integratorCorrection(void);
+static void test_saturation(void);
+static void test_closedLoop(void);
+static void measureCycles(void);
+
+static struct closedLoopResult runClosedLoop(bool eventTriggered);
+static float quantise(float speed);
+
+int main(void) {
+    printf("Testing integrator correction ... ");
+    test_integratorCorrection();
+    printf("Done!\n");
+
+    printf("Testing saturation ... ");
+    test_saturation();
+    printf("Done!\n");
+
+    printf("Testing closed loop ... ");
+    test_closedLoop();
+    printf("Done!\n");
+
+    printf("\nAll tests completed successfully!\n\n");
+
+    measureCycles();
+
+    return EXIT_SUCCESS;
+}
+
+static void test_integratorCorrection(void) {
+    struct pidParameters params = PID_DEFAULT_PARAMETERS;
+
+    struct pidController periodic;
+    pidInit(&periodic, &params, &setpointReg, &feedbackReg, &controlReg);
+
+    struct pidController pid;
+    pidInit(&pid, &params, &setpointReg, &feedbackReg, &controlReg);
+
+    struct eventTrigger trigger;
+    eventTriggerInit(&trigger, &pid, EVENT_THRESHOLD, 100.0f, 4);
+
+    // With a large output threshold, a constant error only triggers an update
+    // every maxSkip + 1 samples, at which point the integrator matches the
+    // periodic controller. The error is small enough that the output is not
+    // clamped.
+    setpointReg = 20.0f;
+    feedbackReg = 18.0f;
+
+    for (int i = 0; i < 50; i++) {
+        float periodicOutput = runControlAlgorithm(&periodic);
+        bool updated = runEventTriggeredAlgorithm(&trigger);
+
+        assert(updated == (i % 5 == 0));
+        if (updated) {
+            assert(fabsf(pid.integrator - periodic.integrator) < 1E-5f);
+            assert(fabsf(controlReg - periodicOutput) < 1E-5f);
+        }
+    }
+
+    assert(trigger.samples == 50 && trigger.updates == 10);
+    assert(fabsf(eventTriggerSkipRatio(&trigger) - 0.8f) < 1E-6f);
+
+    // 50 samples of 10 periodically, against 10 updates of 12 and 40 skipped
+    // samples of 2
+    assert(eventTriggerTimeSaved(&trigger, 10.0f, 12.0f, 2.0f) == 300.0f);
+
+    // The statistics read as zero until the next sample clears them, which is
+    // then the only sample counted
+    eventTriggerResetStatistics(&trigger);
+    assert(eventTriggerSkipRatio(&trigger) == 0.0f);
+    assert(eventTriggerTimeSaved(&trigger, 10.0f, 12.0f, 2.0f) == 0.0f);
+
+    runEventTriggeredAlgorithm(&trigger);
+    assert(!trigger.resetPending);
+    assert(trigger.samples == 1 && trigger.updates == 1);
+}
+
+static void test_saturation(void) {
+    struct pidParameters params = PID_DEFAULT_PARAMETERS;
+    params.antiWindup = PID_ANTI_WINDUP_CONDITIONAL;
+
+    struct pidController periodic;
+    pidInit(&periodic, &params, &setpointReg, &feedbackReg, &controlReg);
+
+    struct pidController pid;
+    pidInit(&pid, &params, &setpointReg, &feedbackReg, &controlReg);
+
+    struct eventTrigger trigger;
+    eventTriggerInit(&trigger, &pid, EVENT_THRESHOLD, 100.0f, 4);
+
+    // The output is clamped from the first sample, so the integrator of the
+    // periodic controller is held. Nothing is owed for the skipped samples, so
+    // the event-triggered integrator is held too.
+    setpointReg = 20.0f * DC_GAIN * OUTPUT_MAX;
+    feedbackReg = 0.0f;
+
+    for (int i = 0; i < 50; i++) {
+        runControlAlgorithm(&periodic);
+        bool updated = runEventTriggeredAlgorithm(&trigger);
+
+        assert(updated == (i % 5 == 0));
+        assert(trigger.owed == 0.0f);
+        assert(pid.integrator == periodic.integrator);
+    }
+
+    assert(controlReg == OUTPUT_MAX);
+
+    // Once the error reverses, the output leaves the limit and the skipped
+    // samples are integrated again
+    setpointReg = 0.0f;
+    feedbackReg = 1.0f;
+    runControlAlgorithm(&periodic);
+    assert(runEventTriggeredAlgorithm(&trigger));
+    assert(controlReg < OUTPUT_MAX && controlReg > OUTPUT_MIN);
+
+    runControlAlgorithm(&periodic);
+    assert(!runEventTriggeredAlgorithm(&trigger));
+    assert(trigger.owed < 0.0f);
+}
+
+static void test_closedLoop(void) {
+    struct closedLoopResult periodic = runClosedLoop(false);
+    struct closedLoopResult triggered = runClosedLoop(true);
+
+    float skipRatio = 1.0f - (float)triggered.updates / (4 * STEP_SAMPLES);
+
+    printf("\n  Mean |error|: %.3f rpm periodic, %.3f rpm event-triggered (%.0f%% skipped)\n  ",
+           periodic.absError, triggered.absError, 100.0 * skipRatio);
+
+    // The periodic controller settles to within the speed resolution, and the
+    // event-triggered controller to within the threshold of that
+    assert(periodic.finalError <= SPEED_RESOLUTION);
+    assert(triggered.finalError <= SPEED_RESOLUTION + EVENT_THRESHOLD);
+
+    // On average the event-triggered error stays within the threshold, while
+    // most samples are skipped
+    assert(triggered.absError < EVENT_THRESHOLD);
+    assert(skipRatio > 0.5f);
+}
+
+static void measureCycles(void) {
+    struct pidParameters params = PID_DEFAULT_PARAMETERS;
+
+    struct pidController pid;
+    pidInit(&pid, &params, &setpointReg, &feedbackReg, &controlReg);
+
+    struct eventTrigger trigger;
+    eventTriggerInit(&trigger, &pid, EVENT_THRESHOLD, EVENT_OUTPUT_THRESHOLD,
+                     EVENT_MAX_SKIP);
+
+    // Record the quantised steady-state speed
+    struct motor motor = {
+        .dcGain = DC_GAIN,
+        .timeConstant = TIME_CONSTANT,
+        .angularVelocity = 0.0f,
+        .coeffV = COEFF_V,
+        .coeffW = COEFF_W
+    };
+
+    setpointReg = 20.0f;
+    for (int i = 0; i < 10 * NUM_SAMPLES; i++) {
+        feedbackReg = quantise(motor.angularVelocity);
+        runControlAlgorithm(&pid);
+        calculateAngularVelocity(&motor, controlReg);
+    }
+    for (int i = 0; i < NUM_SAMPLES; i++) {
+        feedbacks[i] = quantise(motor.angularVelocity);
+        feedbackReg = feedbacks[i];
+        runControlAlgorithm(&pid);
+        calculateAngularVelocity(&motor, controlReg);
+    }
+
+    uint64_t periodicBest = UINT64_MAX, triggeredBest = UINT64_MAX;
+
+    for (int r = 0; r < NUM_REPEATS; r++) {
+        uint64_t start = benchTime();
+        for (int i = 0; i < NUM_SAMPLES; i++) {
+            feedbackReg = feedbacks[i];
+            runControlAlgorithm(&pid);
+        }
+        uint64_t elapsed = benchTime() - start;
+        if (elapsed < periodicBest)
+            periodicBest = elapsed;
+
+        eventTriggerResetStatistics(&trigger);
+
+        start = benchTime();
+        for (int i = 0; i < NUM_SAMPLES; i++) {
+            feedbackReg = feedbacks[i];
+            runEventTriggeredAlgorithm(&trigger);
+        }
+        elapsed = benchTime() - start;
+        if (elapsed < triggeredBest)
+            triggeredBest = elapsed;
+    }
+
+    double skipRatio = eventTriggerSkipRatio(&trigger);
+    double periodicCost = (double)periodicBest / NUM_SAMPLES;
+    double triggeredCost = (double)triggeredBest / NUM_SAMPLES;
+
+    // A trigger with no thresholds updates every sample, and one which cannot
+    // be reached skips every sample
+    struct eventTrigger always, never;
+    eventTriggerInit(&always, &pid, 0.0f, 0.0f, 0);
+    eventTriggerInit(&never, &pid, INFINITY, INFINITY, UINT32_MAX);
+    runEventTriggeredAlgorithm(&never);
+
+    uint64_t updateBest = UINT64_MAX, skipBest = UINT64_MAX;
+
+    for (int r = 0; r < NUM_REPEATS; r++) {
+        uint64_t start = benchTime();
+        for (int i = 0; i < NUM_SAMPLES; i++) {
+            feedbackReg = feedbacks[i];
+            runEventTriggeredAlgorithm(&always);
+        }
+        uint64_t elapsed = benchTime() - start;
+        if (elapsed < updateBest)
+            updateBest = elapsed;
+
+        start = benchTime();
+        for (int i = 0; i < NUM_SAMPLES; i++) {
+            feedbackReg = feedbacks[i];
+            runEventTriggeredAlgorithm(&never);
+        }
+        elapsed = benchTime() - start;
+        if (elapsed < skipBest)
+            skipBest = elapsed;
+    }
+
+    double updateCost = (double)updateBest / NUM_SAMPLES;
+    double skipCost = (double)skipBest / NUM_SAMPLES;
+    double saved = eventTriggerTimeSaved(&trigger, (float)periodicCost,
+                                         (float)updateCost, (float)skipCost);
+
+    printf("At steady state (%.0f%% of samples skipped):\n", 100.0 * skipRatio);
+    printf("runControlAlgorithm:        %6.1f %s/sample\n", periodicCost, BENCH_UNIT);
+    printf("runEventTriggeredAlgorithm: %6.1f %s/sample (%.0f%% saved)\n",
+           triggeredCost, BENCH_UNIT, 100.0 * (1.0 - triggeredCost / periodicCost));
+    printf("  update:                   %6.1f %s\n", updateCost, BENCH_UNIT);
+    printf("  skipped sample:           %6.1f %s\n", skipCost, BENCH_UNIT);
+    printf("eventTriggerTimeSaved():    %6.1f %s/sample (measured %.1f)\n",
+           saved / NUM_SAMPLES, BENCH_UNIT, periodicCost - triggeredCost);
+    printf("The PWM update is also skipped on the target\n");
+}
+
+// Step the setpoint between 10 and 20 rpm as in system.c, with the feedback
+// quantised to whole encoder ticks
+static struct closedLoopResult runClosedLoop(bool eventTriggered) {
+    struct pidParameters params = PID_DEFAULT_PARAMETERS;
+
+    struct pidController pid;
+    pidInit(&pid, &params, &setpointReg, &feedbackReg, &controlReg);
+
+    struct eventTrigger trigger;
+    eventTriggerInit(&trigger, &pid, EVENT_THRESHOLD, EVENT_OUTPUT_THRESHOLD,
+                     EVENT_MAX_SKIP);
+
+    struct motor motor = {
+        .dcGain = DC_GAIN,
+        .timeConstant = TIME_CONSTANT,
+        .angularVelocity = 0.0f,
+        .coeffV = COEFF_V,
+        .coeffW = COEFF_W
+    };
+
+    struct closedLoopResult result = { 0.0f, 0.0f, 0 };
+    controlReg = 0.0f;
+
+    for (int i = 0; i < 4 * STEP_SAMPLES; i++) {
+        setpointReg = (i / STEP_SAMPLES) % 2 ? 20.0f : 10.0f;
+        feedbackReg = quantise(motor.angularVelocity);
+
+        if (eventTriggered) {
+            if (runEventTriggeredAlgorithm(&trigger))
+                result.updates++;
+        } else {
+            runControlAlgorithm(&pid);
+            result.updates++;
+        }
+
+        calculateAngularVelocity(&motor, controlReg);
+
+        float error = fabsf(setpointReg - motor.angularVelocity);
+        result.absError += error / (4 * STEP_SAMPLES);
+        if (i % STEP_SAMPLES >= STEP_SAMPLES - (int)FS && error > result.finalError)
+            result.finalError = error;
+    }
+
+    return result;
+}
+
+static float quantise(float speed) {
+    return SPEED_RESOLUTION * floorf(speed / SPEED_RESOLUTION + 0.5f);
+}
@@ -0,0 +1,146 @@
+/* feedforwardBenchmark.c
+ *
+ * Host benchmark comparing the step response of the velocity controller with
+ * and without the model-based feedforward term.
+ *
+ * Each controller is first settled at 10 rpm with the simulated motor, then the
+ * setpoint is stepped to 20 rpm as when GPIO A7 is set in system.c. The rise
+ * time (10% to 90%), settling time (to within 2%), overshoot and the change in
+ * the integrator over the step are reported for each.
+ *
+ * The feedforward controller uses the gains FF_KP and FF_KI, as in system.c.
+ * It is also run without the feedforward term, and against motors whose
+ * static gain is 20% away from the model, to show how much of the improvement
+ * comes from the feedforward term and how sensitive it is to model error.
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team
+ */
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "PIDController.h"
+#include "Motor.h"
+
+#include "MotorParameters.h"
+#include "ControllerParameters.h"
+
+#define ZERO 0.0f
+
+#define INITIAL_SETPOINT    10.0f
+#define FINAL_SETPOINT      20.0f
+
+#define SETTLE_SAMPLES      500
+#define STEP_SAMPLES        500
+
+#define SETTLING_BAND       0.02f
+
+// Static gain of the mismatched motors relative to the model
+#define GAIN_ERROR          0.2f
+
+struct stepResponse {
+    float riseTime;
+    float settlingTime;
+    float overshoot;
+    float integratorChange;
+};
+
+volatile float setpointReg, feedbackReg, controlReg;
+
+static struct stepResponse measureStep(float kp, float ki,
+                                       float feedforwardGain, float gainScale);
+static void printResponse(const char *name, struct stepResponse response);
+
+int main(void) {
+    struct stepResponse feedback = measureStep(KP, KI, ZERO, 1.0f);
+    struct stepResponse feedforward = measureStep(FF_KP, FF_KI,
+                                                  FEEDFORWARD_GAIN, 1.0f);
+
+    printf("                rise (s)  settling (s)  overshoot (%%)  integrator change (V)\n");
+    printResponse("feedback", feedback);
+    printResponse("feedforward", feedforward);
+    printResponse("ff gains", measureStep(FF_KP, FF_KI, ZERO, 1.0f));
+    printResponse("ff, K - 20%", measureStep(FF_KP, FF_KI, FEEDFORWARD_GAIN,
+                                             1.0f - GAIN_ERROR));
+    printResponse("ff, K + 20%", measureStep(FF_KP, FF_KI, FEEDFORWARD_GAIN,
+                                             1.0f + GAIN_ERROR));
+
+    // The feedforward controller must be at least as fast as the default gains
+    assert(feedforward.riseTime <= feedback.riseTime);
+    assert(feedforward.settlingTime < feedback.settlingTime);
+    assert(feedforward.overshoot < feedback.overshoot);
+
+    return EXIT_SUCCESS;
+}
+
+static struct stepResponse measureStep(float kp, float ki,
+                                       float feedforwardGain, float gainScale) {
+    struct pidController pid;
+    struct pidParameters params = PID_DEFAULT_PARAMETERS;
+    params.kp = kp;
+    params.ki = ki;
+    params.feedforwardGain = feedforwardGain;
+    pidInit(&pid, &params, &setpointReg, &feedbackReg, &controlReg);
+
+    struct motor motor = {
+        .dcGain = DC_GAIN * gainScale,
+        .timeConstant = TIME_CONSTANT,
+        .angularVelocity = ZERO,
+        .coeffV = COEFF_V * gainScale,
+        .coeffW = COEFF_W
+    };
+
+    setpointReg = INITIAL_SETPOINT;
+    for (int i = 0; i < SETTLE_SAMPLES; i++) {
+        feedbackReg = motor.angularVelocity;
+        runControlAlgorithm(&pid);
+        calculateAngularVelocity(&motor, controlReg);
+    }
+
+    float initialIntegrator = pid.integrator;
+    float step = FINAL_SETPOINT - INITIAL_SETPOINT;
+
+    int riseStart = -1, riseEnd = -1, lastOutsideBand = -1;
+    float peak = motor.angularVelocity;
+
+    setpointReg = FINAL_SETPOINT;
+    for (int i = 0; i < STEP_SAMPLES; i++) {
+        feedbackReg = motor.angularVelocity;
+        runControlAlgorithm(&pid);
+        calculateAngularVelocity(&motor, controlReg);
+
+        // Response at the end of sample i
+        float progress = (motor.angularVelocity - INITIAL_SETPOINT) / step;
+        if (riseStart < 0 && progress >= 0.1f)
+            riseStart = i;
+        if (riseEnd < 0 && progress >= 0.9f)
+            riseEnd = i;
+        if (fabsf(progress - 1.0f) > SETTLING_BAND)
+            lastOutsideBand = i;
+        if (motor.angularVelocity > peak)
+            peak = motor.angularVelocity;
+    }
+
+    struct stepResponse response = {
+        .riseTime = (riseStart >= 0 && riseEnd >= 0) ? (riseEnd - riseStart) * TS : NAN,
+        .settlingTime = (lastOutsideBand + 1) * TS,
+        .overshoot = (peak - FINAL_SETPOINT) / step * 100.0f,
+        .integratorChange = pid.integrator - initialIntegrator
+    };
+
+    if (response.overshoot < ZERO)
+        response.overshoot = ZERO;
+
+    return response;
+}
+
+static void printResponse(const char *name, struct stepResponse response) {
+    printf("%-12s  %10.2f  %12.2f  %13.1f  %21.3f\n", name,
+           response.riseTime, response.settlingTime, response.overshoot,
+           response.integratorChange);
+}
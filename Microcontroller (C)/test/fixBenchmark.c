@@ -0,0 +1,581 @@
+/* fixBenchmark.c
+ * Tests and benchmarks for the saturating fixed point operations and the
+ * vector kernels.
+ *
+ * The saturating operations are checked against a 64-bit reference which
+ * clamps the exact result, over random operands of which a proportion
+ * overflow, along with the flags they set in fixStatus. The throughput of each
+ * operation is then compared with the operation returning fixOverflow.
+ *
+ * The dot product, FIR and block multiply-accumulate kernels are checked
+ * against the same reference, and compared for speed and error with the same
+ * calculation made of chained fixMultiply() and fixAdd() calls.
+ *
+ * Division and square root are checked to be exact, and the largest errors of
+ * the sine, cosine and atan2 are measured against the long double functions.
+ * Their throughput is compared with the floating point functions and with
+ * 64-bit integer division.
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team.
+ */
+
+#include "benchmark.h"
+
+#include "fix_t.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define NUM_OPERANDS    4096
+#define NUM_CHECKS      1000000
+#define NUM_REPEATS     200
+
+// Taps of the FIR filter benchmarked
+#define NUM_TAPS        16
+
+// Time NUM_OPERANDS applications of an operation, taking the best of
+// NUM_REPEATS runs, and store the number of operations per second in `rate`.
+// This is a macro so that the operation is inlined into the loop.
+#define TIME_OPERATION(operation, rate) do {                    \
+        double best = 1E9;                                      \
+        for (int r = 0; r < NUM_REPEATS; r++) {                 \
+            fix_t sink = 0;                                     \
+            double start = benchSeconds();                      \
+            for (int i = 0; i < NUM_OPERANDS; i++)              \
+                sink ^= operation(xs[i], ys[i]);                \
+            double elapsed = benchSeconds() - start;            \
+            volatile fix_t keep = sink;                         \
+            (void)keep;                                         \
+            if (elapsed < best)                                 \
+                best = elapsed;                                 \
+        }                                                       \
+        (rate) = NUM_OPERANDS / best;                           \
+    } while (0)
+
+// As TIME_OPERATION(), over the operands converted to float
+#define TIME_FLOAT_OPERATION(operation, rate) do {              \
+        double best = 1E9;                                      \
+        for (int r = 0; r < NUM_REPEATS; r++) {                 \
+            float sink = 0.0f;                                  \
+            double start = benchSeconds();                      \
+            for (int i = 0; i < NUM_OPERANDS; i++)              \
+                sink += operation(fys[i], fxs[i]);              \
+            double elapsed = benchSeconds() - start;            \
+            volatile float keep = sink;                         \
+            (void)keep;                                         \
+            if (elapsed < best)                                 \
+                best = elapsed;                                 \
+        }                                                       \
+        (rate) = NUM_OPERANDS / best;                           \
+    } while (0)
+
+static fix_t xs[NUM_OPERANDS], ys[NUM_OPERANDS];
+
+// Operations compared with fixDivide(), fixSqrt() and fixSin(), in the form
+// taken by the timing macros
+static inline fix_t longDivide(fix_t x, fix_t y) {
+    return (fix_t)(((dint_t)x << Q_POINT) / y);
+}
+static inline float floatDivide(float y, float x) { return x / y; }
+static inline fix_t sqrtOf(fix_t x, fix_t y) { (void)y; return fixSqrt(x & FIX_MAX); }
+static inline float sqrtfOf(float y, float x) { (void)y; return sqrtf(fabsf(x)); }
+static inline fix_t sinOf(fix_t x, fix_t y) { (void)y; return fixSin(x); }
+static inline float sinfOf(float y, float x) { (void)y; return sinf(x); }
+
+static void test_addSat(void);
+static void test_subtractSat(void);
+static void test_multiplySat(void);
+static void test_dot(void);
+static void test_fir(void);
+static void test_macBlock(void);
+static void measureThroughput(void);
+static void measureKernels(void);
+static void test_divide(void);
+static void test_sqrt(void);
+static void test_sinCos(void);
+static void test_atan2(void);
+static void measureMath(void);
+
+static fix_t chainedDot(const fix_t *x, const fix_t *y, uint32_t length);
+static void chainedFir(const fix_t *coeffs, fix_t *state, uint32_t numTaps,
+                       const fix_t *input, fix_t *output, uint32_t length);
+static void chainedMacBlock(fix_t *acc, const fix_t *x, const fix_t *y, uint32_t length);
+
+static fix_t randomFix(word_t range);
+static fix_t clampReference(dint_t exact);
+
+int main(void) {
+    srand(1);
+
+    printf("Testing fixAddSat() ... ");
+    test_addSat();
+    printf("Done!\n");
+
+    printf("Testing fixSubtractSat() ... ");
+    test_subtractSat();
+    printf("Done!\n");
+
+    printf("Testing fixMultiplySat() ... ");
+    test_multiplySat();
+    printf("Done!\n");
+
+    printf("Testing fixDot() ... ");
+    test_dot();
+    printf("Done!\n");
+
+    printf("Testing fixFir() ... ");
+    test_fir();
+    printf("Done!\n");
+
+    printf("Testing fixMacBlock() ... ");
+    test_macBlock();
+    printf("Done!\n");
+
+    printf("Testing fixDivide() ... ");
+    test_divide();
+    printf("Done!\n");
+
+    printf("Testing fixSqrt() ... ");
+    test_sqrt();
+    printf("Done!\n");
+
+    printf("Testing fixSin() and fixCos() ... ");
+    test_sinCos();
+    printf("Done!\n");
+
+    printf("Testing fixAtan2() ... ");
+    test_atan2();
+    printf("Done!\n");
+
+    printf("\nAll tests completed successfully!\n\n");
+
+    measureThroughput();
+    printf("\n");
+    measureKernels();
+    printf("\n");
+    measureMath();
+
+    return EXIT_SUCCESS;
+}
+
+static void test_addSat(void) {
+    for (int i = 0; i < NUM_CHECKS; i++) {
+        fix_t x = randomFix(UINT32_MAX), y = randomFix(UINT32_MAX);
+        dint_t exact = (dint_t)x + y;
+
+        fixStatusClear();
+        assert(fixAddSat(x, y) == clampReference(exact));
+        assert(fixStatusGet() == (clampReference(exact) != exact
+                                  ? FIX_STATUS_ADD_OVERFLOW : 0));
+    }
+}
+
+static void test_subtractSat(void) {
+    for (int i = 0; i < NUM_CHECKS; i++) {
+        fix_t x = randomFix(UINT32_MAX), y = randomFix(UINT32_MAX);
+        dint_t exact = (dint_t)x - y;
+
+        fixStatusClear();
+        assert(fixSubtractSat(x, y) == clampReference(exact));
+        assert(fixStatusGet() == (clampReference(exact) != exact
+                                  ? FIX_STATUS_SUBTRACT_OVERFLOW : 0));
+    }
+}
+
+static void test_multiplySat(void) {
+    // Every other product has operands of up to 2^24 (256.0), of which about
+    // a tenth overflow
+    for (int i = 0; i < NUM_CHECKS; i++) {
+        word_t range = i & 1 ? UINT32_MAX : (word_t)1 << 25;
+        fix_t x = randomFix(range), y = randomFix(range);
+
+        // Round towards negative infinity, as the shift in fixMultiply()
+        dint_t product = (dint_t)x * y;
+        dint_t exact = product >= 0 ? product >> Q_POINT
+                                    : -((-product - 1) >> Q_POINT) - 1;
+
+        fixStatusClear();
+        assert(fixMultiplySat(x, y) == clampReference(exact));
+        assert(fixStatusGet() == (clampReference(exact) != exact
+                                  ? FIX_STATUS_MULTIPLY_OVERFLOW : 0));
+
+        // Without overflow the result matches the existing operation
+        if (clampReference(exact) == exact && exact != fixOverflow)
+            assert(fixMultiply(x, y) == exact);
+    }
+}
+
+static void test_dot(void) {
+    fix_t x[64], y[64];
+
+    for (int trial = 0; trial < 10000; trial++) {
+        uint32_t length = (uint32_t)(trial % 64);
+        word_t range = trial & 1 ? UINT32_MAX : (word_t)1 << 25;
+
+        dint_t exact = 0;
+        for (uint32_t i = 0; i < length; i++) {
+            x[i] = randomFix(range);
+            y[i] = randomFix(range);
+            exact += (dint_t)x[i] * y[i];
+        }
+        exact = exact >= 0 ? exact >> Q_POINT : -((-exact - 1) >> Q_POINT) - 1;
+
+        fixStatusClear();
+        assert(fixDot(x, y, length) == clampReference(exact));
+        assert(fixStatusGet() == (clampReference(exact) != exact
+                                  ? FIX_STATUS_ACCUMULATE_OVERFLOW : 0));
+    }
+
+    // Intermediate sums may go out of range as long as the result does not
+    x[0] = FIX_POINT(30000);
+    y[0] = FIX_POINT(2);
+    x[1] = FIX_POINT(-30000);
+    y[1] = FIX_POINT(1.5);
+    fixStatusClear();
+    assert(fixDot(x, y, 2) == FIX_POINT(15000));
+    assert(fixStatusGet() == 0);
+    assert(fixDot(NULL, y, 2) == 0);
+}
+
+static void test_fir(void) {
+    enum { LENGTH = 200, TAPS = 7 };
+    fix_t coeffs[TAPS], input[LENGTH], output[LENGTH];
+
+    for (int i = 0; i < TAPS; i++)
+        coeffs[i] = randomFix((word_t)1 << 17);
+    for (int i = 0; i < LENGTH; i++)
+        input[i] = randomFix((word_t)1 << 24);
+
+    // Filter in blocks of several lengths, including blocks shorter than the
+    // state, which must give the same output as one block
+    const uint32_t blocks[] = { 1, 3, 10, 2, 50, 6, 100, 28 };
+    fix_t state[TAPS - 1] = { 0 };
+    uint32_t start = 0;
+    for (size_t b = 0; b < sizeof(blocks) / sizeof(blocks[0]); b++) {
+        fixFir(coeffs, state, TAPS, &input[start], &output[start], blocks[b]);
+        start += blocks[b];
+    }
+    assert(start == LENGTH);
+
+    for (int n = 0; n < LENGTH; n++) {
+        dint_t exact = 0;
+        for (int k = 0; k < TAPS && k <= n; k++)
+            exact += (dint_t)coeffs[k] * input[n - k];
+        exact = exact >= 0 ? exact >> Q_POINT : -((-exact - 1) >> Q_POINT) - 1;
+        assert(output[n] == exact);
+    }
+
+    // A single tap is a gain, with no state
+    fix_t gain = FIX_POINT(0.5);
+    fixFir(&gain, state, 1, input, output, LENGTH);
+    for (int n = 0; n < LENGTH; n++)
+        assert(output[n] == input[n] >> 1);
+}
+
+static void test_macBlock(void) {
+    enum { LENGTH = 1000 };
+    fix_t acc[LENGTH], x[LENGTH], y[LENGTH];
+    dint_t exact[LENGTH];
+
+    for (int i = 0; i < LENGTH; i++) {
+        acc[i] = randomFix(UINT32_MAX);
+        x[i] = randomFix((word_t)1 << 26);
+        y[i] = randomFix((word_t)1 << 26);
+
+        dint_t sum = ((dint_t)acc[i] << Q_POINT) + (dint_t)x[i] * y[i];
+        exact[i] = sum >= 0 ? sum >> Q_POINT : -((-sum - 1) >> Q_POINT) - 1;
+    }
+
+    fixStatusClear();
+    fixMacBlock(acc, x, y, LENGTH);
+
+    bool overflowed = false;
+    for (int i = 0; i < LENGTH; i++) {
+        assert(acc[i] == clampReference(exact[i]));
+        overflowed |= clampReference(exact[i]) != exact[i];
+    }
+    assert(overflowed);
+    assert(fixStatusGet() == FIX_STATUS_ACCUMULATE_OVERFLOW);
+}
+
+static void measureThroughput(void) {
+    // Operands of up to 2^28 (4096.0), so that about a tenth of the products
+    // and none of the sums overflow. The branches in the existing operations
+    // are then as predictable as they would be in a controller.
+    for (int i = 0; i < NUM_OPERANDS; i++) {
+        xs[i] = randomFix((word_t)1 << 29);
+        ys[i] = randomFix((word_t)1 << 29);
+    }
+
+    double rates[6];
+    TIME_OPERATION(fixAdd, rates[0]);
+    TIME_OPERATION(fixAddSat, rates[1]);
+    TIME_OPERATION(fixSubtract, rates[2]);
+    TIME_OPERATION(fixSubtractSat, rates[3]);
+    TIME_OPERATION(fixMultiply, rates[4]);
+    TIME_OPERATION(fixMultiplySat, rates[5]);
+
+    printf("Throughput over %d operands:\n", NUM_OPERANDS);
+    printf("fixAdd:         %8.1f Mops/s\n", rates[0] * 1E-6);
+    printf("fixAddSat:      %8.1f Mops/s\n", rates[1] * 1E-6);
+    printf("fixSubtract:    %8.1f Mops/s\n", rates[2] * 1E-6);
+    printf("fixSubtractSat: %8.1f Mops/s\n", rates[3] * 1E-6);
+    printf("fixMultiply:    %8.1f Mops/s\n", rates[4] * 1E-6);
+    printf("fixMultiplySat: %8.1f Mops/s\n", rates[5] * 1E-6);
+}
+
+static void measureKernels(void) {
+    static fix_t coeffs[NUM_TAPS], state[NUM_TAPS - 1], output[NUM_OPERANDS];
+    static fix_t acc[NUM_OPERANDS];
+
+    // Signals of up to +/- 64.0 and coefficients of up to +/- 0.5, as in a
+    // low-pass filter of the speed
+    for (int i = 0; i < NUM_OPERANDS; i++) {
+        xs[i] = randomFix((word_t)1 << 23);
+        ys[i] = randomFix((word_t)1 << 16);
+    }
+    for (int i = 0; i < NUM_TAPS; i++)
+        coeffs[i] = randomFix((word_t)1 << 16);
+
+    double exactDot = 0.0;
+    for (int i = 0; i < NUM_OPERANDS; i++)
+        exactDot += (double)xs[i] * ys[i] / (CONVERSION_FACTOR * CONVERSION_FACTOR);
+
+    uint64_t best[6];
+    for (int b = 0; b < 6; b++)
+        best[b] = UINT64_MAX;
+
+    fix_t dot = 0, chained = 0;
+
+    for (int r = 0; r < NUM_REPEATS; r++) {
+        uint64_t times[7];
+        times[0] = benchTime();
+        dot = fixDot(xs, ys, NUM_OPERANDS);
+        times[1] = benchTime();
+        chained = chainedDot(xs, ys, NUM_OPERANDS);
+        times[2] = benchTime();
+        fixFir(coeffs, state, NUM_TAPS, xs, output, NUM_OPERANDS);
+        times[3] = benchTime();
+        chainedFir(coeffs, state, NUM_TAPS, xs, output, NUM_OPERANDS);
+        times[4] = benchTime();
+        fixMacBlock(acc, xs, ys, NUM_OPERANDS);
+        times[5] = benchTime();
+        chainedMacBlock(acc, xs, ys, NUM_OPERANDS);
+        times[6] = benchTime();
+
+        for (int b = 0; b < 6; b++)
+            if (times[b + 1] - times[b] < best[b])
+                best[b] = times[b + 1] - times[b];
+
+        // Keep the accumulators in range
+        for (int i = 0; i < NUM_OPERANDS; i++)
+            acc[i] = 0;
+    }
+
+    printf("Kernels over %d values (%d taps), %s per multiply-accumulate:\n",
+           NUM_OPERANDS, NUM_TAPS, BENCH_UNIT);
+    printf("fixDot:         %6.2f   chained: %6.2f\n",
+           (double)best[0] / NUM_OPERANDS, (double)best[1] / NUM_OPERANDS);
+    printf("fixFir:         %6.2f   chained: %6.2f\n",
+           (double)best[2] / (NUM_OPERANDS * NUM_TAPS),
+           (double)best[3] / (NUM_OPERANDS * NUM_TAPS));
+    printf("fixMacBlock:    %6.2f   chained: %6.2f\n",
+           (double)best[4] / NUM_OPERANDS, (double)best[5] / NUM_OPERANDS);
+
+    // Each chained product is truncated, so the error grows with the length
+    printf("Dot product error: %.2e (fixDot), %.2e (chained)\n",
+           dot / CONVERSION_FACTOR - exactDot, chained / CONVERSION_FACTOR - exactDot);
+    assert(fabs(dot / CONVERSION_FACTOR - exactDot) < 1.0 / CONVERSION_FACTOR);
+}
+
+static void test_divide(void) {
+    for (int i = 0; i < NUM_CHECKS; i++) {
+        // Divisors of every magnitude, so that all normalisation shifts are
+        // covered, and quotients both in and out of range
+        fix_t x = randomFix(UINT32_MAX);
+        fix_t y = randomFix(UINT32_MAX) >> (rand() % 32);
+        if (y == 0)
+            continue;
+
+        dint_t exact = ((dint_t)x * ((dint_t)1 << Q_POINT)) / y;
+
+        fixStatusClear();
+        assert(fixDivide(x, y) == clampReference(exact));
+        assert(fixStatusGet() == (clampReference(exact) != exact
+                                  ? FIX_STATUS_DIVIDE_OVERFLOW : 0));
+    }
+
+    // Extremes of both operands
+    const fix_t edges[] = { FIX_MIN, FIX_MIN + 1, -FIX_POINT(1), -1, 1,
+                            FIX_POINT(1), FIX_MAX - 1, FIX_MAX };
+    for (size_t i = 0; i < sizeof(edges) / sizeof(edges[0]); i++) {
+        for (size_t j = 0; j < sizeof(edges) / sizeof(edges[0]); j++) {
+            dint_t exact = ((dint_t)edges[i] * ((dint_t)1 << Q_POINT)) / edges[j];
+            assert(fixDivide(edges[i], edges[j]) == clampReference(exact));
+        }
+    }
+
+    fixStatusClear();
+    assert(fixDivide(FIX_POINT(3), 0) == FIX_MAX);
+    assert(fixDivide(FIX_POINT(-3), 0) == FIX_MIN);
+    assert(fixStatusGet() == FIX_STATUS_DIVIDE_OVERFLOW);
+}
+
+static void test_sqrt(void) {
+    for (int i = 0; i < NUM_CHECKS; i++) {
+        fix_t x = randomFix(UINT32_MAX) >> (rand() % 32);
+        if (x < 0)
+            x = -(x + 1);
+
+        // Exact floor of the root of x 2^16, corrected for rounding of sqrtl
+        uint64_t radicand = (uint64_t)x << Q_POINT;
+        uint64_t root = (uint64_t)sqrtl((long double)radicand);
+        while (root * root > radicand)
+            root--;
+        while ((root + 1) * (root + 1) <= radicand)
+            root++;
+
+        assert(fixSqrt(x) == (fix_t)root);
+    }
+
+    assert(fixSqrt(FIX_POINT(2.25)) == FIX_POINT(1.5));
+    assert(fixSqrt(FIX_MAX) == (fix_t)11863283);
+
+    fixStatusClear();
+    assert(fixSqrt(-1) == 0);
+    assert(fixStatusGet() == FIX_STATUS_DOMAIN_ERROR);
+}
+
+static void test_sinCos(void) {
+    double worstSin = 0.0, worstCos = 0.0;
+
+    for (int i = 0; i < NUM_CHECKS; i++) {
+        // Angles up to +/- 8 turns
+        fix_t angle = randomFix((word_t)1 << 24) * 2;
+        long double radians = angle / (long double)CONVERSION_FACTOR;
+
+        worstSin = fmax(worstSin, fabsl(fixSin(angle) / (long double)CONVERSION_FACTOR
+                                        - sinl(radians)));
+        worstCos = fmax(worstCos, fabsl(fixCos(angle) / (long double)CONVERSION_FACTOR
+                                        - cosl(radians)));
+    }
+
+    printf("\n  Largest error: sine %.2f LSB, cosine %.2f LSB\n  ",
+           worstSin * CONVERSION_FACTOR, worstCos * CONVERSION_FACTOR);
+
+    // Rounding of the table and of the interpolation, plus the error of
+    // interpolating linearly (0.3 LSB)
+    assert(worstSin <= 1.5 / CONVERSION_FACTOR);
+    assert(worstCos <= 1.5 / CONVERSION_FACTOR);
+    assert(fixSin(0) == 0 && fixCos(0) == FIX_POINT(1) - 1);
+}
+
+static void test_atan2(void) {
+    double worst = 0.0;
+
+    for (int i = 0; i < NUM_CHECKS; i++) {
+        // Points at every distance from the origin
+        int shift = rand() % 31;
+        fix_t x = randomFix(UINT32_MAX) >> shift, y = randomFix(UINT32_MAX) >> shift;
+        if (x == 0 && y == 0)
+            continue;
+
+        long double exact = atan2l((long double)y, (long double)x);
+        worst = fmax(worst, fabsl(fixAtan2(y, x) / (long double)CONVERSION_FACTOR - exact));
+    }
+
+    printf("\n  Largest error: %.2f LSB\n  ", worst * CONVERSION_FACTOR);
+
+    assert(worst <= 1.0 / CONVERSION_FACTOR);
+    assert(fixAtan2(0, 0) == 0);
+    assert(fixAtan2(0, FIX_POINT(-1)) == FIX_PI);
+    assert(fixAtan2(FIX_POINT(-2), 0) == -FIX_HALF_PI);
+    assert(abs(fixAtan2(FIX_MIN, FIX_MIN) - FIX_POINT(-2.35619449019234)) <= 1);
+}
+
+static void measureMath(void) {
+    // Operands spread over the range used for speeds and angles, with no zero
+    // divisors
+    for (int i = 0; i < NUM_OPERANDS; i++) {
+        xs[i] = randomFix((word_t)1 << 24);
+        ys[i] = randomFix((word_t)1 << 24) | 1;
+    }
+
+    static float fxs[NUM_OPERANDS], fys[NUM_OPERANDS];
+    for (int i = 0; i < NUM_OPERANDS; i++) {
+        fxs[i] = fix2float(xs[i]);
+        fys[i] = fix2float(ys[i]);
+    }
+
+    double rates[10];
+    TIME_OPERATION(fixDivide, rates[0]);
+    TIME_OPERATION(longDivide, rates[1]);
+    TIME_FLOAT_OPERATION(floatDivide, rates[2]);
+    TIME_OPERATION(sqrtOf, rates[3]);
+    TIME_FLOAT_OPERATION(sqrtfOf, rates[4]);
+    TIME_OPERATION(sinOf, rates[5]);
+    TIME_FLOAT_OPERATION(sinfOf, rates[6]);
+    TIME_OPERATION(fixAtan2, rates[7]);
+    TIME_FLOAT_OPERATION(atan2f, rates[8]);
+
+    printf("Throughput over %d operands:\n", NUM_OPERANDS);
+    printf("fixDivide:      %8.1f Mops/s   64-bit division: %6.1f   float: %6.1f\n",
+           rates[0] * 1E-6, rates[1] * 1E-6, rates[2] * 1E-6);
+    printf("fixSqrt:        %8.1f Mops/s   sqrtf:  %6.1f\n", rates[3] * 1E-6, rates[4] * 1E-6);
+    printf("fixSin:         %8.1f Mops/s   sinf:   %6.1f\n", rates[5] * 1E-6, rates[6] * 1E-6);
+    printf("fixAtan2:       %8.1f Mops/s   atan2f: %6.1f\n", rates[7] * 1E-6, rates[8] * 1E-6);
+}
+
+// The same calculations from the scalar operations, as they would be written
+// without the kernels
+static fix_t chainedDot(const fix_t *x, const fix_t *y, uint32_t length) {
+    fix_t acc = 0;
+    for (uint32_t i = 0; i < length; i++)
+        acc = fixAdd(acc, fixMultiply(x[i], y[i]));
+    return acc;
+}
+
+static void chainedFir(const fix_t *coeffs, fix_t *state, uint32_t numTaps,
+                       const fix_t *input, fix_t *output, uint32_t length) {
+    uint32_t history = numTaps - 1;
+
+    for (uint32_t n = 0; n < length; n++) {
+        fix_t acc = 0;
+        for (uint32_t k = 0; k < numTaps; k++) {
+            fix_t x = k <= n ? input[n - k] : state[history + n - k];
+            acc = fixAdd(acc, fixMultiply(coeffs[k], x));
+        }
+        output[n] = acc;
+    }
+
+    for (uint32_t i = 0; i < history; i++)
+        state[i] = input[length - history + i];
+}
+
+static void chainedMacBlock(fix_t *acc, const fix_t *x, const fix_t *y, uint32_t length) {
+    for (uint32_t i = 0; i < length; i++)
+        acc[i] = fixAdd(acc[i], fixMultiply(x[i], y[i]));
+}
+
+// Uniformly distributed in [-range / 2, range / 2), or over all values if
+// range is UINT32_MAX
+static fix_t randomFix(word_t range) {
+    word_t r = ((word_t)rand() << 16) ^ ((word_t)rand() << 8) ^ (word_t)rand();
+    if (range == UINT32_MAX)
+        return (fix_t)r;
+    return (fix_t)(r % range - range / 2);
+}
+
+static fix_t clampReference(dint_t exact) {
+    if (exact > FIX_MAX)
+        return FIX_MAX;
+    if (exact < FIX_MIN)
+        return FIX_MIN;
+    return (fix_t)exact;
+}
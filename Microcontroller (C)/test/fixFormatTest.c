@@ -0,0 +1,237 @@
+/* fixFormatTest.c
+ * Tests for the fixed point format families.
+ *
+ * The arithmetic of each format is checked against a 64-bit reference over
+ * random operands, q16 is checked against fix_t, and rescaling is checked for
+ * rounding and saturation. Finally the proportional term of the fixed point
+ * controller is calculated with its gain in Q16 and in Q24, to show the error
+ * from quantising a small coefficient.
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team.
+ */
+
+#include "FixFormat.h"
+
+#include "ControllerParameters.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define NUM_CHECKS      200000
+
+static void test_constants(void);
+static void test_arithmetic(void);
+static void test_matchesFix(void);
+static void test_rescale(void);
+static void test_multiplyMixed(void);
+static void test_precision(void);
+
+static int32_t randomRaw(int bits);
+static dint_t clampReference(dint_t exact, int bits);
+
+int main(void) {
+    srand(1);
+
+    printf("Testing constants ... ");
+    test_constants();
+    printf("Done!\n");
+
+    printf("Testing arithmetic ... ");
+    test_arithmetic();
+    printf("Done!\n");
+
+    printf("Testing q16 against fix_t ... ");
+    test_matchesFix();
+    printf("Done!\n");
+
+    printf("Testing rescaling ... ");
+    test_rescale();
+    printf("Done!\n");
+
+    printf("Testing mixed multiplication ... ");
+    test_multiplyMixed();
+    printf("Done!\n");
+
+    printf("Testing precision ... ");
+    test_precision();
+    printf("Done!\n");
+
+    printf("\nAll tests completed successfully!\n");
+
+    return EXIT_SUCCESS;
+}
+
+static void test_constants(void) {
+    static const q8_t voltageCoeff = { FIX_Q(q8, 2083.3333) };
+    static const q15_t half = { FIX_Q(q15, -0.5) };
+    static const q24_t kp = { FIX_Q(q24, 0.0165) };
+
+    // As voltageCoeff in System.v
+    assert(q8Raw(voltageCoeff) == 0x00082355);
+    assert(q15Raw(half) == -16384);
+    assert(q24Raw(kp) == 276824);
+
+    assert(q16Raw(q16FromFloat(1.5f)) == FIX_POINT(1.5));
+    assert(q14Raw(q14FromFloat(-2.25f)) == -36864);
+    assert(q15ToFloat(q15FromFloat(0.25f)) == 0.25f);
+    assert(q24ToFloat(q24FromFloat(-100.125f)) == -100.125f);
+
+    fixStatusClear();
+    assert(q15Raw(q15FromFloat(1.0f)) == INT16_MAX);
+    assert(q15Raw(q15FromFloat(-1.0f)) == INT16_MIN);
+    assert(q24Raw(q24FromFloat(200.0f)) == INT32_MAX);
+    assert(fixStatusGet() == FIX_STATUS_RESCALE_OVERFLOW);
+}
+
+// Check the operations of one format, with raw values of `bits` bits
+#define CHECK_ARITHMETIC(name, bits) do {                                       \
+        for (int i = 0; i < NUM_CHECKS; i++) {                                  \
+            int32_t a = randomRaw(i & 1 ? (bits) : (bits) / 2 + 4);             \
+            int32_t b = randomRaw(i & 1 ? (bits) : (bits) / 2 + 4);             \
+            name##_t x = name##FromRaw(a), y = name##FromRaw(b);                \
+                                                                                \
+            assert(name##Raw(name##Add(x, y))                                   \
+                   == clampReference((dint_t)a + b, (bits)));                   \
+            assert(name##Raw(name##Sub(x, y))                                   \
+                   == clampReference((dint_t)a - b, (bits)));                   \
+                                                                                \
+            dint_t product = (dint_t)a * b;                                     \
+            dint_t exact = product >= 0                                         \
+                           ? product >> name##_FRAC_BITS                        \
+                           : -((-product - 1) >> name##_FRAC_BITS) - 1;         \
+            assert(name##Raw(name##Mul(x, y)) == clampReference(exact, (bits)));\
+        }                                                                       \
+    } while (0)
+
+static void test_arithmetic(void) {
+    CHECK_ARITHMETIC(q8, 32);
+    CHECK_ARITHMETIC(q14, 32);
+    CHECK_ARITHMETIC(q15, 16);
+    CHECK_ARITHMETIC(q16, 32);
+    CHECK_ARITHMETIC(q24, 32);
+
+    fixStatusClear();
+    q15Mul(q15FromRaw(INT16_MIN), q15FromRaw(INT16_MIN));
+    assert(fixStatusGet() == FIX_STATUS_MULTIPLY_OVERFLOW);
+}
+
+static void test_matchesFix(void) {
+    // Without overflow, q16 gives the same results as fix_t
+    for (int i = 0; i < NUM_CHECKS; i++) {
+        fix_t a = randomRaw(24), b = randomRaw(24);
+        q16_t x = q16FromFix(a), y = q16FromFix(b);
+
+        assert(q16ToFix(q16Add(x, y)) == fixAdd(a, b));
+        assert(q16ToFix(q16Sub(x, y)) == fixSubtract(a, b));
+        assert(q16ToFix(q16Mul(x, y)) == fixMultiply(a, b));
+    }
+}
+
+static void test_rescale(void) {
+    fixStatusClear();
+
+    // Gaining fraction bits is exact within the range of the destination.
+    // FIX_RESCALE_EXACT(q24, q16, x) would not compile, as q24 has fewer
+    // integer bits than q16.
+    q16_t x = q16FromFloat(-3.75f);
+    assert(q24ToFloat(FIX_RESCALE(q24, q16, FIX_RESCALE(q16, q14,
+           FIX_RESCALE(q14, q8, q8FromFloat(-3.75f))))) == -3.75f);
+    assert(q16Raw(FIX_RESCALE(q16, q24, FIX_RESCALE(q24, q16, x))) == q16Raw(x));
+    assert(q24ToFloat(FIX_RESCALE_EXACT(q24, q15, q15FromFloat(-0.75f))) == -0.75f);
+
+    // Losing fraction bits rounds to the nearest value, with halves rounded up
+    assert(q8Raw(FIX_RESCALE(q8, q16, q16FromRaw(0x17F))) == 0x1);
+    assert(q8Raw(FIX_RESCALE(q8, q16, q16FromRaw(0x180))) == 0x2);
+    assert(q8Raw(FIX_RESCALE(q8, q16, q16FromRaw(-0x17F))) == -0x1);
+    assert(q8Raw(FIX_RESCALE(q8, q16, q16FromRaw(-0x181))) == -0x2);
+    assert(q15Raw(FIX_RESCALE(q15, q16, q16FromFloat(0.25f))) == 8192);
+    assert(fixStatusGet() == 0);
+
+    // Losing integer bits saturates
+    assert(q24Raw(FIX_RESCALE(q24, q16, q16FromFloat(128.0f))) == INT32_MAX);
+    assert(q24Raw(FIX_RESCALE(q24, q8, q8FromRaw(INT32_MIN))) == INT32_MIN);
+    assert(q15Raw(FIX_RESCALE(q15, q16, q16FromFloat(-1.5f))) == INT16_MIN);
+    assert(q15Raw(FIX_RESCALE(q15, q16, q16FromRaw(INT32_MAX))) == INT16_MAX);
+    assert(fixStatusGet() == FIX_STATUS_RESCALE_OVERFLOW);
+
+    // Every q15 value is a q16 value
+    fixStatusClear();
+    for (int32_t raw = INT16_MIN; raw <= INT16_MAX; raw++) {
+        q16_t wide = FIX_RESCALE_EXACT(q16, q15, q15FromRaw((int16_t)raw));
+        assert(q16Raw(wide) == raw * 2);
+        assert(q15Raw(FIX_RESCALE(q15, q16, wide)) == raw);
+    }
+    assert(fixStatusGet() == 0);
+}
+
+static void test_multiplyMixed(void) {
+    fixStatusClear();
+
+    for (int i = 0; i < NUM_CHECKS; i++) {
+        q24_t gain = q24FromRaw(randomRaw(26));
+        q16_t value = q16FromRaw(randomRaw(28));
+
+        // The product of a q24 and a q16 has 40 fraction bits. Round it to 16.
+        dint_t product = (dint_t)q24Raw(gain) * q16Raw(value);
+        dint_t exact = (product + ((dint_t)1 << 23)) >> 24;
+
+        assert(q16Raw(FIX_MULTIPLY(q16, q24, gain, q16, value)) == exact);
+    }
+    assert(fixStatusGet() == 0);
+
+    assert(q16Raw(FIX_MULTIPLY(q16, q24, q24FromFloat(64.0f), q16, q16FromFloat(1024.0f)))
+           == INT32_MAX);
+    assert(fixStatusGet() == FIX_STATUS_MULTIPLY_OVERFLOW);
+}
+
+static void test_precision(void) {
+    // Proportional term KP * error of the fixed point controller, with KP in
+    // Q16 (FIX_PROP_COEFF2) and in Q24
+    const q16_t kp16 = { FIX_PROP_COEFF2 };
+    const q24_t kp24 = { FIX_Q(q24, KP) };
+
+    double worst16 = 0.0, worst24 = 0.0;
+
+    for (int i = 0; i < NUM_CHECKS; i++) {
+        // Errors of up to +/- 64 rpm
+        q16_t error = q16FromRaw(randomRaw(23));
+        double exact = (double)KP * q16Raw(error) / 65536.0;
+
+        double p16 = q16ToFloat(q16Mul(kp16, error));
+        double p24 = q16ToFloat(FIX_MULTIPLY(q16, q24, kp24, q16, error));
+
+        worst16 = fmax(worst16, fabs(p16 - exact));
+        worst24 = fmax(worst24, fabs(p24 - exact));
+    }
+
+    printf("\n  Largest error in KP * error for errors up to 64 rpm:\n");
+    printf("    KP in Q16: %.3e V\n", worst16);
+    printf("    KP in Q24: %.3e V\n  ", worst24);
+
+    // With KP in Q24 the error is almost all from rounding the Q16 result
+    assert(worst24 <= 0.5 / 65536.0 + 64.0 * 0.5 / 16777216.0);
+    assert(worst16 > 10 * worst24);
+}
+
+// Uniformly distributed raw value of the given number of bits
+static int32_t randomRaw(int bits) {
+    uint32_t r = ((uint32_t)rand() << 16) ^ ((uint32_t)rand() << 8) ^ (uint32_t)rand();
+    if (bits >= 32)
+        return (int32_t)r;
+    return (int32_t)(r % ((uint32_t)1 << bits)) - (int32_t)((uint32_t)1 << (bits - 1));
+}
+
+// Clamp to the range of a signed integer of `bits` bits
+static dint_t clampReference(dint_t exact, int bits) {
+    dint_t max = ((dint_t)1 << (bits - 1)) - 1;
+    if (exact > max)
+        return max;
+    if (exact < -max - 1)
+        return -max - 1;
+    return exact;
+}
@@ -0,0 +1,428 @@
+/* fixPropertyTest.c
+ * Randomised differential tests of the fixed point library.
+ *
+ * Every fix_t operation is run on random operands and its result compared with
+ * the exact result calculated in long double, which holds the 64-bit products
+ * of fix_t values exactly. Operands are drawn to hit the cases hand-picked
+ * tests tend to miss: values at and next to FIX_MAX and FIX_MIN, powers of two
+ * and their neighbours (where rounding and overflow boundaries lie), and
+ * values of every magnitude.
+ *
+ * The number of cases for each operation and the random seed can be given on
+ * the command line:
+ *
+ *      fixPropertyTest [cases] [seed]
+ *
+ * A failure prints the operation, operands and expected and actual results,
+ * so that it can be reproduced with the same seed.
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team.
+ */
+
+#include "fix_t.h"
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define DEFAULT_CASES   1000000
+
+// Largest errors allowed for the functions which are not exact, in units of
+// the last place
+#define TRIG_TOLERANCE  1.5L
+#define ATAN2_TOLERANCE 1.0L
+
+static const long double lsb = 1.0L / CONVERSION_FACTOR;
+
+// The sine table is in Q16, so in formats with more fraction bits the trig
+// tolerance is in units of 2^-16
+static const long double trigUnit = Q_POINT < 16 ? 1.0L / CONVERSION_FACTOR : 1.0L / 65536;
+
+static uint64_t rngState;
+static long cases;
+
+static void test_FIX_POINT(void);
+static void test_fix2float(void);
+static void test_addSubtract(void);
+static void test_multiply(void);
+static void test_divide(void);
+static void test_sqrt(void);
+static void test_trig(void);
+static void test_atan2(void);
+static void test_dot(void);
+static void test_fir(void);
+static void test_macBlock(void);
+
+static uint32_t randomWord(void);
+static fix_t randomOperand(void);
+static long double clamp(long double exact);
+static bool inRange(long double exact);
+static void checkOperation(const char *name, fix_t x, fix_t y, fix_t actual,
+                           long double expected);
+static void checkFlags(const char *name, fix_t x, fix_t y, word_t expected);
+static void checkMultiply(fix_t x, fix_t y);
+
+int main(int argc, char **argv) {
+    cases = argc > 1 ? atol(argv[1]) : DEFAULT_CASES;
+    unsigned long seed = argc > 2 ? strtoul(argv[2], NULL, 0) : 1;
+    rngState = seed * 0x9E3779B97F4A7C15u + 1;
+
+    if (sizeof(long double) <= sizeof(double))
+        printf("Warning: long double is no wider than double, so large products are not exact\n");
+
+    printf("%ld cases per operation, seed %lu\n\n", cases, seed);
+
+    printf("Testing FIX_POINT() ... ");
+    test_FIX_POINT();
+    printf("Done!\n");
+
+    printf("Testing fix2float() ... ");
+    test_fix2float();
+    printf("Done!\n");
+
+    printf("Testing fixAdd() and fixSubtract() ... ");
+    test_addSubtract();
+    printf("Done!\n");
+
+    printf("Testing fixMultiply() ... ");
+    test_multiply();
+    printf("Done!\n");
+
+    printf("Testing fixDivide() ... ");
+    test_divide();
+    printf("Done!\n");
+
+    printf("Testing fixSqrt() ... ");
+    test_sqrt();
+    printf("Done!\n");
+
+    printf("Testing fixSin() and fixCos() ... ");
+    test_trig();
+    printf("Done!\n");
+
+    printf("Testing fixAtan2() ... ");
+    test_atan2();
+    printf("Done!\n");
+
+    printf("Testing fixDot() ... ");
+    test_dot();
+    printf("Done!\n");
+
+    printf("Testing fixFir() ... ");
+    test_fir();
+    printf("Done!\n");
+
+    printf("Testing fixMacBlock() ... ");
+    test_macBlock();
+    printf("Done!\n");
+
+    printf("\nAll tests completed successfully!\n");
+
+    return EXIT_SUCCESS;
+}
+
+static void test_FIX_POINT(void) {
+    // Rounded to the nearest value, with halves rounded away from zero
+    for (long i = 0; i < cases; i++) {
+        fix_t raw = randomOperand();
+        if (raw == FIX_MIN || raw == FIX_MAX)
+            continue;
+
+        // Values halfway between and just either side of representable values
+        int offset = (int)(randomWord() % 5) - 2;
+        double x = (raw + 0.25 * offset) / CONVERSION_FACTOR;
+        long double exact = roundl((long double)x * CONVERSION_FACTOR);
+
+        checkOperation("FIX_POINT", raw, offset, FIX_POINT(x), exact);
+    }
+}
+
+static void test_fix2float(void) {
+    // Correctly rounded, as scaling by a power of two is exact
+    for (long i = 0; i < cases; i++) {
+        fix_t x = randomOperand();
+        float expected = (float)(x * lsb);
+
+        if (fix2float(x) != expected) {
+            printf("\nfix2float(%ld): expected %.9g, got %.9g\n",
+                   (long)x, expected, fix2float(x));
+            exit(EXIT_FAILURE);
+        }
+    }
+}
+
+static void test_addSubtract(void) {
+    for (long i = 0; i < cases; i++) {
+        fix_t x = randomOperand(), y = randomOperand();
+
+        long double sum = (long double)x + y;
+        long double difference = (long double)x - y;
+
+        // The original operations return fixOverflow on overflow
+        checkOperation("fixAdd", x, y, fixAdd(x, y), inRange(sum) ? sum : fixOverflow);
+        checkOperation("fixSubtract", x, y, fixSubtract(x, y),
+                       inRange(difference) ? difference : fixOverflow);
+
+        fixStatusClear();
+        checkOperation("fixAddSat", x, y, fixAddSat(x, y), clamp(sum));
+        checkFlags("fixAddSat", x, y, inRange(sum) ? 0 : FIX_STATUS_ADD_OVERFLOW);
+
+        fixStatusClear();
+        checkOperation("fixSubtractSat", x, y, fixSubtractSat(x, y), clamp(difference));
+        checkFlags("fixSubtractSat", x, y,
+                   inRange(difference) ? 0 : FIX_STATUS_SUBTRACT_OVERFLOW);
+    }
+}
+
+static void test_multiply(void) {
+    // Products just either side of the limits, which random operands rarely
+    // give. The last is only in range in formats with at least 15 fraction
+    // bits.
+    const fix_t one = FIX_POINT(1.0);
+    const fix_t edges[][2] = {
+        { FIX_MAX, one }, { FIX_MAX, one + 1 }, { FIX_MIN, one },
+        { FIX_MIN, -one }, { FIX_MIN, one + 1 }, { (fix_t)1 << 30, (fix_t)1 << 16 }
+    };
+
+    for (size_t i = 0; i < sizeof(edges) / sizeof(edges[0]); i++)
+        checkMultiply(edges[i][0], edges[i][1]);
+
+    for (long i = 0; i < cases; i++)
+        checkMultiply(randomOperand(), randomOperand());
+}
+
+static void test_divide(void) {
+    // Quotients are truncated towards zero. The long double quotient is within
+    // 2^-32 of the exact one for results in range, and the fraction of an
+    // inexact quotient is at least 2^-31 from an integer, so truncating it
+    // gives the exact result.
+    for (long i = 0; i < cases; i++) {
+        fix_t x = randomOperand(), y = randomOperand();
+        if (y == 0)
+            continue;
+
+        long double quotient = truncl((long double)x * CONVERSION_FACTOR / y);
+
+        fixStatusClear();
+        checkOperation("fixDivide", x, y, fixDivide(x, y), clamp(quotient));
+        checkFlags("fixDivide", x, y, inRange(quotient) ? 0 : FIX_STATUS_DIVIDE_OVERFLOW);
+    }
+
+    fixStatusClear();
+    checkOperation("fixDivide", FIX_POINT(1), 0, fixDivide(FIX_POINT(1), 0), FIX_MAX);
+    checkFlags("fixDivide", FIX_POINT(1), 0, FIX_STATUS_DIVIDE_OVERFLOW);
+}
+
+static void test_sqrt(void) {
+    // Roots are rounded down
+    for (long i = 0; i < cases; i++) {
+        fix_t x = randomOperand();
+        if (x < 0)
+            x = -(x + 1);
+
+        long double root = floorl(sqrtl((long double)x * CONVERSION_FACTOR));
+        checkOperation("fixSqrt", x, 0, fixSqrt(x), root);
+    }
+
+    fixStatusClear();
+    checkOperation("fixSqrt", -1, 0, fixSqrt(-1), 0);
+    checkFlags("fixSqrt", -1, 0, FIX_STATUS_DOMAIN_ERROR);
+}
+
+static void test_trig(void) {
+    long double worst = 0.0L;
+
+    for (long i = 0; i < cases; i++) {
+        fix_t angle = randomOperand();
+        long double radians = angle * lsb;
+
+        long double sinError = fabsl(fixSin(angle) * lsb - sinl(radians));
+        long double cosError = fabsl(fixCos(angle) * lsb - cosl(radians));
+
+        if (sinError > TRIG_TOLERANCE * trigUnit)
+            checkOperation("fixSin", angle, 0, fixSin(angle), sinl(radians) * CONVERSION_FACTOR);
+        if (cosError > TRIG_TOLERANCE * trigUnit)
+            checkOperation("fixCos", angle, 0, fixCos(angle), cosl(radians) * CONVERSION_FACTOR);
+
+        worst = fmaxl(worst, fmaxl(sinError, cosError));
+    }
+
+    printf("(largest error %.2Lf LSB) ", worst / lsb);
+}
+
+static void test_atan2(void) {
+    long double worst = 0.0L;
+
+    for (long i = 0; i < cases; i++) {
+        fix_t x = randomOperand(), y = randomOperand();
+        if (x == 0 && y == 0)
+            continue;
+
+        long double exact = atan2l((long double)y, (long double)x);
+        long double error = fabsl(fixAtan2(y, x) * lsb - exact);
+
+        if (error > ATAN2_TOLERANCE * lsb)
+            checkOperation("fixAtan2", y, x, fixAtan2(y, x), exact * CONVERSION_FACTOR);
+
+        worst = fmaxl(worst, error);
+    }
+
+    printf("(largest error %.2Lf LSB) ", worst / lsb);
+}
+
+static void test_dot(void) {
+    fix_t x[64], y[64];
+
+    for (long i = 0; i < cases / 16; i++) {
+        // The accumulator must not overflow (see fix_t.h), which holds for
+        // up to four products of values within +/- 2^14, or up to 64 products
+        // of values within +/- 128.0. Both sums are exact in long double.
+        bool fullRange = randomWord() & 1;
+        uint32_t length = randomWord() % (fullRange ? 5 : 65);
+
+        long double sum = 0.0L;
+        for (uint32_t j = 0; j < length; j++) {
+            x[j] = fullRange ? randomOperand() >> 1 : (fix_t)(randomWord() >> 8) - (1 << 23);
+            y[j] = fullRange ? randomOperand() >> 1 : (fix_t)(randomWord() >> 8) - (1 << 23);
+            sum += (long double)x[j] * y[j];
+        }
+        long double exact = clamp(floorl(sum * lsb));
+
+        fixStatusClear();
+        checkOperation("fixDot", length ? x[0] : 0, length, fixDot(x, y, length), exact);
+        checkFlags("fixDot", length ? x[0] : 0, length,
+                   inRange(floorl(sum * lsb)) ? 0 : FIX_STATUS_ACCUMULATE_OVERFLOW);
+    }
+}
+
+static void test_fir(void) {
+    enum { MAX_TAPS = 16, LENGTH = 64 };
+    fix_t coeffs[MAX_TAPS], input[LENGTH], output[LENGTH];
+
+    for (long i = 0; i < cases / (16 * LENGTH) + 1; i++) {
+        uint32_t numTaps = 1 + randomWord() % MAX_TAPS;
+        for (uint32_t k = 0; k < numTaps; k++)
+            coeffs[k] = (fix_t)(randomWord() >> 12) - (1 << 19);
+        for (int n = 0; n < LENGTH; n++)
+            input[n] = randomOperand() >> (randomWord() % 16);
+
+        // Filter in random blocks
+        fix_t state[MAX_TAPS - 1] = { 0 };
+        uint32_t start = 0;
+        while (start < LENGTH) {
+            uint32_t block = 1 + randomWord() % (LENGTH - start);
+            fixFir(coeffs, state, numTaps, &input[start], &output[start], block);
+            start += block;
+        }
+
+        // Each output is the dot product of the coefficients with the last
+        // numTaps inputs, newest first
+        for (int n = 0; n < LENGTH; n++) {
+            long double sum = 0.0L;
+            for (uint32_t k = 0; k < numTaps && (int)k <= n; k++)
+                sum += (long double)coeffs[k] * input[n - k];
+
+            checkOperation("fixFir", n, (fix_t)numTaps, output[n], clamp(floorl(sum * lsb)));
+        }
+    }
+}
+
+static void test_macBlock(void) {
+    enum { LENGTH = 16 };
+    fix_t acc[LENGTH], x[LENGTH], y[LENGTH];
+    long double expected[LENGTH];
+
+    for (long i = 0; i < cases / LENGTH; i++) {
+        for (int j = 0; j < LENGTH; j++) {
+            acc[j] = randomOperand();
+            x[j] = randomOperand();
+            y[j] = randomOperand();
+            expected[j] = clamp(floorl(acc[j] + (long double)x[j] * y[j] * lsb));
+        }
+
+        fixMacBlock(acc, x, y, LENGTH);
+
+        for (int j = 0; j < LENGTH; j++)
+            checkOperation("fixMacBlock", x[j], y[j], acc[j], expected[j]);
+    }
+}
+
+// xorshift64*, so that a seed gives the same cases on every host
+static uint32_t randomWord(void) {
+    rngState ^= rngState >> 12;
+    rngState ^= rngState << 25;
+    rngState ^= rngState >> 27;
+    return (uint32_t)((rngState * 0x2545F4914F6CDD1Du) >> 32);
+}
+
+// Operand drawn from one of several distributions which favour the edges of
+// the range and the boundaries of rounding and overflow
+static fix_t randomOperand(void) {
+    uint32_t r = randomWord();
+    int32_t small = (int32_t)(randomWord() % 9) - 4;
+    int shift = (int)(randomWord() % 31);
+
+    switch (r % 6) {
+    case 0:     // Any value
+        return (fix_t)randomWord();
+    case 1:     // At and below the largest value
+        return FIX_MAX - (fix_t)(randomWord() % 256);
+    case 2:     // At and above the smallest value
+        return FIX_MIN + (fix_t)(randomWord() % 256);
+    case 3:     // Next to a power of two, of either sign
+        return (fix_t)(((word_t)1 << shift) + (word_t)small) * ((r >> 8) & 1 ? -1 : 1);
+    case 4:     // Any magnitude
+        return (fix_t)randomWord() >> shift;
+    default:    // Around the magnitudes whose products just overflow (2^23.5)
+        return (fix_t)((randomWord() % (1 << 24)) + (1 << 23)) * ((r >> 8) & 1 ? -1 : 1);
+    }
+}
+
+static long double clamp(long double exact) {
+    if (exact > FIX_MAX)
+        return FIX_MAX;
+    if (exact < FIX_MIN)
+        return FIX_MIN;
+    return exact;
+}
+
+static bool inRange(long double exact) {
+    return exact >= FIX_MIN && exact <= FIX_MAX;
+}
+
+static void checkOperation(const char *name, fix_t x, fix_t y, fix_t actual,
+                           long double expected) {
+    if ((long double)actual == expected)
+        return;
+
+    printf("\n%s(%ld, %ld): expected %.3Lf, got %ld\n",
+           name, (long)x, (long)y, expected, (long)actual);
+    exit(EXIT_FAILURE);
+}
+
+static void checkFlags(const char *name, fix_t x, fix_t y, word_t expected) {
+    if (fixStatusGet() == expected)
+        return;
+
+    printf("\n%s(%ld, %ld): expected status 0x%02lx, got 0x%02lx\n",
+           name, (long)x, (long)y, (unsigned long)expected, (unsigned long)fixStatusGet());
+    exit(EXIT_FAILURE);
+}
+
+// Products are truncated towards negative infinity
+static void checkMultiply(fix_t x, fix_t y) {
+    long double product = floorl((long double)x * y * lsb);
+
+    checkOperation("fixMultiply", x, y, fixMultiply(x, y),
+                   inRange(product) ? product : fixOverflow);
+
+    fixStatusClear();
+    checkOperation("fixMultiplySat", x, y, fixMultiplySat(x, y), clamp(product));
+    checkFlags("fixMultiplySat", x, y,
+               inRange(product) ? 0 : FIX_STATUS_MULTIPLY_OVERFLOW);
+}
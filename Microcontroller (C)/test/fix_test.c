@@ -26,6 +26,16 @@ static void test_FIX_POINT(void);
 static void test_fixAdd(void);
 static void test_fixSubtract(void);
 static void test_fixMultiply(void);
+static void test_fixAddSat(void);
+static void test_fixSubtractSat(void);
+static void test_fixMultiplySat(void);
+static void test_fixStatus(void);
+static void test_fixDot(void);
+static void test_fixFir(void);
+static void test_fixMacBlock(void);
+static void test_fixDivide(void);
+static void test_fixSqrt(void);
+static void test_fixTrig(void);
 
 int main(void) {
     printf("Testing FIX_POINT() ... ");
@@ -44,6 +54,46 @@ int main(void) {
     test_fixMultiply();
     printf("Done!\n");
 
+    printf("Testing fixAddSat() ... ");
+    test_fixAddSat();
+    printf("Done!\n");
+
+    printf("Testing fixSubtractSat() ... ");
+    test_fixSubtractSat();
+    printf("Done!\n");
+
+    printf("Testing fixMultiplySat() ... ");
+    test_fixMultiplySat();
+    printf("Done!\n");
+
+    printf("Testing fixStatus ... ");
+    test_fixStatus();
+    printf("Done!\n");
+
+    printf("Testing fixDot() ... ");
+    test_fixDot();
+    printf("Done!\n");
+
+    printf("Testing fixFir() ... ");
+    test_fixFir();
+    printf("Done!\n");
+
+    printf("Testing fixMacBlock() ... ");
+    test_fixMacBlock();
+    printf("Done!\n");
+
+    printf("Testing fixDivide() ... ");
+    test_fixDivide();
+    printf("Done!\n");
+
+    printf("Testing fixSqrt() ... ");
+    test_fixSqrt();
+    printf("Done!\n");
+
+    printf("Testing fixSin(), fixCos() and fixAtan2() ... ");
+    test_fixTrig();
+    printf("Done!\n");
+
     printf("\nAll tests completed successfully!\n");
 
     return EXIT_SUCCESS;
@@ -162,6 +212,171 @@ static void test_fixMultiply(void) {
     assert(overflowNeg == fixOverflow);
 }
 
+static void test_fixAddSat(void) {
+    fixStatusClear();
+
+    assert(fixAddSat(FIX_POINT(123), FIX_POINT(362)) == FIX_POINT(485));
+    assert(fixAddSat(FIX_POINT(-827), FIX_POINT(-21)) == FIX_POINT(-848));
+    assert(fixAddSat(FIX_POINT(-2379), FIX_POINT(389)) == FIX_POINT(-1990));
+    assert(fixAddSat(FIX_POINT(-92.0625), FIX_POINT(-18.0078125)) == FIX_POINT(-110.0703125));
+
+    // The most negative value is a valid result
+    assert(fixAddSat(FIX_MIN + 1, -1) == FIX_MIN);
+    assert(fixStatusGet() == 0);
+
+    assert(fixAddSat(FIX_POINT(30000), FIX_POINT(30000)) == FIX_MAX);
+    assert(fixAddSat(FIX_MAX, 1) == FIX_MAX);
+    assert(fixStatusGet() == FIX_STATUS_ADD_OVERFLOW);
+
+    fixStatusClear();
+    assert(fixAddSat(FIX_POINT(-30000), FIX_POINT(-30000)) == FIX_MIN);
+    assert(fixAddSat(FIX_MIN, FIX_MIN) == FIX_MIN);
+    assert(fixStatusGet() == FIX_STATUS_ADD_OVERFLOW);
+}
+
+static void test_fixSubtractSat(void) {
+    fixStatusClear();
+
+    assert(fixSubtractSat(FIX_POINT(123), FIX_POINT(362)) == FIX_POINT(-239));
+    assert(fixSubtractSat(FIX_POINT(389), FIX_POINT(-2379)) == FIX_POINT(2768));
+    assert(fixSubtractSat(FIX_POINT(1.3), FIX_POINT(1.7)) == FIX_POINT(-0.4));
+    assert(fixSubtractSat(-1, FIX_MAX) == FIX_MIN);
+    assert(fixStatusGet() == 0);
+
+    assert(fixSubtractSat(FIX_POINT(30000), FIX_POINT(-30000)) == FIX_MAX);
+    assert(fixSubtractSat(0, FIX_MIN) == FIX_MAX);
+    assert(fixStatusGet() == FIX_STATUS_SUBTRACT_OVERFLOW);
+
+    fixStatusClear();
+    assert(fixSubtractSat(FIX_POINT(-30000), FIX_POINT(30000)) == FIX_MIN);
+    assert(fixStatusGet() == FIX_STATUS_SUBTRACT_OVERFLOW);
+}
+
+static void test_fixMultiplySat(void) {
+    fixStatusClear();
+
+    assert(fixMultiplySat(FIX_POINT(36), FIX_POINT(29)) == FIX_POINT(1044));
+    assert(fixMultiplySat(FIX_POINT(-100), FIX_POINT(-100)) == FIX_POINT(10000));
+    assert(fixMultiplySat(FIX_POINT(324), FIX_POINT(-89)) == FIX_POINT(-28836));
+    assert(fixMultiplySat(FIX_POINT(0.25), FIX_POINT(23.5)) == FIX_POINT(5.875));
+    assert(fixMultiplySat(FIX_POINT(100), FIX_POINT(0.1)) == FIX_POINT(10.0006103515625));
+    assert(fixMultiplySat(FIX_POINT(-16384), FIX_POINT(2)) == FIX_MIN);
+    assert(fixStatusGet() == 0);
+
+    assert(fixMultiplySat(FIX_POINT(2000), FIX_POINT(5000)) == FIX_MAX);
+    assert(fixMultiplySat(FIX_MIN, FIX_MIN) == FIX_MAX);
+    assert(fixMultiplySat(FIX_POINT(16384), FIX_POINT(2)) == FIX_MAX);
+    assert(fixStatusGet() == FIX_STATUS_MULTIPLY_OVERFLOW);
+
+    fixStatusClear();
+    assert(fixMultiplySat(FIX_POINT(-2000), FIX_POINT(5000)) == FIX_MIN);
+    assert(fixMultiplySat(FIX_MAX, FIX_MIN) == FIX_MIN);
+    assert(fixStatusGet() == FIX_STATUS_MULTIPLY_OVERFLOW);
+}
+
+static void test_fixStatus(void) {
+    fixStatusClear();
+
+    // Flags stay set through later operations which do not overflow
+    fixAddSat(FIX_MAX, FIX_MAX);
+    fixMultiplySat(FIX_MAX, FIX_MAX);
+    fixAddSat(1, 2);
+    fixSubtractSat(1, 2);
+    fixMultiplySat(1, 2);
+    assert(fixStatusGet() == (FIX_STATUS_ADD_OVERFLOW | FIX_STATUS_MULTIPLY_OVERFLOW));
+
+    fixStatusClear();
+    assert(fixStatusGet() == 0);
+}
+
+static void test_fixDot(void) {
+    const fix_t x[] = { FIX_POINT(1.5), FIX_POINT(-2), FIX_POINT(0.25), FIX_POINT(100) };
+    const fix_t y[] = { FIX_POINT(4), FIX_POINT(3.5), FIX_POINT(-8), FIX_POINT(0.01) };
+
+    assert(fixDot(x, y, 0) == 0);
+    assert(fixDot(x, y, 3) == FIX_POINT(-3));
+
+    // Only the sum is truncated, rather than each product
+    dint_t exact = ((dint_t)FIX_POINT(-3) << Q_POINT) + (dint_t)FIX_POINT(100) * FIX_POINT(0.01);
+    assert(fixDot(x, y, 4) == (fix_t)(exact >> Q_POINT));
+
+    const fix_t big[] = { FIX_POINT(20000), FIX_POINT(20000) };
+    const fix_t two[] = { FIX_POINT(1), FIX_POINT(1) };
+    fixStatusClear();
+    assert(fixDot(big, two, 2) == FIX_MAX);
+    assert(fixStatusGet() == FIX_STATUS_ACCUMULATE_OVERFLOW);
+}
+
+static void test_fixFir(void) {
+    // Moving average of three samples
+    const fix_t coeffs[] = { FIX_POINT(0.25), FIX_POINT(0.5), FIX_POINT(0.25) };
+    const fix_t input[] = { FIX_POINT(4), FIX_POINT(8), FIX_POINT(-4), FIX_POINT(12) };
+    fix_t state[2] = { 0 };
+    fix_t output[4];
+
+    fixFir(coeffs, state, 3, input, output, 3);
+    fixFir(coeffs, state, 3, &input[3], &output[3], 1);
+
+    assert(output[0] == FIX_POINT(1));
+    assert(output[1] == FIX_POINT(4));
+    assert(output[2] == FIX_POINT(4));
+    assert(output[3] == FIX_POINT(3));
+    assert(state[0] == FIX_POINT(-4) && state[1] == FIX_POINT(12));
+}
+
+static void test_fixMacBlock(void) {
+    fix_t acc[] = { FIX_POINT(1), FIX_POINT(-1), FIX_POINT(32000) };
+    const fix_t x[] = { FIX_POINT(2), FIX_POINT(0.5), FIX_POINT(100) };
+    const fix_t y[] = { FIX_POINT(3), FIX_POINT(-0.5), FIX_POINT(10) };
+
+    fixStatusClear();
+    fixMacBlock(acc, x, y, 3);
+
+    assert(acc[0] == FIX_POINT(7));
+    assert(acc[1] == FIX_POINT(-1.25));
+    assert(acc[2] == FIX_MAX);
+    assert(fixStatusGet() == FIX_STATUS_ACCUMULATE_OVERFLOW);
+}
+
+static void test_fixDivide(void) {
+    fixStatusClear();
+
+    assert(fixDivide(FIX_POINT(1044), FIX_POINT(29)) == FIX_POINT(36));
+    assert(fixDivide(FIX_POINT(-28836), FIX_POINT(324)) == FIX_POINT(-89));
+    assert(fixDivide(FIX_POINT(5.875), FIX_POINT(-0.25)) == FIX_POINT(-23.5));
+    assert(fixDivide(FIX_POINT(1), FIX_POINT(3)) == FIX_POINT(1) / 3);
+    assert(fixDivide(FIX_POINT(-1), FIX_POINT(3)) == -(FIX_POINT(1) / 3));
+    assert(fixDivide(FIX_MIN, FIX_POINT(1)) == FIX_MIN);
+    assert(fixStatusGet() == 0);
+
+    assert(fixDivide(FIX_POINT(20000), FIX_POINT(0.5)) == FIX_MAX);
+    assert(fixDivide(FIX_MIN, -FIX_POINT(1)) == FIX_MAX);
+    assert(fixDivide(FIX_POINT(-1), 0) == FIX_MIN);
+    assert(fixStatusGet() == FIX_STATUS_DIVIDE_OVERFLOW);
+}
+
+static void test_fixSqrt(void) {
+    assert(fixSqrt(0) == 0);
+    assert(fixSqrt(FIX_POINT(1)) == FIX_POINT(1));
+    assert(fixSqrt(FIX_POINT(16384)) == FIX_POINT(128));
+    assert(fixSqrt(FIX_POINT(0.0625)) == FIX_POINT(0.25));
+    assert(fixSqrt(FIX_POINT(2)) == 92681);         // floor(sqrt(2) * 2^16)
+    assert(fixSqrt(1) == 256);
+}
+
+static void test_fixTrig(void) {
+    assert(fixSin(0) == 0);
+    assert(fixSin(FIX_HALF_PI) == FIX_POINT(1) - 1);
+    assert(abs(fixSin(FIX_POINT(0.5235987756)) - FIX_POINT(0.5)) <= 1);    // 30 degrees
+    assert(abs(fixCos(FIX_PI) + FIX_POINT(1)) <= 1);
+    assert(abs(fixSin(-FIX_PI / 4) + FIX_POINT(0.70710678)) <= 1);
+
+    assert(fixAtan2(0, FIX_POINT(5)) == 0);
+    assert(abs(fixAtan2(FIX_POINT(1), FIX_POINT(1)) - FIX_PI / 4) <= 1);
+    assert(abs(fixAtan2(FIX_POINT(3), FIX_POINT(-3)) - 3 * FIX_PI / 4) <= 1);
+    assert(abs(fixAtan2(FIX_POINT(-1), 0) + FIX_HALF_PI) <= 1);
+}
+
 #ifdef DEBUG_TOOLS
 static void fixPrint(fix_t x) {
     double decimal = (double)x / pow(2, Q_POINT);
@@ -0,0 +1,410 @@
+/* gainScheduleTest.c
+ * Tests for the gain scheduled PID controller.
+ *
+ * The simulated motor has a time constant which grows with speed, as in
+ * MotorParameters.h. A table is designed for it with rlsTunePid(), and the
+ * generated table is checked against it. The interpolation is checked against
+ * a small hand-written table. The controller is then run with the simulated
+ * motor, and the step responses at low and high speed are compared with those
+ * of fixed gains. The same table is then built
+ * up from the models identified at each breakpoint, as in system.c with
+ * ONLINE_IDENTIFICATION. Finally the cost of a step is compared with
+ * runControlAlgorithm().
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team.
+ */
+
+#include "benchmark.h"
+
+#include "GainSchedule.h"
+#include "RLSEstimator.h"
+#include "PIDController.h"
+
+#include "MotorParameters.h"
+#include "ControllerParameters.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define NUM_SAMPLES     1000
+#define NUM_REPEATS     200
+
+// Table designed for the simulated motor
+#define TEST_POINTS     9
+#define TEST_SPACING    (DC_GAIN * OUTPUT_MAX / (TEST_POINTS - 1))
+
+// Operating points of the step responses (in rpm)
+#define LOW_SPEED       20.0f
+#define HIGH_SPEED      220.0f
+#define STEP_SIZE       10.0f
+
+// Breakpoints identified on the board, after the first, and the time spent at
+// each (several times the memory of the estimator)
+#define IDENTIFIED_POINTS   6
+#define IDENTIFY_SAMPLES    (30 * (int)FS)
+
+// Largest relative error of the identified gains
+#define IDENTIFY_TOLERANCE  0.15f
+
+volatile float setpointReg, feedbackReg, controlReg;
+
+static struct gainSchedulePoint testTable[TEST_POINTS];
+
+static float setpoints[NUM_SAMPLES];
+static float feedbacks[NUM_SAMPLES];
+
+static void test_generatedTable(void);
+static void test_interpolation(void);
+static void test_continuity(void);
+static void test_closedLoop(void);
+static void test_identification(void);
+static void measureCycles(void);
+
+static void designTestTable(void);
+static float timeConstantAt(float speed);
+static float overshoot(struct gainSchedule *schedule, float start);
+
+int main(void) {
+    printf("Testing generated table ... ");
+    test_generatedTable();
+    printf("Done!\n");
+
+    printf("Testing interpolation ... ");
+    test_interpolation();
+    printf("Done!\n");
+
+    printf("Testing continuity ... ");
+    test_continuity();
+    printf("Done!\n");
+
+    printf("Testing closed loop ... ");
+    test_closedLoop();
+    printf("Done!\n");
+
+    printf("Testing identification ... ");
+    test_identification();
+    printf("Done!\n");
+
+    printf("\nAll tests completed successfully!\n\n");
+
+    measureCycles();
+
+    return EXIT_SUCCESS;
+}
+
+static void test_generatedTable(void) {
+    designTestTable();
+
+    struct pidController pid;
+    struct pidParameters params = PID_DEFAULT_PARAMETERS;
+    pidInit(&pid, &params, &setpointReg, &feedbackReg, &controlReg);
+
+    struct gainSchedule schedule;
+    gainScheduleInit(&schedule, &pid, &feedbackReg);
+
+    // The table is generated from the same models, and starts from the
+    // nominal gains at rest
+    assert(GAIN_SCHEDULE_POINTS == TEST_POINTS);
+    assert(fabsf(GAIN_SCHEDULE_SPACING - (float)TEST_SPACING) < 1E-4f);
+    assert(fabsf(schedule.table[0].kp - KP) < 1E-6f);
+    assert(schedule.table[TEST_POINTS - 1].kp > 2.0f * KP);
+
+    for (uint32_t i = 0; i < schedule.numPoints; i++) {
+        assert(fabsf(schedule.table[i].kp / testTable[i].kp - 1.0f) < 1E-4f);
+        assert(fabsf(schedule.table[i].intCoeff / testTable[i].intCoeff - 1.0f) < 1E-4f);
+        assert(fabsf(schedule.table[i].kpSlope - testTable[i].kpSlope) < 1E-6f);
+        assert(fabsf(schedule.table[i].intCoeffSlope - testTable[i].intCoeffSlope) < 1E-6f);
+        assert(schedule.table[i].derCoeff1 == testTable[i].derCoeff1);
+    }
+}
+
+static void test_interpolation(void) {
+    struct gainSchedulePoint table[3] = {
+        { 1.0f, 0.1f, 0.0f,  1.0f,  0.1f, 0.5f },
+        { 2.0f, 0.2f, 0.5f, -1.0f, -0.2f, 0.0f },
+        { 1.0f, 0.0f, 0.5f,  0.0f,  0.0f, 0.0f }
+    };
+
+    struct pidController pid;
+    struct pidParameters params = PID_DEFAULT_PARAMETERS;
+    pidInit(&pid, &params, &setpointReg, &feedbackReg, &controlReg);
+
+    volatile float variable;
+    struct gainSchedule schedule;
+    gainScheduleInit(&schedule, &pid, &variable);
+    schedule.table = table;
+    schedule.numPoints = 3;
+    schedule.inverseSpacing = 1.0f / 10.0f;
+
+    // { variable, kp, intCoeff, derCoeff1 }
+    const float expected[][4] = {
+        {   0.0f, 1.0f,  0.1f,  0.0f  },
+        {   2.5f, 1.25f, 0.125f, 0.125f },
+        {  10.0f, 2.0f,  0.2f,  0.5f  },
+        { -15.0f, 1.5f,  0.1f,  0.5f  },    // Magnitude of the variable
+        {  20.0f, 1.0f,  0.0f,  0.5f  },
+        { 500.0f, 1.0f,  0.0f,  0.5f  }     // Held beyond the last breakpoint
+    };
+
+    setpointReg = 0.0f;
+    feedbackReg = 0.0f;
+
+    for (size_t i = 0; i < sizeof(expected) / sizeof(expected[0]); i++) {
+        variable = expected[i][0];
+        runGainScheduledAlgorithm(&schedule);
+
+        const struct pidCoefficients *coeffs = pidActiveCoefficients(&pid);
+        assert(fabsf(coeffs->kp - expected[i][1]) < 1E-6f);
+        assert(fabsf(coeffs->intCoeff - expected[i][2]) < 1E-6f);
+        assert(fabsf(coeffs->derCoeff1 - expected[i][3]) < 1E-6f);
+    }
+}
+
+static void test_continuity(void) {
+    designTestTable();
+
+    struct pidController pid;
+    struct pidParameters params = PID_DEFAULT_PARAMETERS;
+    pidInit(&pid, &params, &setpointReg, &feedbackReg, &controlReg);
+
+    volatile float variable = 0.0f;
+    struct gainSchedule schedule;
+    gainScheduleInit(&schedule, &pid, &variable);
+    schedule.table = testTable;
+    schedule.numPoints = TEST_POINTS;
+    schedule.inverseSpacing = 1.0f / TEST_SPACING;
+
+    setpointReg = 30.0f;
+    feedbackReg = 20.0f;
+    float previous = runGainScheduledAlgorithm(&schedule);
+
+    // With the same error, the control signal only changes by the new integral
+    // term when the gains change
+    variable = 4.5f * TEST_SPACING;
+    float current = runGainScheduledAlgorithm(&schedule);
+    float error = setpointReg - feedbackReg;
+
+    assert(pidActiveCoefficients(&pid)->kp != testTable[0].kp);
+    assert(fabsf(current - previous - pidActiveCoefficients(&pid)->intCoeff * error) < 1E-5f);
+}
+
+static void test_closedLoop(void) {
+    designTestTable();
+
+    struct pidController pid;
+    struct pidParameters params = PID_DEFAULT_PARAMETERS;
+    pidInit(&pid, &params, &setpointReg, &feedbackReg, &controlReg);
+
+    struct gainSchedule scheduled;
+    gainScheduleInit(&scheduled, &pid, &setpointReg);
+    scheduled.table = testTable;
+    scheduled.numPoints = TEST_POINTS;
+    scheduled.inverseSpacing = 1.0f / TEST_SPACING;
+
+    // A single breakpoint holds the nominal gains at every speed
+    struct gainSchedulePoint nominal = {
+        KP, INT_COEFF, DER_COEFF1, 0.0f, 0.0f, 0.0f
+    };
+    struct gainSchedule fixed = scheduled;
+    fixed.table = &nominal;
+    fixed.numPoints = 1;
+
+    float scheduledLow = overshoot(&scheduled, LOW_SPEED);
+    float scheduledHigh = overshoot(&scheduled, HIGH_SPEED);
+    float fixedLow = overshoot(&fixed, LOW_SPEED);
+    float fixedHigh = overshoot(&fixed, HIGH_SPEED);
+
+    printf("\n  Overshoot at %.0f/%.0f rpm: %.1f%%/%.1f%% fixed, %.1f%%/%.1f%% scheduled\n  ",
+           LOW_SPEED, HIGH_SPEED, 100.0 * fixedLow, 100.0 * fixedHigh,
+           100.0 * scheduledLow, 100.0 * scheduledHigh);
+
+    // The scheduled gains give a similar response at both speeds
+    assert(fabsf(scheduledHigh - scheduledLow) < 0.5f * fabsf(fixedHigh - fixedLow));
+}
+
+static void test_identification(void) {
+    designTestTable();
+
+    struct pidController pid;
+    struct pidParameters params = PID_DEFAULT_PARAMETERS;
+    pidInit(&pid, &params, &setpointReg, &feedbackReg, &controlReg);
+
+    // Start from a copy of the generated table with the nominal gains at every
+    // breakpoint, as generated without models at several speeds
+    struct gainSchedule schedule;
+    gainScheduleInit(&schedule, &pid, &setpointReg);
+
+    struct gainSchedulePoint learned[GAIN_SCHEDULE_POINTS];
+    for (uint32_t i = 0; i < GAIN_SCHEDULE_POINTS; i++) {
+        learned[i] = schedule.table[0];
+        learned[i].kpSlope = 0.0f;
+        learned[i].intCoeffSlope = 0.0f;
+    }
+    schedule.table = learned;
+
+    struct rlsEstimator rls;
+    rlsInit(&rls, DC_GAIN, TIME_CONSTANT, FS, RLS_FORGETTING);
+
+    // Hold the speed about each breakpoint in turn, stepping the setpoint
+    // every second for excitation, and retune as in system.c
+    float speed = 0.0f;
+    for (uint32_t point = 1; point <= IDENTIFIED_POINTS; point++) {
+        for (int i = 0; i < IDENTIFY_SAMPLES; i++) {
+            float step = (i / (int)FS) % 2 ? 0.5f * STEP_SIZE : -0.5f * STEP_SIZE;
+            setpointReg = point * GAIN_SCHEDULE_SPACING + step;
+
+            feedbackReg = speed;
+            rlsUpdate(&rls, controlReg, feedbackReg);
+            runGainScheduledAlgorithm(&schedule);
+
+            float tau = timeConstantAt(speed);
+            speed = (tau * speed + TS * DC_GAIN * controlReg) / (TS + tau);
+
+            float dcGain, timeConstant;
+            if ((i + 1) % RLS_RETUNE_SAMPLES == 0 &&
+                rlsGetModel(&rls, FS, &dcGain, &timeConstant)) {
+                struct pidParameters tuned;
+                rlsTunePid(&params, DC_GAIN, TIME_CONSTANT, dcGain, timeConstant,
+                           &tuned);
+                assert(gainScheduleRetune(&schedule, feedbackReg, &tuned));
+            }
+        }
+    }
+
+    // The interrupt writes the last update into the table
+    assert(schedule.updatePending);
+    runGainScheduledAlgorithm(&schedule);
+    assert(!schedule.updatePending);
+
+    // The identified breakpoints approach the design for the simulated motor,
+    // and the others keep the nominal gains
+    for (uint32_t i = 0; i < GAIN_SCHEDULE_POINTS; i++) {
+        if (i >= 1 && i <= IDENTIFIED_POINTS) {
+            assert(fabsf(learned[i].kp / testTable[i].kp - 1.0f) < IDENTIFY_TOLERANCE);
+            assert(fabsf(learned[i].intCoeff / testTable[i].intCoeff - 1.0f) < IDENTIFY_TOLERANCE);
+        } else {
+            assert(learned[i].kp == KP);
+        }
+    }
+
+    // The slopes join the breakpoints
+    for (uint32_t i = 0; i < GAIN_SCHEDULE_POINTS - 1; i++)
+        assert(fabsf(learned[i].kp + learned[i].kpSlope - learned[i + 1].kp) < 1E-6f);
+
+    // Nothing beyond the table is retuned
+    assert(!gainScheduleRetune(&schedule, GAIN_SCHEDULE_POINTS * GAIN_SCHEDULE_SPACING,
+                               &params));
+}
+
+static void measureCycles(void) {
+    struct pidController pid;
+    struct pidParameters params = PID_DEFAULT_PARAMETERS;
+    pidInit(&pid, &params, &setpointReg, &feedbackReg, &controlReg);
+
+    struct gainSchedule schedule;
+    gainScheduleInit(&schedule, &pid, &feedbackReg);
+
+    srand(1);
+    for (int i = 0; i < NUM_SAMPLES; i++) {
+        setpoints[i] = (float)(DC_GAIN * OUTPUT_MAX) * rand() / RAND_MAX;
+        feedbacks[i] = (float)(DC_GAIN * OUTPUT_MAX) * rand() / RAND_MAX;
+    }
+
+    uint64_t pidBest = UINT64_MAX, scheduledBest = UINT64_MAX;
+
+    for (int r = 0; r < NUM_REPEATS; r++) {
+        uint64_t start = benchTime();
+        for (int i = 0; i < NUM_SAMPLES; i++) {
+            setpointReg = setpoints[i];
+            feedbackReg = feedbacks[i];
+            runControlAlgorithm(&pid);
+        }
+        uint64_t elapsed = benchTime() - start;
+        if (elapsed < pidBest)
+            pidBest = elapsed;
+
+        start = benchTime();
+        for (int i = 0; i < NUM_SAMPLES; i++) {
+            setpointReg = setpoints[i];
+            feedbackReg = feedbacks[i];
+            runGainScheduledAlgorithm(&schedule);
+        }
+        elapsed = benchTime() - start;
+        if (elapsed < scheduledBest)
+            scheduledBest = elapsed;
+    }
+
+    printf("runControlAlgorithm:       %6.1f %s/step\n",
+           (double)pidBest / NUM_SAMPLES, BENCH_UNIT);
+    printf("runGainScheduledAlgorithm: %6.1f %s/step\n",
+           (double)scheduledBest / NUM_SAMPLES, BENCH_UNIT);
+}
+
+// Design a table for the simulated motor in the same way as
+// generate_gain_schedule.py
+static void designTestTable(void) {
+    struct pidParameters nominal = PID_DEFAULT_PARAMETERS;
+
+    for (int i = 0; i < TEST_POINTS; i++) {
+        struct pidParameters tuned;
+        rlsTunePid(&nominal, DC_GAIN, TIME_CONSTANT, DC_GAIN,
+                   timeConstantAt(i * TEST_SPACING), &tuned);
+
+        testTable[i].kp = tuned.kp;
+        testTable[i].intCoeff = tuned.ki * TS;
+        testTable[i].derCoeff1 = tuned.kd * N;
+    }
+
+    for (int i = 0; i < TEST_POINTS; i++) {
+        const struct gainSchedulePoint *next = &testTable[i < TEST_POINTS - 1 ? i + 1 : i];
+        testTable[i].kpSlope = next->kp - testTable[i].kp;
+        testTable[i].intCoeffSlope = next->intCoeff - testTable[i].intCoeff;
+        testTable[i].derCoeff1Slope = next->derCoeff1 - testTable[i].derCoeff1;
+    }
+}
+
+// The simulated motor has the nominal time constant at rest, rising linearly to
+// TIME_CONSTANT_FULL_SPEED at full speed
+static float timeConstantAt(float speed) {
+    return TIME_CONSTANT + (TIME_CONSTANT_FULL_SPEED - TIME_CONSTANT)
+                           * fabsf(speed) / (float)(DC_GAIN * OUTPUT_MAX);
+}
+
+// Overshoot of the response to a step of STEP_SIZE from a steady speed, as a
+// fraction of the step
+static float overshoot(struct gainSchedule *schedule, float start) {
+    struct pidController *pid = schedule->pid;
+    struct pidParameters params = PID_DEFAULT_PARAMETERS;
+    pidInit(pid, &params, &setpointReg, &feedbackReg, &controlReg);
+
+    // Start in steady state
+    float speed = start;
+    setpointReg = start;
+    feedbackReg = start;
+    pid->integrator = start / DC_GAIN;
+    pid->prevError = 0.0f;
+
+    // Load the gains for the starting speed with no error
+    runGainScheduledAlgorithm(schedule);
+
+    setpointReg = start + STEP_SIZE;
+    float peak = start;
+
+    for (int i = 0; i < NUM_SAMPLES; i++) {
+        feedbackReg = speed;
+        runGainScheduledAlgorithm(schedule);
+
+        float tau = timeConstantAt(speed);
+        speed = (tau * speed + TS * DC_GAIN * controlReg) / (TS + tau);
+
+        if (speed > peak)
+            peak = speed;
+    }
+
+    return (peak - setpointReg) / STEP_SIZE;
+}
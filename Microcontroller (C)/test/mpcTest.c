@@ -0,0 +1,281 @@
+/* mpcTest.c
+ * Tests for the explicit model predictive controller.
+ *
+ * The control signal from the region table is compared with the solution of
+ * the same constrained optimisation solved online, then the controller is run
+ * in closed loop with the simulated motor, both as modelled and with a
+ * different static gain and a load. Finally the cost of a step is compared
+ * with runControlAlgorithm().
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team.
+ */
+
+#include "benchmark.h"
+
+#include "ExplicitMPC.h"
+#include "PIDController.h"
+#include "Motor.h"
+
+#include "MotorParameters.h"
+#include "ControllerParameters.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define NUM_POINTS      10000
+#define NUM_SAMPLES     1000
+#define NUM_REPEATS     200
+
+#define QP_ITERATIONS   2000
+
+// Largest difference from the online solution (in V)
+#define TOLERANCE       1E-3
+
+// Range of speeds and setpoints covered by the table
+#define SPEED_LIMIT     (DC_GAIN * OUTPUT_MAX)
+
+// Mismatched motor: static gain relative to the model, and a load as a voltage
+// lost at its input
+#define GAIN_ERROR      0.8f
+#define LOAD            1.0f
+
+// Largest steady-state error with the mismatched motor (in rpm)
+#define OFFSET_TOLERANCE    0.01f
+
+volatile float setpointReg, feedbackReg, controlReg;
+
+static float setpoints[NUM_SAMPLES];
+static float feedbacks[NUM_SAMPLES];
+
+static void test_onlineSolution(void);
+static void test_closedLoop(void);
+static void test_modelMismatch(void);
+static void measureCycles(void);
+
+static double solveOnline(double w, double r, double d);
+static double randomIn(double limit);
+
+int main(void) {
+    printf("Testing against online solution ... ");
+    test_onlineSolution();
+    printf("Done!\n");
+
+    printf("Testing closed loop ... ");
+    test_closedLoop();
+    printf("Done!\n");
+
+    printf("Testing model mismatch ... ");
+    test_modelMismatch();
+    printf("Done!\n");
+
+    printf("\nAll tests completed successfully!\n\n");
+
+    measureCycles();
+
+    return EXIT_SUCCESS;
+}
+
+static void test_onlineSolution(void) {
+    struct mpcController mpc;
+    mpcInit(&mpc, &setpointReg, &feedbackReg, &controlReg);
+
+    srand(1);
+    for (int i = 0; i < NUM_POINTS; i++) {
+        double w = randomIn(SPEED_LIMIT);
+        double r = randomIn(SPEED_LIMIT);
+
+        // The table only covers disturbances for which the setpoint can be
+        // reached within the output limits
+        double d;
+        do {
+            d = randomIn(MPC_DISTURBANCE_LIMIT);
+        } while (r / DC_GAIN - d > OUTPUT_MAX || r / DC_GAIN - d < OUTPUT_MIN);
+
+        // Use the disturbance as it is, without an update from the previous
+        // sample
+        mpc.disturbance = (float)d;
+        mpc.started = false;
+
+        setpointReg = (float)r;
+        feedbackReg = (float)w;
+        double explicitSolution = runMpcAlgorithm(&mpc);
+
+        assert(fabs(explicitSolution - solveOnline(w, r, (float)d)) < TOLERANCE);
+    }
+}
+
+static void test_closedLoop(void) {
+    struct mpcController mpc;
+    mpcInit(&mpc, &setpointReg, &feedbackReg, &controlReg);
+
+    struct motor motor = {
+        .dcGain = DC_GAIN,
+        .timeConstant = TIME_CONSTANT,
+        .angularVelocity = 0.0f,
+        .coeffV = COEFF_V,
+        .coeffW = COEFF_W
+    };
+
+    // Steps as in system.c, plus a step large enough to saturate the output
+    const float steps[] = { 10.0f, 20.0f, 10.0f, 250.0f, -250.0f };
+
+    for (size_t s = 0; s < sizeof(steps) / sizeof(steps[0]); s++) {
+        setpointReg = steps[s];
+        for (int i = 0; i < NUM_SAMPLES / 4; i++) {
+            feedbackReg = motor.angularVelocity;
+            runMpcAlgorithm(&mpc);
+            assert(controlReg >= OUTPUT_MIN && controlReg <= OUTPUT_MAX);
+            calculateAngularVelocity(&motor, controlReg);
+        }
+
+        // The model matches the simulated motor exactly, so there is no
+        // steady-state error
+        assert(fabsf(motor.angularVelocity - steps[s]) < 0.01f * fabsf(steps[s]));
+    }
+}
+
+static void test_modelMismatch(void) {
+    struct mpcController mpc;
+    mpcInit(&mpc, &setpointReg, &feedbackReg, &controlReg);
+
+    struct motor motor = {
+        .dcGain = DC_GAIN * GAIN_ERROR,
+        .timeConstant = TIME_CONSTANT,
+        .angularVelocity = 0.0f,
+        .coeffV = COEFF_V * GAIN_ERROR,
+        .coeffW = COEFF_W
+    };
+
+    const float steps[] = { 10.0f, 20.0f, 10.0f, -20.0f };
+
+    for (size_t s = 0; s < sizeof(steps) / sizeof(steps[0]); s++) {
+        setpointReg = steps[s];
+        for (int i = 0; i < NUM_SAMPLES / 4; i++) {
+            feedbackReg = motor.angularVelocity;
+            runMpcAlgorithm(&mpc);
+            calculateAngularVelocity(&motor, controlReg - LOAD);
+        }
+
+        // Without the disturbance estimate the wrong steady-state voltage
+        // would leave an error of about 2.5 rpm
+        assert(fabsf(motor.angularVelocity - steps[s]) < OFFSET_TOLERANCE);
+    }
+
+    // Both errors are seen as one disturbance at the input of the motor
+    float expected = steps[3] / DC_GAIN - steps[3] / (DC_GAIN * GAIN_ERROR) - LOAD;
+    assert(fabsf(mpc.disturbance - expected) < 0.01f);
+}
+
+static void measureCycles(void) {
+    struct mpcController mpc;
+    mpcInit(&mpc, &setpointReg, &feedbackReg, &controlReg);
+
+    struct pidController pid;
+    struct pidParameters params = PID_DEFAULT_PARAMETERS;
+    pidInit(&pid, &params, &setpointReg, &feedbackReg, &controlReg);
+
+    // Random points so that the region changes every sample
+    for (int i = 0; i < NUM_SAMPLES; i++) {
+        setpoints[i] = (float)randomIn(SPEED_LIMIT);
+        feedbacks[i] = (float)randomIn(SPEED_LIMIT);
+    }
+
+    uint64_t pidBest = UINT64_MAX, mpcBest = UINT64_MAX, mpcWorst = 0;
+
+    for (int r = 0; r < NUM_REPEATS; r++) {
+        uint64_t start = benchTime();
+        for (int i = 0; i < NUM_SAMPLES; i++) {
+            setpointReg = setpoints[i];
+            feedbackReg = feedbacks[i];
+            runControlAlgorithm(&pid);
+        }
+        uint64_t elapsed = benchTime() - start;
+        if (elapsed < pidBest)
+            pidBest = elapsed;
+
+        start = benchTime();
+        for (int i = 0; i < NUM_SAMPLES; i++) {
+            setpointReg = setpoints[i];
+            feedbackReg = feedbacks[i];
+            runMpcAlgorithm(&mpc);
+        }
+        elapsed = benchTime() - start;
+        if (elapsed < mpcBest)
+            mpcBest = elapsed;
+    }
+
+    // Worst single step, where every region must be searched
+    for (int i = 0; i < NUM_SAMPLES; i++) {
+        uint64_t best = UINT64_MAX;
+        for (int r = 0; r < NUM_REPEATS / 10; r++) {
+            mpc.region = 0;
+            setpointReg = setpoints[i];
+            feedbackReg = feedbacks[i];
+
+            uint64_t start = benchTime();
+            runMpcAlgorithm(&mpc);
+            uint64_t elapsed = benchTime() - start;
+            if (elapsed < best)
+                best = elapsed;
+        }
+        if (best > mpcWorst)
+            mpcWorst = best;
+    }
+
+    printf("runControlAlgorithm:     %6.1f %s/step\n",
+           (double)pidBest / NUM_SAMPLES, BENCH_UNIT);
+    printf("runMpcAlgorithm:         %6.1f %s/step (random points)\n",
+           (double)mpcBest / NUM_SAMPLES, BENCH_UNIT);
+    printf("runMpcAlgorithm (worst): %6u %s/step, %d regions\n",
+           (unsigned)mpcWorst, BENCH_UNIT, MPC_NUM_REGIONS);
+}
+
+// Solve the optimisation described in generate_mpc_table.py by coordinate
+// descent, which converges for a convex quadratic cost with bounds on each
+// variable. Returns the first control signal.
+static double solveOnline(double w, double r, double d) {
+    const double a = COEFF_W, b = COEFF_V;
+    const int n = MPC_HORIZON;
+
+    double H[MPC_HORIZON][MPC_HORIZON] = { { 0 } };
+    double h[MPC_HORIZON] = { 0 };
+
+    for (int k = 0; k < n; k++) {
+        double weight = (k == n - 1) ? MPC_WEIGHT_P : MPC_WEIGHT_Q;
+        double phi = pow(a, k + 1);
+        for (int i = 0; i <= k; i++) {
+            double gi = pow(a, k - i) * b;
+            h[i] += weight * gi * phi;
+            for (int j = 0; j <= k; j++)
+                H[i][j] += weight * gi * pow(a, k - j) * b;
+        }
+    }
+    for (int i = 0; i < n; i++)
+        H[i][i] += MPC_WEIGHT_R;
+
+    double e0 = w - r;
+    double steady = r / DC_GAIN - d;
+    double upper = OUTPUT_MAX - steady, lower = OUTPUT_MIN - steady;
+
+    double v[MPC_HORIZON] = { 0 };
+    for (int it = 0; it < QP_ITERATIONS; it++) {
+        for (int i = 0; i < n; i++) {
+            double g = h[i] * e0;
+            for (int j = 0; j < n; j++)
+                if (j != i)
+                    g += H[i][j] * v[j];
+            v[i] = fmin(upper, fmax(lower, -g / H[i][i]));
+        }
+    }
+
+    return v[0] + steady;
+}
+
+static double randomIn(double limit) {
+    return limit * (2.0 * rand() / RAND_MAX - 1.0);
+}
@@ -0,0 +1,173 @@
+/* pidBankBenchmark.c
+ *
+ * Host benchmark comparing runPidBank() with calling runControlAlgorithm() once
+ * for each channel, for banks of 1 to 64 channels.
+ *
+ * For each bank size, every channel is first checked to give the same output
+ * as a separate controller over random inputs wide enough to saturate the
+ * outputs at both limits.
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team
+ */
+
+#include "benchmark.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "PIDController.h"
+#include "PIDBank.h"
+
+#include "ControllerParameters.h"
+
+#define MAX_CHANNELS    64
+#define NUM_SAMPLES     1000
+#define NUM_REPEATS     50
+
+// Samples of the comparison with separate controllers
+#define CHECK_SAMPLES   1000
+
+static const uint32_t channelCounts[] = { 1, 2, 4, 6, 8, 16, 32, 64 };
+
+static float setpoints[MAX_CHANNELS];
+static float feedbacks[MAX_CHANNELS];
+static float controls[MAX_CHANNELS];
+static float separateControls[MAX_CHANNELS];
+static float integrators[MAX_CHANNELS];
+static float differentiators[MAX_CHANNELS];
+static float prevErrors[MAX_CHANNELS];
+
+// Feedback for every sample and channel, pre-generated so that both methods
+// see identical inputs
+static float feedbackData[NUM_SAMPLES][MAX_CHANNELS];
+
+static struct pidController *createControllers(uint32_t numChannels,
+                                               float *controlSignals);
+static void checkChannels(struct pidBank *bank);
+
+int main(void) {
+    srand(1);
+    for (int s = 0; s < NUM_SAMPLES; s++)
+        for (int c = 0; c < MAX_CHANNELS; c++)
+            feedbackData[s][c] = 15.0f + (float)(rand() % 2000) / 100.0f - 10.0f;
+
+    for (int c = 0; c < MAX_CHANNELS; c++)
+        setpoints[c] = 10.0f + (float)c;
+
+    printf("channels  bank (%s/step)  separate (%s/step)  speedup\n",
+           BENCH_UNIT, BENCH_UNIT);
+
+    for (size_t n = 0; n < sizeof(channelCounts) / sizeof(channelCounts[0]); n++) {
+        uint32_t numChannels = channelCounts[n];
+
+        struct pidBank bank = {
+            .kp = KP,
+            .setWeightB = SW_B, .setWeightC = SW_C,
+            .outputMin = OUTPUT_MIN, .outputMax = OUTPUT_MAX,
+            .intCoeff = INT_COEFF,
+            .derCoeff1 = DER_COEFF1, .derCoeff2 = DER_COEFF2,
+
+            .numChannels = numChannels,
+
+            .setpoint = setpoints,
+            .feedback = feedbacks,
+            .controlSignal = controls,
+
+            .integrator = integrators,
+            .differentiator = differentiators,
+            .prevError = prevErrors
+        };
+
+        checkChannels(&bank);
+
+        struct pidController *pids = createControllers(numChannels, controls);
+
+        uint64_t bankBest = UINT64_MAX, separateBest = UINT64_MAX;
+
+        for (int r = 0; r < NUM_REPEATS; r++) {
+            uint64_t start = benchTime();
+            for (int s = 0; s < NUM_SAMPLES; s++) {
+                memcpy(feedbacks, feedbackData[s], numChannels * sizeof(float));
+                runPidBank(&bank);
+            }
+            uint64_t elapsed = benchTime() - start;
+            if (elapsed < bankBest)
+                bankBest = elapsed;
+
+            start = benchTime();
+            for (int s = 0; s < NUM_SAMPLES; s++) {
+                memcpy(feedbacks, feedbackData[s], numChannels * sizeof(float));
+                for (uint32_t c = 0; c < numChannels; c++)
+                    runControlAlgorithm(&pids[c]);
+            }
+            elapsed = benchTime() - start;
+            if (elapsed < separateBest)
+                separateBest = elapsed;
+        }
+
+        free(pids);
+
+        printf("%8u  %18.1f  %22.1f  %6.2fx\n", (unsigned)numChannels,
+               (double)bankBest / NUM_SAMPLES, (double)separateBest / NUM_SAMPLES,
+               (double)separateBest / (double)bankBest);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+// Run the bank and a separate controller for each channel on the same random
+// inputs, checking that every output is identical. The feedback ranges over
+// +/-400 rpm so that the outputs are clamped at both limits.
+static void checkChannels(struct pidBank *bank) {
+    uint32_t numChannels = bank->numChannels;
+    struct pidController *pids = createControllers(numChannels, separateControls);
+
+    memset(integrators, 0, sizeof(integrators));
+    memset(differentiators, 0, sizeof(differentiators));
+    memset(prevErrors, 0, sizeof(prevErrors));
+
+    uint32_t clampedMin = 0, clampedMax = 0;
+
+    for (int s = 0; s < CHECK_SAMPLES; s++) {
+        for (uint32_t c = 0; c < numChannels; c++)
+            feedbacks[c] = (float)(rand() % 80000) / 100.0f - 400.0f;
+
+        runPidBank(bank);
+        for (uint32_t c = 0; c < numChannels; c++)
+            runControlAlgorithm(&pids[c]);
+
+        for (uint32_t c = 0; c < numChannels; c++) {
+            assert(controls[c] == separateControls[c]);
+            clampedMin += (controls[c] == OUTPUT_MIN);
+            clampedMax += (controls[c] == OUTPUT_MAX);
+        }
+    }
+
+    assert(clampedMin > 0 && clampedMax > 0);
+
+    // The timing starts from rest
+    memset(integrators, 0, sizeof(integrators));
+    memset(differentiators, 0, sizeof(differentiators));
+    memset(prevErrors, 0, sizeof(prevErrors));
+
+    free(pids);
+}
+
+static struct pidController *createControllers(uint32_t numChannels,
+                                               float *controlSignals) {
+    struct pidController *pids = malloc(numChannels * sizeof(struct pidController));
+    if (pids == NULL)
+        exit(EXIT_FAILURE);
+
+    struct pidParameters params = PID_DEFAULT_PARAMETERS;
+
+    for (uint32_t c = 0; c < numChannels; c++)
+        pidInit(&pids[c], &params, &setpoints[c], &feedbacks[c], &controlSignals[c]);
+
+    return pids;
+}
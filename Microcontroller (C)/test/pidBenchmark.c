@@ -0,0 +1,161 @@
+/* pidBenchmark.c
+ *
+ * Host benchmark comparing the floating point and fixed point PID controllers.
+ *
+ * Both controllers are run in closed loop with the simulated motor to check
+ * that they agree, and the fixed point controller is checked to saturate when
+ * the error overflows. Then the cost of a single controller step is measured
+ * for each over the same recorded feedback signal.
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team
+ */
+
+#include "benchmark.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "PIDController.h"
+#include "Motor.h"
+
+#include "MotorParameters.h"
+#include "ControllerParameters.h"
+
+#define ZERO 0.0f
+
+#define NUM_SAMPLES     1000
+#define NUM_REPEATS     200
+
+// Largest difference allowed between the float and fixed point control
+// signals (in V). The fixed point controller differs only through rounding
+// its coefficients and truncating its products to Q16, which gives about
+// 2.4E-4 V over the closed loop steps.
+#define MAX_DIFFERENCE  1E-3f
+
+volatile float setpointReg, feedbackReg, controlReg;
+volatile fix_t fixSetpointReg, fixFeedbackReg, fixControlReg;
+
+static float setpoints[NUM_SAMPLES];
+static float feedbacks[NUM_SAMPLES];
+static fix_t fixSetpoints[NUM_SAMPLES];
+static fix_t fixFeedbacks[NUM_SAMPLES];
+
+int main(void) {
+    struct pidController pid;
+    struct pidParameters params = PID_DEFAULT_PARAMETERS;
+    pidInit(&pid, &params, &setpointReg, &feedbackReg, &controlReg);
+
+    struct fixPidController fixPid = {
+        .propCoeff1 = FIX_PROP_COEFF1, .propCoeff2 = FIX_PROP_COEFF2,
+        .intCoeff = FIX_INT_COEFF,
+        .derCoeff1 = FIX_DER_COEFF1, .derCoeff2 = FIX_DER_COEFF2,
+        .derCoeff3 = FIX_DER_COEFF3,
+        .outputMin = FIX_OUTPUT_MIN, .outputMax = FIX_OUTPUT_MAX,
+
+        .setpoint = &fixSetpointReg,
+        .feedback = &fixFeedbackReg,
+        .controlSignal = &fixControlReg,
+
+        .integrator = 0,
+        .differentiator = 0,
+        .prevError = 0
+    };
+
+    struct motor motor = {
+        .dcGain = DC_GAIN,
+        .timeConstant = TIME_CONSTANT,
+        .angularVelocity = ZERO,
+        .coeffV = COEFF_V,
+        .coeffW = COEFF_W
+    };
+
+    struct motor fixMotor = motor;
+
+    // Closed loop comparison
+    // -------------------------------------------------------------------------
+    // Step the setpoint between 10 and 20 rpm as in system.c
+    float maxDifference = 0.0f;
+
+    for (int i = 0; i < NUM_SAMPLES; i++) {
+        setpoints[i] = ((i / 100) % 2) ? 20.0f : 10.0f;
+
+        setpointReg = setpoints[i];
+        feedbackReg = motor.angularVelocity;
+        feedbacks[i] = feedbackReg;
+        fixSetpoints[i] = FIX_POINT(setpoints[i]);
+        fixFeedbacks[i] = FIX_POINT(feedbacks[i]);
+        runControlAlgorithm(&pid);
+        calculateAngularVelocity(&motor, controlReg);
+
+        fixSetpointReg = FIX_POINT(setpoints[i]);
+        fixFeedbackReg = FIX_POINT(fixMotor.angularVelocity);
+        runFixControlAlgorithm(&fixPid);
+        calculateAngularVelocity(&fixMotor, fix2float(fixControlReg));
+
+        float difference = controlReg - fix2float(fixControlReg);
+        if (difference < 0)
+            difference = -difference;
+        if (difference > maxDifference)
+            maxDifference = difference;
+    }
+
+    printf("Maximum control signal difference (float vs fixed): %f\n", maxDifference);
+    assert(maxDifference < MAX_DIFFERENCE);
+
+    // Overflow
+    // -------------------------------------------------------------------------
+    // An error beyond the range of fix_t saturates, so the output goes to the
+    // limit in the direction of the error
+    fixPid.integrator = 0;
+    fixStatusClear();
+    fixSetpointReg = FIX_POINT(30000.0f);
+    fixFeedbackReg = FIX_POINT(-30000.0f);
+    assert(runFixControlAlgorithm(&fixPid) == FIX_OUTPUT_MAX);
+    assert(fixStatusGet() & FIX_STATUS_SUBTRACT_OVERFLOW);
+
+    fixPid.integrator = 0;
+    fixSetpointReg = FIX_POINT(-30000.0f);
+    fixFeedbackReg = FIX_POINT(30000.0f);
+    assert(runFixControlAlgorithm(&fixPid) == FIX_OUTPUT_MIN);
+    fixStatusClear();
+
+    // Timing
+    // -------------------------------------------------------------------------
+    // Use the recorded closed loop signals so that both controllers see
+    // realistic inputs. The fastest repeat is reported to reduce the effect of
+    // interrupts and other processes.
+    uint64_t floatBest = UINT64_MAX, fixBest = UINT64_MAX;
+
+    for (int r = 0; r < NUM_REPEATS; r++) {
+        uint64_t start = benchTime();
+        for (int i = 0; i < NUM_SAMPLES; i++) {
+            setpointReg = setpoints[i];
+            feedbackReg = feedbacks[i];
+            runControlAlgorithm(&pid);
+        }
+        uint64_t elapsed = benchTime() - start;
+        if (elapsed < floatBest)
+            floatBest = elapsed;
+
+        start = benchTime();
+        for (int i = 0; i < NUM_SAMPLES; i++) {
+            fixSetpointReg = fixSetpoints[i];
+            fixFeedbackReg = fixFeedbacks[i];
+            runFixControlAlgorithm(&fixPid);
+        }
+        elapsed = benchTime() - start;
+        if (elapsed < fixBest)
+            fixBest = elapsed;
+    }
+
+    printf("runControlAlgorithm:    %6.1f %s/step\n",
+           (double)floatBest / NUM_SAMPLES, BENCH_UNIT);
+    printf("runFixControlAlgorithm: %6.1f %s/step\n",
+           (double)fixBest / NUM_SAMPLES, BENCH_UNIT);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,174 @@
+/* pidIncrementalTest.c
+ *
+ * Tests for the incremental (velocity form) PID controller, followed by a
+ * comparison of the cost of a single step with runControlAlgorithm().
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team
+ */
+
+#include "benchmark.h"
+
+#include "PIDController.h"
+#include "Motor.h"
+
+#include "MotorParameters.h"
+#include "ControllerParameters.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define TOLERANCE 1E-4f
+
+#define NUM_SAMPLES     1000
+#define NUM_REPEATS     200
+
+volatile float setpointReg, feedbackReg, controlReg, incrementalReg;
+
+static float setpoints[NUM_SAMPLES];
+static float feedbacks[NUM_SAMPLES];
+
+static void test_pidIncrementalInit(void);
+static void test_equivalence(void);
+static void test_antiWindup(void);
+static void compareCycles(void);
+
+int main(void) {
+    printf("Testing pidIncrementalInit() ... ");
+    test_pidIncrementalInit();
+    printf("Done!\n");
+
+    printf("Testing equivalence with runControlAlgorithm() ... ");
+    test_equivalence();
+    printf("Done!\n");
+
+    printf("Testing anti-windup ... ");
+    test_antiWindup();
+    printf("Done!\n");
+
+    printf("\nAll tests completed successfully!\n\n");
+
+    compareCycles();
+
+    return EXIT_SUCCESS;
+}
+
+static void test_pidIncrementalInit(void) {
+    struct pidIncrementalController pid;
+    struct pidParameters params = PID_DEFAULT_PARAMETERS;
+    params.kd = 0.002f;
+    pidIncrementalInit(&pid, &params, &setpointReg, &feedbackReg, &incrementalReg);
+
+    assert(fabsf(pid.q0 - (params.kp + params.ki * TS + params.kd * FS)) < 1E-6f);
+    assert(fabsf(pid.q1 - (-params.kp - 2.0f * params.kd * FS)) < 1E-6f);
+    assert(fabsf(pid.q2 - params.kd * FS) < 1E-6f);
+
+    // A constant error should only change the control signal through the
+    // integral term once the error history is full
+    setpointReg = 1.0f;
+    feedbackReg = 0.0f;
+    runIncrementalControlAlgorithm(&pid);
+    runIncrementalControlAlgorithm(&pid);
+    float u2 = runIncrementalControlAlgorithm(&pid);
+    float u3 = runIncrementalControlAlgorithm(&pid);
+    assert(fabsf((u3 - u2) - params.ki * TS) < 1E-6f);
+}
+
+static void test_equivalence(void) {
+    struct pidController pid;
+    struct pidIncrementalController incremental;
+    struct pidParameters params = PID_DEFAULT_PARAMETERS;
+    pidInit(&pid, &params, &setpointReg, &feedbackReg, &controlReg);
+    pidIncrementalInit(&incremental, &params, &setpointReg, &feedbackReg, &incrementalReg);
+
+    struct motor motor = {
+        .dcGain = DC_GAIN,
+        .timeConstant = TIME_CONSTANT,
+        .angularVelocity = 0.0f,
+        .coeffV = COEFF_V,
+        .coeffW = COEFF_W
+    };
+
+    // Closed loop with the same setpoint steps as the rover, which do not
+    // saturate the output
+    for (int i = 0; i < NUM_SAMPLES; i++) {
+        setpointReg = ((i / 100) % 2) ? 20.0f : 10.0f;
+        feedbackReg = motor.angularVelocity;
+
+        float positional = runControlAlgorithm(&pid);
+        float velocity = runIncrementalControlAlgorithm(&incremental);
+
+        assert(positional > OUTPUT_MIN && positional < OUTPUT_MAX);
+        assert(fabsf(positional - velocity) < TOLERANCE * (1.0f + fabsf(positional)));
+
+        calculateAngularVelocity(&motor, positional);
+    }
+}
+
+static void test_antiWindup(void) {
+    struct pidIncrementalController pid;
+    struct pidParameters params = PID_DEFAULT_PARAMETERS;
+    pidIncrementalInit(&pid, &params, &setpointReg, &feedbackReg, &incrementalReg);
+
+    // Hold a large error long enough for a positional integrator to wind up
+    // far beyond the output limit
+    setpointReg = 100.0f;
+    feedbackReg = 0.0f;
+    for (int i = 0; i < NUM_SAMPLES; i++)
+        assert(runIncrementalControlAlgorithm(&pid) <= OUTPUT_MAX);
+    assert(pid.prevControl == OUTPUT_MAX);
+
+    // Once the error changes sign the output must leave saturation straight
+    // away rather than waiting for an integrator to unwind
+    setpointReg = 0.0f;
+    feedbackReg = 10.0f;
+    runIncrementalControlAlgorithm(&pid);
+    assert(runIncrementalControlAlgorithm(&pid) < OUTPUT_MAX);
+}
+
+static void compareCycles(void) {
+    struct pidController pid;
+    struct pidIncrementalController incremental;
+    struct pidParameters params = PID_DEFAULT_PARAMETERS;
+    pidInit(&pid, &params, &setpointReg, &feedbackReg, &controlReg);
+    pidIncrementalInit(&incremental, &params, &setpointReg, &feedbackReg, &incrementalReg);
+
+    srand(1);
+    for (int i = 0; i < NUM_SAMPLES; i++) {
+        setpoints[i] = ((i / 100) % 2) ? 20.0f : 10.0f;
+        feedbacks[i] = setpoints[i] + (float)(rand() % 200) / 100.0f - 1.0f;
+    }
+
+    uint64_t positionalBest = UINT64_MAX, incrementalBest = UINT64_MAX;
+
+    for (int r = 0; r < NUM_REPEATS; r++) {
+        uint64_t start = benchTime();
+        for (int i = 0; i < NUM_SAMPLES; i++) {
+            setpointReg = setpoints[i];
+            feedbackReg = feedbacks[i];
+            runControlAlgorithm(&pid);
+        }
+        uint64_t elapsed = benchTime() - start;
+        if (elapsed < positionalBest)
+            positionalBest = elapsed;
+
+        start = benchTime();
+        for (int i = 0; i < NUM_SAMPLES; i++) {
+            setpointReg = setpoints[i];
+            feedbackReg = feedbacks[i];
+            runIncrementalControlAlgorithm(&incremental);
+        }
+        elapsed = benchTime() - start;
+        if (elapsed < incrementalBest)
+            incrementalBest = elapsed;
+    }
+
+    printf("runControlAlgorithm:            %6.1f %s/step\n",
+           (double)positionalBest / NUM_SAMPLES, BENCH_UNIT);
+    printf("runIncrementalControlAlgorithm: %6.1f %s/step\n",
+           (double)incrementalBest / NUM_SAMPLES, BENCH_UNIT);
+}
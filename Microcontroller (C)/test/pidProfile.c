@@ -0,0 +1,361 @@
+/* pidProfile.c
+ * Profile of the dynamic range of the velocity controller, with recommended
+ * fixed point formats.
+ *
+ * The velocity controller, built with PID_PROFILE defined (see PIDProfile.h),
+ * is run with the simulated motor through a long random sequence of setpoint
+ * steps, ramps, reversals and setpoints beyond the reach of the motor, with
+ * noise on the feedback. The range and histogram of magnitudes of each
+ * intermediate value are printed, followed by the number of fraction bits each
+ * value can have in 32 bits, and the single Q_POINT for which fix_t holds every
+ * value and coefficient.
+ *
+ * Finally a header is generated with the fraction bits of each value and
+ * coefficient, for use with FIX_DEFINE_FORMAT() and FIX_Q() (see
+ * FixFormat.h), and the FIX_* coefficients of ControllerParameters.h
+ * calculated for the recommended Q_POINT, as FIX_POINT() would give them. The
+ * coefficients are named with the Q_POINT, such as FIX_PROP_COEFF1_Q21, so
+ * that the header can be included alongside ControllerParameters.h.
+ *
+ *      pidProfile [seconds] [header]
+ *
+ * simulates the given number of seconds (default one hour) and writes the
+ * header to the given file, or prints it if none is given.
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team.
+ */
+
+#include "PIDProfile.h"
+#include "PIDController.h"
+#include "Motor.h"
+
+#include "MotorParameters.h"
+#include "ControllerParameters.h"
+
+#include <assert.h>
+#include <ctype.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DEFAULT_SECONDS     3600
+
+// Integer bits left spare above the largest value recorded, as a margin for
+// conditions the simulation does not reach
+#define GUARD_BITS          1
+
+// Largest number of fraction bits of a signed 32-bit format
+#define MAX_FRAC_BITS       31
+
+// Fastest speed the motor can reach (about 286 rpm)
+#define SPEED_LIMIT         (DC_GAIN * OUTPUT_MAX)
+
+// Peak noise on the measured speed (in rpm)
+#define FEEDBACK_NOISE      0.5f
+
+struct coefficient {
+    const char *name;
+    float value;
+    fix_t q16;                      // As in ControllerParameters.h
+};
+
+// The coefficients of the fixed point controller, as laid out in
+// ControllerParameters.h
+static const struct coefficient coefficients[] = {
+    { "FIX_PROP_COEFF1", KP * SW_B, FIX_PROP_COEFF1 },
+    { "FIX_PROP_COEFF2", KP, FIX_PROP_COEFF2 },
+    { "FIX_INT_COEFF", INT_COEFF, FIX_INT_COEFF },
+    { "FIX_DER_COEFF1", DER_COEFF1 * SW_C * DER_COEFF2, FIX_DER_COEFF1 },
+    { "FIX_DER_COEFF2", DER_COEFF1 * DER_COEFF2, FIX_DER_COEFF2 },
+    { "FIX_DER_COEFF3", DER_COEFF2, FIX_DER_COEFF3 },
+    { "FIX_OUTPUT_MIN", OUTPUT_MIN, FIX_OUTPUT_MIN },
+    { "FIX_OUTPUT_MAX", OUTPUT_MAX, FIX_OUTPUT_MAX }
+};
+
+#define NUM_COEFFICIENTS (sizeof(coefficients) / sizeof(coefficients[0]))
+
+volatile float setpointReg, feedbackReg, controlReg;
+
+static void simulate(long samples);
+static void printRanges(void);
+static void printHistograms(void);
+static int printRecommendations(void);
+static void writeHeader(FILE *file, long seconds, int qPoint);
+
+static int variableFracBits(enum pidProfileVariable variable);
+static int coefficientFracBits(float value);
+static int64_t fixedRaw(float value, int fracBits);
+static void macroName(char *macro, const char *name);
+static float randomUniform(float min, float max);
+
+int main(int argc, char **argv) {
+    long seconds = argc > 1 ? strtol(argv[1], NULL, 0) : DEFAULT_SECONDS;
+    const char *headerPath = argc > 2 ? argv[2] : NULL;
+
+    // The raw coefficients are calculated as FIX_POINT() does
+    for (size_t c = 0; c < NUM_COEFFICIENTS; c++)
+        assert(fixedRaw(coefficients[c].value, Q_POINT) == coefficients[c].q16);
+
+    srand(1);
+    pidProfileClear();
+    simulate(seconds * (long)FS);
+
+    printf("Ranges over %ld s of simulated velocity control:\n\n", seconds);
+    printRanges();
+    printHistograms();
+    int qPoint = printRecommendations();
+
+    if (headerPath == NULL) {
+        printf("\n");
+        writeHeader(stdout, seconds, qPoint);
+    } else {
+        FILE *file = fopen(headerPath, "w");
+        if (file == NULL) {
+            perror(headerPath);
+            return EXIT_FAILURE;
+        }
+        writeHeader(file, seconds, qPoint);
+        fclose(file);
+        printf("\nFormats written to %s\n", headerPath);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+// Run the velocity loop through random segments of 0.5 to 5 s, each a step to
+// a new speed, a ramp, a reversal or a step beyond the reach of the motor,
+// which saturates the control signal
+static void simulate(long samples) {
+    struct pidParameters params = PID_DEFAULT_PARAMETERS;
+    struct pidController pid;
+    pidInit(&pid, &params, &setpointReg, &feedbackReg, &controlReg);
+
+    struct motor motor = {
+        .dcGain = DC_GAIN,
+        .timeConstant = TIME_CONSTANT,
+        .angularVelocity = 0.0f,
+        .coeffV = COEFF_V,
+        .coeffW = COEFF_W
+    };
+
+    float setpoint = 0.0f;
+    long sample = 0;
+
+    while (sample < samples) {
+        long length = (long)randomUniform(0.5f * FS, 5.0f * FS);
+        float start = setpoint, end;
+
+        switch (rand() % 4) {
+        case 0:
+            end = randomUniform(-SPEED_LIMIT, SPEED_LIMIT);
+            start = end;
+            break;
+        case 1:
+            end = randomUniform(-SPEED_LIMIT, SPEED_LIMIT);
+            break;
+        case 2:
+            end = -setpoint;
+            start = end;
+            break;
+        default:
+            end = randomUniform(1.0f, 1.5f) * (rand() & 1 ? SPEED_LIMIT : -SPEED_LIMIT);
+            start = end;
+            break;
+        }
+
+        for (long i = 0; i < length && sample < samples; i++, sample++) {
+            setpoint = start + (end - start) * (float)(i + 1) / (float)length;
+
+            setpointReg = setpoint;
+            feedbackReg = motor.angularVelocity
+                          + randomUniform(-FEEDBACK_NOISE, FEEDBACK_NOISE);
+            runControlAlgorithm(&pid);
+            calculateAngularVelocity(&motor, controlReg);
+        }
+    }
+}
+
+static void printRanges(void) {
+    printf("                   minimum      maximum   int bits  fraction bits\n");
+
+    for (int v = 0; v < PID_PROFILE_NUM_VARIABLES; v++) {
+        const struct pidProfileRange *range = &pidProfileRanges[v];
+        float magnitude = fmaxf(-range->min, range->max);
+
+        if (magnitude == 0.0f) {
+            printf("%-14s %12.4f %12.4f %25s\n", pidProfileNames[v], range->min,
+                   range->max, "always zero");
+        } else {
+            printf("%-14s %12.4f %12.4f %10d %14d\n", pidProfileNames[v], range->min,
+                   range->max, pidProfileIntBits(magnitude), variableFracBits(v));
+        }
+    }
+
+    // Without anti-windup the integrator keeps growing while the output is
+    // saturated, so its range depends on how long the motor is driven beyond
+    // its reach rather than on the gains
+    const struct pidProfileRange *iTerm = &pidProfileRanges[PID_PROFILE_I_TERM];
+    if (iTerm->min < OUTPUT_MIN || iTerm->max > OUTPUT_MAX) {
+        printf("\niTerm exceeds the output limits through integrator windup, so its\n"
+               "range depends on how long the output saturates. An anti-windup\n"
+               "method (ANTI_WINDUP) bounds it.\n");
+    }
+}
+
+// Percentage of the values of each variable in each power of two, from the
+// largest occupied down to the smallest
+static void printHistograms(void) {
+    int lowest = PID_PROFILE_BINS, highest = 0;
+
+    for (int v = 0; v < PID_PROFILE_NUM_VARIABLES; v++) {
+        for (int i = 1; i < PID_PROFILE_BINS; i++) {
+            if (pidProfileRanges[v].histogram[i] == 0)
+                continue;
+            if (i < lowest)
+                lowest = i;
+            if (i > highest)
+                highest = i;
+        }
+    }
+
+    // Each column is wide enough for the name of its variable
+    int widths[PID_PROFILE_NUM_VARIABLES];
+
+    printf("\nValues in each range of magnitudes (%%):\n\n  magnitude ");
+    for (int v = 0; v < PID_PROFILE_NUM_VARIABLES; v++) {
+        widths[v] = strlen(pidProfileNames[v]) < 8 ? 9 : (int)strlen(pidProfileNames[v]) + 1;
+        printf("%*s", widths[v], pidProfileNames[v]);
+    }
+    printf("\n");
+
+    for (int i = highest; i >= lowest - 1 && i >= 0; i--) {
+        if (i == 0)
+            printf("  < 2^%-4d  ", PID_PROFILE_MIN_EXP);
+        else
+            printf("  < 2^%-4d  ", PID_PROFILE_MIN_EXP + i);
+
+        for (int v = 0; v < PID_PROFILE_NUM_VARIABLES; v++) {
+            const struct pidProfileRange *range = &pidProfileRanges[v];
+            if (range->histogram[i] == 0)
+                printf("%*s", widths[v], ".");
+            else
+                printf("%*.3f", widths[v], 100.0 * range->histogram[i] / range->count);
+        }
+        printf("\n");
+    }
+}
+
+// Print the formats recommended for the values and coefficients, and return
+// the largest Q_POINT for which all of them fit in a fix_t
+static int printRecommendations(void) {
+    int qPoint = MAX_FRAC_BITS;
+
+    for (int v = 0; v < PID_PROFILE_NUM_VARIABLES; v++) {
+        if (variableFracBits(v) < qPoint)
+            qPoint = variableFracBits(v);
+    }
+    for (size_t c = 0; c < NUM_COEFFICIENTS; c++) {
+        if (coefficientFracBits(coefficients[c].value) < qPoint)
+            qPoint = coefficientFracBits(coefficients[c].value);
+    }
+
+    printf("\nCoefficients:       value  fraction bits  relative error in Q%d and Q%d\n",
+           Q_POINT, qPoint);
+
+    for (size_t c = 0; c < NUM_COEFFICIENTS; c++) {
+        const struct coefficient *coeff = &coefficients[c];
+        double errorQ = fabs(coeff->q16 / ldexp(1.0, Q_POINT) - coeff->value);
+        double errorRecommended = fabs(fixedRaw(coeff->value, qPoint)
+                                       / ldexp(1.0, qPoint) - coeff->value);
+
+        if (coeff->value == 0.0f) {
+            printf("%-16s %9.4f %14s %13s %12s\n", coeff->name, coeff->value,
+                   "-", "-", "-");
+        } else {
+            printf("%-16s %9.4f %14d %13.2e %12.2e\n", coeff->name, coeff->value,
+                   coefficientFracBits(coeff->value),
+                   errorQ / fabs(coeff->value), errorRecommended / fabs(coeff->value));
+        }
+    }
+
+    printf("\nRecommended Q_POINT with %d guard bit: %d (currently %d)\n",
+           GUARD_BITS, qPoint, Q_POINT);
+
+    return qPoint;
+}
+
+static void writeHeader(FILE *file, long seconds, int qPoint) {
+    char macro[64];
+
+    fprintf(file, "/*\n"
+                  " * PIDProfileFormats.h\n"
+                  " *\n"
+                  " * Fixed point formats recommended by bin/host/pidProfile from %ld s of\n"
+                  " * simulated velocity control, with %d guard bit. Generated; do not edit.\n"
+                  " */\n\n", seconds, GUARD_BITS);
+    fprintf(file, "#ifndef PID_PROFILE_FORMATS_H\n#define PID_PROFILE_FORMATS_H\n\n");
+
+    fprintf(file, "// Fraction bits of each value of the controller in 32 bits\n");
+    for (int v = 0; v < PID_PROFILE_NUM_VARIABLES; v++) {
+        macroName(macro, pidProfileNames[v]);
+        fprintf(file, "#define PID_%s_FRAC_BITS%*s%d\n", macro,
+                (int)(22 - strlen(macro)), "", variableFracBits(v));
+    }
+
+    fprintf(file, "\n// Fraction bits of each coefficient in 32 bits, so that\n"
+                  "// FIX_Q(FIX_PROP_COEFF2, KP) gives the raw value of KP\n");
+    for (size_t c = 0; c < NUM_COEFFICIENTS; c++) {
+        const struct coefficient *coeff = &coefficients[c];
+        fprintf(file, "#define %s_FRAC_BITS%*s%d\n", coeff->name,
+                (int)(26 - strlen(coeff->name)), "",
+                coeff->value == 0.0f ? MAX_FRAC_BITS : coefficientFracBits(coeff->value));
+    }
+
+    fprintf(file, "\n// Q_POINT for which fix_t holds every value and coefficient\n");
+    fprintf(file, "#define PID_PROFILE_Q_POINT         %d\n", qPoint);
+
+    fprintf(file, "\n// The FIX_* coefficients of ControllerParameters.h, as FIX_POINT() gives\n"
+                  "// them with Q_POINT set to PID_PROFILE_Q_POINT\n");
+    for (size_t c = 0; c < NUM_COEFFICIENTS; c++) {
+        const struct coefficient *coeff = &coefficients[c];
+        sprintf(macro, "%s_Q%d", coeff->name, qPoint);
+        fprintf(file, "#define %-28s((fix_t)0x%08lX)     // %g\n", macro,
+                (unsigned long)(uint32_t)fixedRaw(coeff->value, qPoint), coeff->value);
+    }
+    fprintf(file, "\n#endif\n");
+}
+
+static int variableFracBits(enum pidProfileVariable variable) {
+    int bits = pidProfileFracBits(variable, GUARD_BITS);
+    return bits > MAX_FRAC_BITS ? MAX_FRAC_BITS : bits;
+}
+
+// Coefficients are constant, so need no guard bits
+static int coefficientFracBits(float value) {
+    int bits = 31 - pidProfileIntBits(fabsf(value));
+    return bits > MAX_FRAC_BITS ? MAX_FRAC_BITS : bits;
+}
+
+// Raw value with the given fraction bits, rounded as in FIX_POINT()
+static int64_t fixedRaw(float value, int fracBits) {
+    double scaled = value * ldexp(1.0, fracBits);
+    return (int64_t)(value >= 0 ? scaled + 0.5 : scaled - 0.5);
+}
+
+// Convert a camelCase name to the form used in macros, e.g. pTerm to P_TERM
+static void macroName(char *macro, const char *name) {
+    for (; *name != '\0'; name++) {
+        if (isupper((unsigned char)*name))
+            *macro++ = '_';
+        *macro++ = (char)toupper((unsigned char)*name);
+    }
+    *macro = '\0';
+}
+
+static float randomUniform(float min, float max) {
+    return min + (max - min) * ((float)rand() / (float)RAND_MAX);
+}
@@ -0,0 +1,138 @@
+/* pidRetuneTest.c
+ * Tests for runtime calculation of controller coefficients and retuning with
+ * double-buffered coefficient banks.
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team.
+ */
+
+#include "PIDController.h"
+#include "Motor.h"
+
+#include "MotorParameters.h"
+#include "ControllerParameters.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define TOLERANCE 1E-6f
+
+volatile float setpointReg, feedbackReg, controlReg;
+
+static void test_pidInit(void);
+static void test_pidRetune(void);
+static void test_bumplessTransfer(void);
+
+int main(void) {
+    printf("Testing pidInit() ... ");
+    test_pidInit();
+    printf("Done!\n");
+
+    printf("Testing pidRetune() ... ");
+    test_pidRetune();
+    printf("Done!\n");
+
+    printf("Testing bumpless transfer ... ");
+    test_bumplessTransfer();
+    printf("Done!\n");
+
+    printf("\nAll tests completed successfully!\n");
+
+    return EXIT_SUCCESS;
+}
+
+static void test_pidInit(void) {
+    struct pidController pid;
+    struct pidParameters params = PID_DEFAULT_PARAMETERS;
+    pidInit(&pid, &params, &setpointReg, &feedbackReg, &controlReg);
+
+    // Runtime coefficients must match those previously calculated by macros
+    const struct pidCoefficients *coeffs = pidActiveCoefficients(&pid);
+    assert(fabsf(coeffs->kp - KP) < TOLERANCE);
+    assert(fabsf(coeffs->intCoeff - (INT_COEFF)) < TOLERANCE);
+    assert(fabsf(coeffs->derCoeff1 - (DER_COEFF1)) < TOLERANCE);
+    assert(fabsf(coeffs->derCoeff2 - (DER_COEFF2)) < TOLERANCE);
+    assert(coeffs->outputMin == OUTPUT_MIN);
+    assert(coeffs->outputMax == OUTPUT_MAX);
+
+    assert(pid.integrator == 0.0f);
+    assert(pid.differentiator == 0.0f);
+    assert(pid.prevError == 0.0f);
+    assert(!pid.swapPending);
+}
+
+static void test_pidRetune(void) {
+    struct pidController pid;
+    struct pidParameters params = PID_DEFAULT_PARAMETERS;
+    pidInit(&pid, &params, &setpointReg, &feedbackReg, &controlReg);
+
+    struct pidParameters newParams = params;
+    newParams.kp *= 2.0f;
+
+    // New coefficients are not used until the next sample
+    assert(pidRetune(&pid, &newParams));
+    assert(pidActiveCoefficients(&pid)->kp == params.kp);
+
+    // Only one retune may be pending at a time
+    assert(!pidRetune(&pid, &params));
+
+    setpointReg = 10.0f;
+    feedbackReg = 0.0f;
+    runControlAlgorithm(&pid);
+    assert(!pid.swapPending);
+    assert(pidActiveCoefficients(&pid)->kp == newParams.kp);
+
+    // The previously active bank may now be reused
+    assert(pidRetune(&pid, &params));
+    runControlAlgorithm(&pid);
+    assert(pidActiveCoefficients(&pid)->kp == params.kp);
+}
+
+static void test_bumplessTransfer(void) {
+    struct pidController pid, reference;
+    struct pidParameters params = PID_DEFAULT_PARAMETERS;
+    params.kd = 0.001f;
+
+    volatile float referenceControl;
+    pidInit(&pid, &params, &setpointReg, &feedbackReg, &controlReg);
+    pidInit(&reference, &params, &setpointReg, &feedbackReg, &referenceControl);
+
+    struct motor motor = {
+        .dcGain = DC_GAIN,
+        .timeConstant = TIME_CONSTANT,
+        .angularVelocity = 0.0f,
+        .coeffV = COEFF_V,
+        .coeffW = COEFF_W
+    };
+
+    // Retune shortly after a setpoint step while the error is still large
+    setpointReg = 20.0f;
+    for (int i = 0; i < 5; i++) {
+        feedbackReg = motor.angularVelocity;
+        runControlAlgorithm(&pid);
+        runControlAlgorithm(&reference);
+        calculateAngularVelocity(&motor, controlReg);
+    }
+
+    struct pidParameters newParams = params;
+    newParams.kp *= 3.0f;
+    newParams.setWeightB = 0.5f;
+    newParams.feedforwardGain = FEEDFORWARD_GAIN;
+    assert(pidRetune(&pid, &newParams));
+
+    feedbackReg = motor.angularVelocity;
+    float error = setpointReg - feedbackReg;
+    float retuned = runControlAlgorithm(&pid);
+    float unchanged = runControlAlgorithm(&reference);
+
+    // Without adjusting the states the control signal would step by the change
+    // in the proportional and feedforward terms
+    float stepWithoutTransfer = newParams.kp * (newParams.setWeightB * setpointReg - feedbackReg)
+                              - params.kp * error
+                              + newParams.feedforwardGain * setpointReg;
+    assert(fabsf(retuned - unchanged) < 0.01f * fabsf(stepWithoutTransfer));
+}
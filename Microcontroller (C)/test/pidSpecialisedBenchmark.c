@@ -0,0 +1,122 @@
+/* pidSpecialisedBenchmark.c
+ *
+ * Host benchmark comparing a controller generated by PID_DEFINE_SPECIALISED()
+ * for the parameters in ControllerParameters.h with the generic
+ * runControlAlgorithm().
+ *
+ * Both controllers are run in closed loop with the simulated motor to check
+ * that their outputs agree within rounding, then the cost of a single step is measured
+ * for each. Run `make pidSpecialisedReport` to also compare the number of
+ * instructions in each step function.
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team
+ */
+
+#include "benchmark.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "PIDController.h"
+#include "PIDSpecialised.h"
+#include "Motor.h"
+
+#include "MotorParameters.h"
+#include "ControllerParameters.h"
+
+#define ZERO 0.0f
+
+#define NUM_SAMPLES     1000
+#define NUM_REPEATS     200
+
+// Largest difference between the outputs (in volts). The coefficients are
+// rounded differently, so the outputs may differ in the last bits.
+#define OUTPUT_TOLERANCE    1E-5f
+
+PID_DEFINE_SPECIALISED_DEFAULT(defaultStep)
+
+// Out of line copy of the specialised controller so that its instructions can
+// be counted separately from the code which calls it
+__attribute__((noinline))
+float specialisedStep(struct pidState *state, float setpoint, float feedback) {
+    return defaultStep(state, setpoint, feedback);
+}
+
+volatile float setpointReg, feedbackReg, controlReg;
+
+static float setpoints[NUM_SAMPLES];
+static float feedbacks[NUM_SAMPLES];
+
+int main(void) {
+    struct pidController pid;
+    struct pidParameters params = PID_DEFAULT_PARAMETERS;
+    pidInit(&pid, &params, &setpointReg, &feedbackReg, &controlReg);
+
+    struct pidState state = { ZERO, ZERO, ZERO };
+
+    struct motor motor = {
+        .dcGain = DC_GAIN,
+        .timeConstant = TIME_CONSTANT,
+        .angularVelocity = ZERO,
+        .coeffV = COEFF_V,
+        .coeffW = COEFF_W
+    };
+
+    // Closed loop comparison
+    // -------------------------------------------------------------------------
+    int mismatches = 0;
+
+    for (int i = 0; i < NUM_SAMPLES; i++) {
+        setpoints[i] = ((i / 100) % 2) ? 20.0f : 10.0f;
+        feedbacks[i] = motor.angularVelocity;
+
+        setpointReg = setpoints[i];
+        feedbackReg = feedbacks[i];
+        float generic = runControlAlgorithm(&pid);
+        float specialised = specialisedStep(&state, setpoints[i], feedbacks[i]);
+
+        if (fabsf(generic - specialised) > OUTPUT_TOLERANCE)
+            mismatches++;
+
+        calculateAngularVelocity(&motor, generic);
+    }
+
+    printf("Samples where outputs differ: %d of %d\n", mismatches, NUM_SAMPLES);
+
+    // Timing
+    // -------------------------------------------------------------------------
+    uint64_t genericBest = UINT64_MAX, specialisedBest = UINT64_MAX;
+
+    for (int r = 0; r < NUM_REPEATS; r++) {
+        uint64_t start = benchTime();
+        for (int i = 0; i < NUM_SAMPLES; i++) {
+            setpointReg = setpoints[i];
+            feedbackReg = feedbacks[i];
+            runControlAlgorithm(&pid);
+        }
+        uint64_t elapsed = benchTime() - start;
+        if (elapsed < genericBest)
+            genericBest = elapsed;
+
+        start = benchTime();
+        for (int i = 0; i < NUM_SAMPLES; i++) {
+            setpointReg = setpoints[i];
+            feedbackReg = feedbacks[i];
+            controlReg = specialisedStep(&state, setpointReg, feedbackReg);
+        }
+        elapsed = benchTime() - start;
+        if (elapsed < specialisedBest)
+            specialisedBest = elapsed;
+    }
+
+    printf("runControlAlgorithm: %6.1f %s/step\n",
+           (double)genericBest / NUM_SAMPLES, BENCH_UNIT);
+    printf("specialised step:    %6.1f %s/step\n",
+           (double)specialisedBest / NUM_SAMPLES, BENCH_UNIT);
+
+    return (mismatches == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
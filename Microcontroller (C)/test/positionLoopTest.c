@@ -0,0 +1,167 @@
+/* positionLoopTest.c
+ * Tests for the outer position loop of the cascaded controller.
+ *
+ * wrapAngle() is checked on either side of the wrap, and the position
+ * controller is checked to run once every POSITION_LOOP_DIVIDER samples. The
+ * position loop is then closed around the velocity controller and the
+ * simulated motor, and the wheel is driven to angles on either side of 0
+ * degrees, which it must reach by the shortest path.
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team.
+ */
+
+#include "PositionLoop.h"
+#include "PIDController.h"
+#include "Motor.h"
+
+#include "MotorParameters.h"
+#include "ControllerParameters.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define SETTLING_SAMPLES    (10 * (int)FS)
+
+// Largest error in the final angle (in degrees)
+#define ANGLE_TOLERANCE     1.0f
+
+volatile float setpointReg, feedbackReg, controlReg;
+volatile float positionSetpointReg, positionFeedbackReg;
+
+static void test_wrapAngle(void);
+static void test_divider(void);
+static void test_closedLoop(void);
+
+static float driveTo(float start, float target, float *farthest);
+static float angleBetween(float a, float b);
+
+int main(void) {
+    printf("Testing wrapAngle() ... ");
+    test_wrapAngle();
+    printf("Done!\n");
+
+    printf("Testing loop divider ... ");
+    test_divider();
+    printf("Done!\n");
+
+    printf("Testing closed loop ... ");
+    test_closedLoop();
+    printf("Done!\n");
+
+    printf("\nAll tests completed successfully!\n");
+
+    return EXIT_SUCCESS;
+}
+
+static void test_wrapAngle(void) {
+    assert(wrapAngle(0.0f) == 0.0f);
+    assert(wrapAngle(90.0f) == 90.0f);
+    assert(wrapAngle(-90.0f) == -90.0f);
+    assert(wrapAngle(179.5f) == 179.5f);
+
+    // The range is [-180, 180)
+    assert(wrapAngle(180.0f) == -180.0f);
+    assert(wrapAngle(-180.0f) == -180.0f);
+
+    // Across 0/359 degrees
+    assert(wrapAngle(359.0f) == -1.0f);
+    assert(wrapAngle(-359.0f) == 1.0f);
+    assert(wrapAngle(350.0f - 10.0f) == -20.0f);
+    assert(wrapAngle(10.0f - 350.0f) == 20.0f);
+
+    // More than one turn
+    assert(wrapAngle(730.0f) == 10.0f);
+    assert(wrapAngle(-725.0f) == -5.0f);
+}
+
+static void test_divider(void) {
+    struct pidParameters params = PID_POSITION_PARAMETERS;
+    struct pidController pid;
+    pidInit(&pid, &params, &positionSetpointReg, &positionFeedbackReg, &setpointReg);
+
+    struct positionLoop loop;
+    positionLoopInit(&loop, &pid, POSITION_LOOP_DIVIDER);
+
+    positionSetpointReg = 10.0f;
+
+    for (int sample = 1; sample <= 10 * POSITION_LOOP_DIVIDER; sample++) {
+        setpointReg = -1.0f;
+        bool ran = runPositionLoop(&loop, 355.0f);
+
+        // Only every POSITION_LOOP_DIVIDER'th sample writes the velocity
+        // setpoint, and the error is wrapped from -345 to 15 degrees
+        assert(ran == (sample % POSITION_LOOP_DIVIDER == 0));
+        if (ran) {
+            assert(fabsf(positionFeedbackReg - -5.0f) < 1E-4f);
+            assert(fabsf(setpointReg - POS_KP * 15.0f) < 1E-5f);
+        } else {
+            assert(setpointReg == -1.0f);
+        }
+    }
+}
+
+static void test_closedLoop(void) {
+    float farthest;
+
+    assert(angleBetween(driveTo(0.0f, 90.0f, &farthest), 90.0f) < ANGLE_TOLERANCE);
+    assert(farthest < 100.0f);
+
+    // Across 0 degrees in both directions, without turning the long way round
+    assert(angleBetween(driveTo(10.0f, 350.0f, &farthest), 350.0f) < ANGLE_TOLERANCE);
+    assert(farthest < 30.0f);
+
+    assert(angleBetween(driveTo(340.0f, 20.0f, &farthest), 20.0f) < ANGLE_TOLERANCE);
+    assert(farthest < 50.0f);
+}
+
+// Run the cascade from rest at angle `start` with a setpoint of `target`,
+// returning the final angle. farthest is set to the largest distance from
+// `start` reached on the way.
+static float driveTo(float start, float target, float *farthest) {
+    struct pidParameters params = PID_DEFAULT_PARAMETERS;
+    struct pidParameters positionParams = PID_POSITION_PARAMETERS;
+    struct pidController pid, positionPid;
+    pidInit(&pid, &params, &setpointReg, &feedbackReg, &controlReg);
+    pidInit(&positionPid, &positionParams, &positionSetpointReg, &positionFeedbackReg,
+            &setpointReg);
+
+    struct positionLoop loop;
+    positionLoopInit(&loop, &positionPid, POSITION_LOOP_DIVIDER);
+
+    struct motor motor = {
+        .dcGain = DC_GAIN,
+        .timeConstant = TIME_CONSTANT,
+        .angularVelocity = 0.0f,
+        .coeffV = COEFF_V,
+        .coeffW = COEFF_W
+    };
+
+    float angle = start;
+    setpointReg = 0.0f;
+    positionSetpointReg = target;
+    *farthest = 0.0f;
+
+    for (int i = 0; i < SETTLING_SAMPLES; i++) {
+        // The angle is in [0, 360), as measured by the QEI module
+        feedbackReg = motor.angularVelocity;
+        runPositionLoop(&loop, angle);
+        runControlAlgorithm(&pid);
+        calculateAngularVelocity(&motor, controlReg);
+
+        // rpm to degrees per sample
+        angle = fmodf(angle + motor.angularVelocity * 6.0f / FS + 360.0f, 360.0f);
+        *farthest = fmaxf(*farthest, angleBetween(angle, start));
+    }
+
+    return angle;
+}
+
+// Distance between two angles in degrees, the short way round
+static float angleBetween(float a, float b) {
+    return fabsf(wrapAngle(a - b));
+}
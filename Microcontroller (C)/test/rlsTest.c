@@ -0,0 +1,319 @@
+/* rlsTest.c
+ * Tests for the online identification of the motor model and the adaptation of
+ * the PID gains.
+ *
+ * The velocity controller is run in closed loop with a simulated motor whose
+ * gain and time constant differ from MotorParameters.h (e.g. a low battery and
+ * a heavier load), and the identified model is compared with the simulated one.
+ * The gains are checked for slower and faster motors, including motors too fast
+ * for the closed loop poles to be placed. The step response with the adapted
+ * gains is then compared with the response of the nominal gains. Finally the cost of an update is compared with
+ * runControlAlgorithm().
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team.
+ */
+
+#include "benchmark.h"
+
+#include "RLSEstimator.h"
+#include "PIDController.h"
+#include "Motor.h"
+
+#include "MotorParameters.h"
+#include "ControllerParameters.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define NUM_SAMPLES     1000
+#define NUM_REPEATS     200
+
+// Samples between setpoint changes (1 s)
+#define STEP_SAMPLES    50
+
+// Simulated motor
+#define ACTUAL_GAIN             (0.6f * DC_GAIN)
+#define ACTUAL_TIME_CONSTANT    (2.0f * TIME_CONSTANT)
+
+// Largest relative error of the identified model
+#define TOLERANCE       1E-3f
+
+volatile float setpointReg, feedbackReg, controlReg;
+
+static float controls[NUM_SAMPLES];
+static float feedbacks[NUM_SAMPLES];
+
+static void test_identification(void);
+static void test_constantSetpoint(void);
+static void test_nominalTuning(void);
+static void test_tuningLimits(void);
+static void test_adaptation(void);
+static void measureCycles(void);
+
+static void characteristic(const struct pidParameters *params, float dcGain,
+                           float timeConstant, float *c1, float *c0);
+
+static float runIdentification(struct rlsEstimator *rls, int samples,
+                               int stepSamples);
+static float overshoot(const struct pidParameters *params, float dcGain,
+                       float timeConstant);
+
+int main(void) {
+    printf("Testing identification ... ");
+    test_identification();
+    printf("Done!\n");
+
+    printf("Testing constant setpoint ... ");
+    test_constantSetpoint();
+    printf("Done!\n");
+
+    printf("Testing nominal tuning ... ");
+    test_nominalTuning();
+    printf("Done!\n");
+
+    printf("Testing tuning limits ... ");
+    test_tuningLimits();
+    printf("Done!\n");
+
+    printf("Testing adaptation ... ");
+    test_adaptation();
+    printf("Done!\n");
+
+    printf("\nAll tests completed successfully!\n\n");
+
+    measureCycles();
+
+    return EXIT_SUCCESS;
+}
+
+static void test_identification(void) {
+    struct rlsEstimator rls;
+    rlsInit(&rls, DC_GAIN, TIME_CONSTANT, FS, RLS_FORGETTING);
+
+    runIdentification(&rls, 10 * STEP_SAMPLES, STEP_SAMPLES);
+
+    float dcGain, timeConstant;
+    assert(rlsGetModel(&rls, FS, &dcGain, &timeConstant));
+    assert(fabsf(dcGain / ACTUAL_GAIN - 1.0f) < TOLERANCE);
+    assert(fabsf(timeConstant / ACTUAL_TIME_CONSTANT - 1.0f) < TOLERANCE);
+    assert(rls.samples == 10 * STEP_SAMPLES);
+}
+
+static void test_constantSetpoint(void) {
+    struct rlsEstimator rls;
+    rlsInit(&rls, DC_GAIN, TIME_CONSTANT, FS, RLS_FORGETTING);
+
+    // Identify, then hold the setpoint for much longer than the memory of the
+    // estimator
+    runIdentification(&rls, 10 * STEP_SAMPLES, STEP_SAMPLES);
+    runIdentification(&rls, 100 * STEP_SAMPLES, 100 * STEP_SAMPLES);
+
+    // Forgetting stops once the covariance reaches its limit
+    assert(rls.cov[0][0] + rls.cov[1][1] < RLS_MAX_TRACE / RLS_FORGETTING);
+
+    float dcGain, timeConstant;
+    assert(rlsGetModel(&rls, FS, &dcGain, &timeConstant));
+    assert(fabsf(dcGain / ACTUAL_GAIN - 1.0f) < TOLERANCE);
+    assert(fabsf(timeConstant / ACTUAL_TIME_CONSTANT - 1.0f) < TOLERANCE);
+}
+
+static void test_nominalTuning(void) {
+    struct pidParameters nominal = PID_DEFAULT_PARAMETERS;
+    struct pidParameters tuned;
+
+    // The nominal model gives back the nominal gains
+    assert(rlsTunePid(&nominal, DC_GAIN, TIME_CONSTANT, DC_GAIN, TIME_CONSTANT, &tuned));
+    assert(fabsf(tuned.kp - nominal.kp) < 1E-6f);
+    assert(fabsf(tuned.ki - nominal.ki) < 1E-5f);
+    assert(tuned.kd == nominal.kd && tuned.outputMax == nominal.outputMax);
+
+    // An unstable or negative gain model is rejected
+    struct rlsEstimator rls;
+    rlsInit(&rls, DC_GAIN, TIME_CONSTANT, FS, RLS_FORGETTING);
+    float dcGain = 0.0f, timeConstant = 0.0f;
+    rls.theta[0] = 1.0f;
+    assert(!rlsGetModel(&rls, FS, &dcGain, &timeConstant));
+    rls.theta[0] = 0.9f;
+    rls.theta[1] = -1.0f;
+    assert(!rlsGetModel(&rls, FS, &dcGain, &timeConstant));
+    assert(dcGain == 0.0f && timeConstant == 0.0f);
+}
+
+static void test_tuningLimits(void) {
+    struct pidParameters nominal = PID_DEFAULT_PARAMETERS;
+    struct pidParameters tuned;
+
+    float nominalC1, nominalC0, c1, c0;
+    characteristic(&nominal, DC_GAIN, TIME_CONSTANT, &nominalC1, &nominalC0);
+
+    // A slower motor is given higher gains which place both poles
+    assert(rlsTunePid(&nominal, DC_GAIN, TIME_CONSTANT, DC_GAIN,
+                      2.0f * TIME_CONSTANT, &tuned));
+    assert(tuned.kp > nominal.kp && tuned.ki > 0.0f);
+    characteristic(&tuned, DC_GAIN, 2.0f * TIME_CONSTANT, &c1, &c0);
+    assert(fabsf(c1 - nominalC1) < 1E-5f && fabsf(c0 - nominalC0) < 1E-5f);
+
+    // A faster motor than the proportional gain can slow down has none, and
+    // the integral gain is calculated for that
+    const float fast = 0.5f * TIME_CONSTANT;
+    assert(rlsTunePid(&nominal, DC_GAIN, TIME_CONSTANT, DC_GAIN, fast, &tuned));
+    assert(tuned.kp == 0.0f && tuned.ki > 0.0f);
+    characteristic(&tuned, DC_GAIN, fast, &c1, &c0);
+    assert(fabsf(c1 - nominalC1) < 1E-5f);
+
+    // An even faster motor would need a negative integral gain, and is
+    // rejected
+    tuned = nominal;
+    tuned.ki = -1.0f;
+    assert(!rlsTunePid(&nominal, DC_GAIN, TIME_CONSTANT, DC_GAIN,
+                       0.2f * TIME_CONSTANT, &tuned));
+    assert(tuned.ki == -1.0f);
+}
+
+static void test_adaptation(void) {
+    struct rlsEstimator rls;
+    rlsInit(&rls, DC_GAIN, TIME_CONSTANT, FS, RLS_FORGETTING);
+    runIdentification(&rls, 10 * STEP_SAMPLES, STEP_SAMPLES);
+
+    float dcGain, timeConstant;
+    assert(rlsGetModel(&rls, FS, &dcGain, &timeConstant));
+
+    struct pidParameters nominal = PID_DEFAULT_PARAMETERS;
+    struct pidParameters tuned;
+    assert(rlsTunePid(&nominal, DC_GAIN, TIME_CONSTANT, dcGain, timeConstant, &tuned));
+
+    float designed = overshoot(&nominal, DC_GAIN, TIME_CONSTANT);
+    float mismatched = overshoot(&nominal, ACTUAL_GAIN, ACTUAL_TIME_CONSTANT);
+    float adapted = overshoot(&tuned, ACTUAL_GAIN, ACTUAL_TIME_CONSTANT);
+
+    // The adapted gains move the response back towards the designed response.
+    // Only the closed loop poles are matched, so the zero of the controller
+    // still moves and the overshoot is not restored exactly.
+    assert(fabsf(adapted - designed) < 0.5f * fabsf(mismatched - designed));
+
+    printf("\n  Overshoot: %.1f%% designed, %.1f%% nominal gains, %.1f%% adapted gains\n  ",
+           100.0 * designed, 100.0 * mismatched, 100.0 * adapted);
+}
+
+static void measureCycles(void) {
+    struct rlsEstimator rls;
+    rlsInit(&rls, DC_GAIN, TIME_CONSTANT, FS, RLS_FORGETTING);
+
+    struct pidController pid;
+    struct pidParameters params = PID_DEFAULT_PARAMETERS;
+    pidInit(&pid, &params, &setpointReg, &feedbackReg, &controlReg);
+
+    // Record a closed loop response to update the estimator with
+    struct motor motor = {
+        .dcGain = ACTUAL_GAIN,
+        .timeConstant = ACTUAL_TIME_CONSTANT,
+        .angularVelocity = 0.0f,
+        .coeffV = TS * ACTUAL_GAIN / (TS + ACTUAL_TIME_CONSTANT),
+        .coeffW = ACTUAL_TIME_CONSTANT / (TS + ACTUAL_TIME_CONSTANT)
+    };
+
+    for (int i = 0; i < NUM_SAMPLES; i++) {
+        setpointReg = (i / STEP_SAMPLES) % 2 ? 20.0f : 10.0f;
+        feedbackReg = motor.angularVelocity;
+        controls[i] = runControlAlgorithm(&pid);
+        feedbacks[i] = calculateAngularVelocity(&motor, controls[i]);
+    }
+
+    uint64_t pidBest = UINT64_MAX, rlsBest = UINT64_MAX;
+
+    for (int r = 0; r < NUM_REPEATS; r++) {
+        uint64_t start = benchTime();
+        for (int i = 0; i < NUM_SAMPLES; i++) {
+            feedbackReg = feedbacks[i];
+            runControlAlgorithm(&pid);
+        }
+        uint64_t elapsed = benchTime() - start;
+        if (elapsed < pidBest)
+            pidBest = elapsed;
+
+        start = benchTime();
+        for (int i = 0; i < NUM_SAMPLES; i++)
+            rlsUpdate(&rls, controls[i], feedbacks[i]);
+        elapsed = benchTime() - start;
+        if (elapsed < rlsBest)
+            rlsBest = elapsed;
+    }
+
+    printf("runControlAlgorithm: %6.1f %s/sample\n",
+           (double)pidBest / NUM_SAMPLES, BENCH_UNIT);
+    printf("rlsUpdate:           %6.1f %s/sample\n",
+           (double)rlsBest / NUM_SAMPLES, BENCH_UNIT);
+}
+
+// Run the nominal velocity controller with the simulated motor, alternating the
+// setpoint between 10 and 20 rpm every stepSamples samples, and update the
+// estimator as in system.c. Returns the final speed.
+static float runIdentification(struct rlsEstimator *rls, int samples,
+                               int stepSamples) {
+    struct pidController pid;
+    struct pidParameters params = PID_DEFAULT_PARAMETERS;
+    pidInit(&pid, &params, &setpointReg, &feedbackReg, &controlReg);
+
+    struct motor motor = {
+        .dcGain = ACTUAL_GAIN,
+        .timeConstant = ACTUAL_TIME_CONSTANT,
+        .angularVelocity = rls->prevFeedback,
+        .coeffV = TS * ACTUAL_GAIN / (TS + ACTUAL_TIME_CONSTANT),
+        .coeffW = ACTUAL_TIME_CONSTANT / (TS + ACTUAL_TIME_CONSTANT)
+    };
+
+    controlReg = 0.0f;
+    for (int i = 0; i < samples; i++) {
+        setpointReg = (i / stepSamples) % 2 ? 20.0f : 10.0f;
+        feedbackReg = calculateAngularVelocity(&motor, controlReg);
+
+        rlsUpdate(rls, controlReg, feedbackReg);
+        runControlAlgorithm(&pid);
+    }
+
+    return feedbackReg;
+}
+
+// Coefficients of the closed loop characteristic polynomial z^2 + c1 z + c0 of
+// a PI controller with the motor, as in rlsTunePid()
+static void characteristic(const struct pidParameters *params, float dcGain,
+                           float timeConstant, float *c1, float *c0) {
+    float a = timeConstant / (TS + timeConstant);
+    float b = TS * dcGain / (TS + timeConstant);
+
+    *c1 = b * (params->kp + params->ki * TS) - 1.0f - a;
+    *c0 = a - b * params->kp;
+}
+
+// Overshoot of the response to a 10 rpm step, as a fraction of the step
+static float overshoot(const struct pidParameters *params, float dcGain,
+                       float timeConstant) {
+    struct pidController pid;
+    pidInit(&pid, params, &setpointReg, &feedbackReg, &controlReg);
+
+    struct motor motor = {
+        .dcGain = dcGain,
+        .timeConstant = timeConstant,
+        .angularVelocity = 0.0f,
+        .coeffV = TS * dcGain / (TS + timeConstant),
+        .coeffW = timeConstant / (TS + timeConstant)
+    };
+
+    setpointReg = 10.0f;
+    feedbackReg = 0.0f;
+    float peak = 0.0f;
+
+    for (int i = 0; i < NUM_SAMPLES; i++) {
+        runControlAlgorithm(&pid);
+        feedbackReg = calculateAngularVelocity(&motor, controlReg);
+        if (feedbackReg > peak)
+            peak = feedbackReg;
+    }
+
+    return peak / setpointReg - 1.0f;
+}
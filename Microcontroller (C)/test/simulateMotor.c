@@ -29,24 +29,9 @@ int main(void) {
     enableFPU();
 
     // PID Controller initialisation
-    struct pidController _pid = {
-        .kp = KP, .ki = KI, .kd = KD,
-        .setWeightB = SW_B, .setWeightC = SW_C,
-        .filterCoeff = N,
-        .sampleTime = TS, .sampleFreq = FS,
-        .outputMin = OUTPUT_MIN, .outputMax = OUTPUT_MAX,
-
-        .intCoeff = INT_COEFF,
-        .derCoeff1 = DER_COEFF1, .derCoeff2 = DER_COEFF2,
-        
-        .setpoint = &setpointReg,
-        .feedback = &feedbackReg,
-        .controlSignal = &controlReg,
-
-        .integrator = ZERO,
-        .differentiator = ZERO,
-        .prevError = ZERO
-    };
+    struct pidController _pid;
+    struct pidParameters params = PID_DEFAULT_PARAMETERS;
+    pidInit(&_pid, &params, &setpointReg, &feedbackReg, &controlReg);
 
     // Motor simulator initialisation
     struct motor _motor = {
@@ -109,7 +94,7 @@ static void timer_isr(void) {
 
     runControlAlgorithm(pid);
 
-    percent duty = controlReg / pid->outputMax * 100.0f;
+    percent duty = controlReg / pidActiveCoefficients(pid)->outputMax * 100.0f;
     pwmSetDutyCycle(PWM00_B6, duty);
 
     GPIOPinWrite(GPIO_PORTA_BASE, GPIO_PIN_7, 0x00);
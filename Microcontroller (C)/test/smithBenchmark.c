@@ -0,0 +1,292 @@
+/* smithBenchmark.c
+ * Tests and benchmarks for the Smith predictor.
+ *
+ * The simulated motor is given a transport delay of a whole number of samples
+ * on its input voltage, which models the PWM period and ESC. The velocity
+ * controller is run without the delay, with the delay, and with the delay and
+ * the Smith predictor, at the gains in ControllerParameters.h and at raised
+ * gains. The tracking error and overshoot are compared, including with a
+ * motor which does not match the model. Finally the cost of the predictor is
+ * measured.
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team.
+ */
+
+#include "benchmark.h"
+
+#include "SmithPredictor.h"
+#include "PIDController.h"
+#include "Motor.h"
+
+#include "MotorParameters.h"
+#include "ControllerParameters.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define NUM_SAMPLES     1000
+#define NUM_REPEATS     200
+
+// Samples between setpoint changes (10 s)
+#define STEP_SAMPLES    500
+
+// Longest delay simulated
+#define MAX_PLANT_DELAY SMITH_MAX_DELAY
+
+volatile float setpointReg, feedbackReg, predictedFeedbackReg, controlReg;
+
+struct closedLoopResult {
+    float absError;             // Mean absolute error
+    float overshoot;            // Largest overshoot of a step (fraction)
+};
+
+// Plant used in a simulation, which may differ from the model
+struct plantModel {
+    float dcGain;
+    float timeConstant;
+    uint32_t delay;             // Transport delay on the voltage (samples)
+};
+
+static void test_perfectModel(void);
+static void test_raisedGains(void);
+static void test_modelError(void);
+static void measureCycles(void);
+
+static struct closedLoopResult runClosedLoop(struct plantModel plant, float gainScale,
+                                             bool usePredictor, uint32_t modelDelay);
+static void printResult(const char *name, struct closedLoopResult result);
+
+int main(void) {
+    printf("Testing perfect model ... ");
+    test_perfectModel();
+    printf("Done!\n");
+
+    printf("Testing raised gains ... ");
+    test_raisedGains();
+    printf("Done!\n");
+
+    printf("Testing model error ... ");
+    test_modelError();
+    printf("Done!\n");
+
+    printf("\nAll tests completed successfully!\n\n");
+
+    measureCycles();
+
+    return EXIT_SUCCESS;
+}
+
+static void test_perfectModel(void) {
+    struct plantModel undelayed = { DC_GAIN, TIME_CONSTANT, 0 };
+    struct closedLoopResult reference = runClosedLoop(undelayed, 1.0f, false, 0);
+
+    printf("\n");
+    printResult("No delay", reference);
+
+    // With an exact model, the predictor removes the effect of the delay on
+    // the loop, so the response is the undelayed response shifted in time.
+    // Without it the loop is unstable with two or more samples of delay.
+    for (uint32_t delay = 1; delay <= 3; delay++) {
+        struct plantModel plant = { DC_GAIN, TIME_CONSTANT, delay };
+        struct closedLoopResult plain = runClosedLoop(plant, 1.0f, false, 0);
+        struct closedLoopResult smith = runClosedLoop(plant, 1.0f, true, delay);
+
+        char name[40];
+        snprintf(name, sizeof(name), "%u sample delay", (unsigned)delay);
+        printResult(name, plain);
+        snprintf(name, sizeof(name), "%u sample delay, predictor", (unsigned)delay);
+        printResult(name, smith);
+
+        assert(fabsf(smith.overshoot - reference.overshoot) < 1E-3f);
+        assert(smith.absError < plain.absError);
+        assert(smith.absError < reference.absError * (1.0f + 0.1f * delay));
+    }
+
+    printf("  ");
+}
+
+static void test_raisedGains(void) {
+    struct plantModel undelayed = { DC_GAIN, TIME_CONSTANT, 0 };
+    struct plantModel plant = { DC_GAIN, TIME_CONSTANT, SMITH_DELAY };
+
+    printf("\n  Gains scaled by SMITH_GAIN_SCALE = %.1f, %d sample delay:\n",
+           SMITH_GAIN_SCALE, SMITH_DELAY);
+
+    struct closedLoopResult reference = runClosedLoop(undelayed, SMITH_GAIN_SCALE, false, 0);
+    struct closedLoopResult plain = runClosedLoop(plant, SMITH_GAIN_SCALE, false, 0);
+    struct closedLoopResult smith = runClosedLoop(plant, SMITH_GAIN_SCALE, true, SMITH_DELAY);
+    struct closedLoopResult nominal = runClosedLoop(plant, 1.0f, false, 0);
+
+    printResult("No delay", reference);
+    printResult("Delay, nominal gains", nominal);
+    printResult("Delay, raised gains", plain);
+    printResult("Delay, raised gains, predictor", smith);
+    printf("  ");
+
+    // Without the predictor the raised gains make the delayed loop worse than
+    // the nominal gains, while with it they track better
+    assert(plain.absError > nominal.absError);
+    assert(smith.absError < nominal.absError);
+    assert(smith.overshoot < nominal.overshoot);
+}
+
+static void test_modelError(void) {
+    printf("\n  Motor gain and time constant 20%% off the model:\n");
+
+    const float gains[2] = { 0.8f, 1.2f };
+    const float timeConstants[2] = { 1.2f, 0.8f };
+
+    for (int i = 0; i < 2; i++) {
+        struct plantModel plant = {
+            DC_GAIN * gains[i], TIME_CONSTANT * timeConstants[i], SMITH_DELAY
+        };
+
+        struct closedLoopResult nominal = runClosedLoop(plant, 1.0f, false, 0);
+        struct closedLoopResult smith = runClosedLoop(plant, SMITH_GAIN_SCALE, true,
+                                                      SMITH_DELAY);
+
+        char name[40];
+        snprintf(name, sizeof(name), "K x %.1f, tau x %.1f", gains[i], timeConstants[i]);
+        printResult(name, nominal);
+        printResult("  predictor, raised gains", smith);
+
+        // The error between the plant and the model is still fed back, so the
+        // loop settles and still tracks better than without the predictor
+        assert(smith.absError < nominal.absError);
+    }
+
+    printf("  ");
+}
+
+static void measureCycles(void) {
+    struct pidParameters params = PID_DEFAULT_PARAMETERS;
+
+    struct pidController pid;
+    pidInit(&pid, &params, &setpointReg, &predictedFeedbackReg, &controlReg);
+
+    feedbackReg = 0.0f;
+    controlReg = 0.0f;
+
+    struct smithPredictor smith;
+    smithInit(&smith, DC_GAIN, TIME_CONSTANT, FS, SMITH_DELAY,
+              &feedbackReg, &predictedFeedbackReg, &controlReg);
+
+    setpointReg = 15.0f;
+
+    uint64_t pidBest = UINT64_MAX, smithBest = UINT64_MAX;
+
+    for (int r = 0; r < NUM_REPEATS; r++) {
+        uint64_t start = benchTime();
+        for (int i = 0; i < NUM_SAMPLES; i++) {
+            feedbackReg = (float)(i & 15);
+            runControlAlgorithm(&pid);
+        }
+        uint64_t elapsed = benchTime() - start;
+        if (elapsed < pidBest)
+            pidBest = elapsed;
+
+        start = benchTime();
+        for (int i = 0; i < NUM_SAMPLES; i++) {
+            feedbackReg = (float)(i & 15);
+            smithPredict(&smith);
+            runControlAlgorithm(&pid);
+            smithUpdate(&smith);
+        }
+        elapsed = benchTime() - start;
+        if (elapsed < smithBest)
+            smithBest = elapsed;
+    }
+
+    double pidCost = (double)pidBest / NUM_SAMPLES;
+    double smithCost = (double)smithBest / NUM_SAMPLES;
+
+    printf("runControlAlgorithm:            %6.1f %s/sample\n", pidCost, BENCH_UNIT);
+    printf("with the Smith predictor:       %6.1f %s/sample (+%.1f)\n",
+           smithCost, BENCH_UNIT, smithCost - pidCost);
+}
+
+// Step the setpoint between 10 and 20 rpm as in system.c. The model of the
+// predictor is always the nominal motor with modelDelay samples of delay.
+static struct closedLoopResult runClosedLoop(struct plantModel plant, float gainScale,
+                                             bool usePredictor, uint32_t modelDelay) {
+    struct pidParameters params = PID_DEFAULT_PARAMETERS;
+    params.kp *= gainScale;
+    params.ki *= gainScale;
+
+    feedbackReg = 0.0f;
+    controlReg = 0.0f;
+
+    struct pidController pid;
+    struct smithPredictor smith;
+
+    if (usePredictor) {
+        pidInit(&pid, &params, &setpointReg, &predictedFeedbackReg, &controlReg);
+        smithInit(&smith, DC_GAIN, TIME_CONSTANT, FS, modelDelay,
+                  &feedbackReg, &predictedFeedbackReg, &controlReg);
+    } else {
+        pidInit(&pid, &params, &setpointReg, &feedbackReg, &controlReg);
+    }
+
+    float ts = 1.0f / FS;
+    struct motor motor = {
+        .dcGain = plant.dcGain,
+        .timeConstant = plant.timeConstant,
+        .angularVelocity = 0.0f,
+        .coeffV = ts * plant.dcGain / (ts + plant.timeConstant),
+        .coeffW = plant.timeConstant / (ts + plant.timeConstant)
+    };
+
+    // Voltages waiting to be applied to the motor
+    float delayLine[MAX_PLANT_DELAY] = { 0 };
+    uint32_t delayIndex = 0;
+
+    struct closedLoopResult result = { 0.0f, 0.0f };
+
+    for (int i = 0; i < 4 * STEP_SAMPLES; i++) {
+        setpointReg = (i / STEP_SAMPLES) % 2 ? 20.0f : 10.0f;
+        feedbackReg = motor.angularVelocity;
+
+        if (usePredictor) {
+            smithPredict(&smith);
+            runControlAlgorithm(&pid);
+            smithUpdate(&smith);
+        } else {
+            runControlAlgorithm(&pid);
+        }
+
+        float voltage = controlReg;
+        if (plant.delay > 0) {
+            float delayed = delayLine[delayIndex];
+            delayLine[delayIndex] = voltage;
+            if (++delayIndex >= plant.delay)
+                delayIndex = 0;
+            voltage = delayed;
+        }
+
+        calculateAngularVelocity(&motor, voltage);
+
+        float error = setpointReg - motor.angularVelocity;
+        result.absError += fabsf(error) / (4 * STEP_SAMPLES);
+
+        // Overshoot beyond the setpoint in the direction of the last step,
+        // ignoring the first step from rest
+        if (i >= STEP_SAMPLES) {
+            float overshoot = ((i / STEP_SAMPLES) % 2 ? -error : error) / 10.0f;
+            if (overshoot > result.overshoot)
+                result.overshoot = overshoot;
+        }
+    }
+
+    return result;
+}
+
+static void printResult(const char *name, struct closedLoopResult result) {
+    printf("  %-30s mean |error| %6.3f rpm, overshoot %5.1f%%\n",
+           name, result.absError, 100.0 * result.overshoot);
+}
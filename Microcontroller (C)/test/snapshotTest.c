@@ -0,0 +1,300 @@
+/* snapshotTest.c
+ * Tests for the controller state snapshots used for a warm restart.
+ *
+ * The CRC is checked against the standard check value, and snapshots are
+ * saved and restored through a store filled with garbage (as after a power-on
+ * reset), with the latest slot torn (as after a reset during a save) and
+ * across the wrap of the sequence number. A reset of the velocity controller
+ * while the motor is running is then simulated with and without the snapshot,
+ * and the time to save and restore a snapshot is measured.
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team.
+ */
+
+#include "benchmark.h"
+
+#include "Snapshot.h"
+#include "PIDController.h"
+#include "Motor.h"
+
+#include "MotorParameters.h"
+#include "ControllerParameters.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define NUM_REPEATS     1000
+
+volatile float setpointReg, feedbackReg, controlReg;
+volatile float positionSetpointReg, positionFeedbackReg;
+
+static struct snapshotStore store;
+
+static void test_crc(void);
+static void test_powerOn(void);
+static void test_saveRestore(void);
+static void test_tornSave(void);
+static void test_sequenceWrap(void);
+static void test_warmRestart(void);
+static void measureCycles(void);
+
+static void setStates(struct pidController *pid, float offset);
+static bool statesEqual(const struct pidController *pid, float offset);
+static float runAfterReset(bool restore);
+
+int main(void) {
+    printf("Testing CRC ... ");
+    test_crc();
+    printf("Done!\n");
+
+    printf("Testing power-on reset ... ");
+    test_powerOn();
+    printf("Done!\n");
+
+    printf("Testing save and restore ... ");
+    test_saveRestore();
+    printf("Done!\n");
+
+    printf("Testing torn save ... ");
+    test_tornSave();
+    printf("Done!\n");
+
+    printf("Testing sequence wrap ... ");
+    test_sequenceWrap();
+    printf("Done!\n");
+
+    printf("Testing warm restart ... ");
+    test_warmRestart();
+    printf("Done!\n");
+
+    printf("\nAll tests completed successfully!\n\n");
+
+    measureCycles();
+
+    return EXIT_SUCCESS;
+}
+
+static void test_crc(void) {
+    assert(snapshotCrc32("123456789", 9) == 0xCBF43926u);
+    assert(snapshotCrc32("", 0) == 0x00000000u);
+}
+
+static void test_powerOn(void) {
+    struct pidParameters params = PID_DEFAULT_PARAMETERS;
+    struct pidController pid;
+    pidInit(&pid, &params, &setpointReg, &feedbackReg, &controlReg);
+    setStates(&pid, 1.0f);
+
+    struct pidController *controllers[] = { &pid };
+
+    // Random SRAM contents are never a valid snapshot
+    srand(1);
+    for (int trial = 0; trial < 1000; trial++) {
+        uint8_t *bytes = (uint8_t *)&store;
+        for (size_t i = 0; i < sizeof(store); i++)
+            bytes[i] = (uint8_t)rand();
+
+        assert(!snapshotRestore(&store, controllers, 1));
+        assert(statesEqual(&pid, 1.0f));
+    }
+
+    // Neither is a cleared store
+    snapshotClear(&store);
+    assert(!snapshotRestore(&store, controllers, 1));
+}
+
+static void test_saveRestore(void) {
+    struct pidParameters params = PID_DEFAULT_PARAMETERS;
+    struct pidController pid, positionPid;
+    pidInit(&pid, &params, &setpointReg, &feedbackReg, &controlReg);
+    pidInit(&positionPid, &params, &positionSetpointReg, &positionFeedbackReg, &setpointReg);
+
+    struct pidController *controllers[] = { &pid, &positionPid };
+
+    snapshotClear(&store);
+    for (int i = 0; i < 5; i++) {
+        setStates(&pid, (float)i);
+        setStates(&positionPid, 10.0f * i);
+        snapshotSave(&store, controllers, 2);
+    }
+
+    // A reset clears the controllers, and the last snapshot restores them
+    pidInit(&pid, &params, &setpointReg, &feedbackReg, &controlReg);
+    pidInit(&positionPid, &params, &positionSetpointReg, &positionFeedbackReg, &setpointReg);
+    store.nextSequence = 12345;
+
+    assert(snapshotRestore(&store, controllers, 2));
+    assert(statesEqual(&pid, 4.0f) && statesEqual(&positionPid, 40.0f));
+    assert(store.nextSequence == 5);
+
+    // A different set of controllers is not restored
+    assert(!snapshotRestore(&store, controllers, 1));
+}
+
+static void test_tornSave(void) {
+    struct pidParameters params = PID_DEFAULT_PARAMETERS;
+    struct pidController pid;
+    pidInit(&pid, &params, &setpointReg, &feedbackReg, &controlReg);
+
+    struct pidController *controllers[] = { &pid };
+
+    snapshotClear(&store);
+    setStates(&pid, 1.0f);
+    snapshotSave(&store, controllers, 1);
+    setStates(&pid, 2.0f);
+    snapshotSave(&store, controllers, 1);
+
+    // A reset part way through the next save leaves its slot with a new
+    // sequence number and state but the old CRC
+    struct snapshot *slot = &store.slots[store.nextSequence & 1];
+    slot->sequence = store.nextSequence;
+    slot->states[0].integrator = 3.0f;
+
+    setStates(&pid, 0.0f);
+    assert(snapshotRestore(&store, controllers, 1));
+    assert(statesEqual(&pid, 2.0f));
+
+    // Saving continues over the torn slot
+    assert(store.nextSequence == 2);
+    setStates(&pid, 4.0f);
+    snapshotSave(&store, controllers, 1);
+    setStates(&pid, 0.0f);
+    assert(snapshotRestore(&store, controllers, 1));
+    assert(statesEqual(&pid, 4.0f));
+}
+
+static void test_sequenceWrap(void) {
+    struct pidParameters params = PID_DEFAULT_PARAMETERS;
+    struct pidController pid;
+    pidInit(&pid, &params, &setpointReg, &feedbackReg, &controlReg);
+
+    struct pidController *controllers[] = { &pid };
+
+    snapshotClear(&store);
+    store.nextSequence = UINT32_MAX;
+
+    setStates(&pid, 1.0f);
+    snapshotSave(&store, controllers, 1);
+    setStates(&pid, 2.0f);
+    snapshotSave(&store, controllers, 1);
+
+    // Sequence 0 follows UINT32_MAX
+    setStates(&pid, 0.0f);
+    assert(snapshotRestore(&store, controllers, 1));
+    assert(statesEqual(&pid, 2.0f));
+    assert(store.nextSequence == 1);
+}
+
+static void test_warmRestart(void) {
+    float cold = runAfterReset(false);
+    float warm = runAfterReset(true);
+
+    printf("\n  Largest speed error in the second after a reset at 20 rpm:\n");
+    printf("    Cold restart: %.3f rpm\n", cold);
+    printf("    Warm restart: %.3f rpm\n  ", warm);
+
+    // After a cold restart the integrator has to wind back up from zero, while
+    // a warm restart carries on as if there had been no reset
+    assert(cold > 2.0f);
+    assert(warm < 0.01f);
+}
+
+static void measureCycles(void) {
+    struct pidParameters params = PID_DEFAULT_PARAMETERS;
+    struct pidController pid, positionPid;
+    pidInit(&pid, &params, &setpointReg, &feedbackReg, &controlReg);
+    pidInit(&positionPid, &params, &positionSetpointReg, &positionFeedbackReg, &setpointReg);
+    setStates(&pid, 1.0f);
+    setStates(&positionPid, 2.0f);
+
+    struct pidController *controllers[] = { &pid, &positionPid };
+
+    snapshotClear(&store);
+
+    uint64_t saveBest = UINT64_MAX, restoreBest = UINT64_MAX;
+
+    for (int r = 0; r < NUM_REPEATS; r++) {
+        uint64_t start = benchTime();
+        snapshotSave(&store, controllers, 2);
+        uint64_t elapsed = benchTime() - start;
+        if (elapsed < saveBest)
+            saveBest = elapsed;
+
+        start = benchTime();
+        bool restored = snapshotRestore(&store, controllers, 2);
+        elapsed = benchTime() - start;
+        if (elapsed < restoreBest)
+            restoreBest = elapsed;
+
+        assert(restored);
+    }
+
+    printf("Snapshot of 2 controllers (%u bytes per slot):\n",
+           (unsigned)sizeof(struct snapshot));
+    printf("snapshotSave:    %6.0f %s\n", (double)saveBest, BENCH_UNIT);
+    printf("snapshotRestore: %6.0f %s\n", (double)restoreBest, BENCH_UNIT);
+}
+
+// Give every state of a controller a distinct value
+static void setStates(struct pidController *pid, float offset) {
+    pid->integrator = offset + 0.25f;
+    pid->differentiator = offset + 0.5f;
+    pid->prevError = offset + 0.75f;
+}
+
+static bool statesEqual(const struct pidController *pid, float offset) {
+    return pid->integrator == offset + 0.25f
+           && pid->differentiator == offset + 0.5f
+           && pid->prevError == offset + 0.75f;
+}
+
+// Run the velocity loop at 20 rpm, saving a snapshot every sample, then reset
+// the controller while the motor keeps turning. Returns the largest speed
+// error in the second after the reset.
+static float runAfterReset(bool restore) {
+    struct pidParameters params = PID_DEFAULT_PARAMETERS;
+    struct pidController pid;
+    pidInit(&pid, &params, &setpointReg, &feedbackReg, &controlReg);
+
+    struct pidController *controllers[] = { &pid };
+    snapshotClear(&store);
+
+    struct motor motor = {
+        .dcGain = DC_GAIN,
+        .timeConstant = TIME_CONSTANT,
+        .angularVelocity = 0.0f,
+        .coeffV = COEFF_V,
+        .coeffW = COEFF_W
+    };
+
+    setpointReg = 20.0f;
+    for (int i = 0; i < 10 * (int)FS; i++) {
+        feedbackReg = motor.angularVelocity;
+        runControlAlgorithm(&pid);
+        snapshotSave(&store, controllers, 1);
+        calculateAngularVelocity(&motor, controlReg);
+    }
+
+    // Reset: the controller memory is cleared but the store is not
+    pidInit(&pid, &params, &setpointReg, &feedbackReg, &controlReg);
+    if (restore)
+        assert(snapshotRestore(&store, controllers, 1));
+
+    float worst = 0.0f;
+    for (int i = 0; i < (int)FS; i++) {
+        feedbackReg = motor.angularVelocity;
+        runControlAlgorithm(&pid);
+        calculateAngularVelocity(&motor, controlReg);
+
+        float error = fabsf(setpointReg - motor.angularVelocity);
+        if (error > worst)
+            worst = error;
+    }
+
+    return worst;
+}
@@ -0,0 +1,204 @@
+/* stateSpaceBenchmark.c
+ *
+ * Host benchmark comparing the state-space form of the PID controller
+ * (StateSpacePID.h) with runControlAlgorithm() and runFixControlAlgorithm().
+ *
+ * The floating point state-space controller is run in closed loop with the
+ * simulated motor alongside runControlAlgorithm() to check that they agree,
+ * then the cost of a single step is measured for each controller.
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team
+ */
+
+#include "benchmark.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "PIDController.h"
+#include "StateSpace.h"
+#include "StateSpacePID.h"
+#include "Motor.h"
+
+#include "MotorParameters.h"
+#include "ControllerParameters.h"
+
+#define ZERO 0.0f
+
+#define NUM_SAMPLES     1000
+#define NUM_REPEATS     200
+
+#define TOLERANCE       1E-4f
+
+static const float pidA[SS_PID_NX][SS_PID_NX] = SS_PID_A;
+static const float pidB[SS_PID_NX][SS_PID_NU] = SS_PID_B;
+static const float pidC[SS_PID_NY][SS_PID_NX] = SS_PID_C;
+static const float pidD[SS_PID_NY][SS_PID_NU] = SS_PID_D;
+
+static const fix_t fixPidA[SS_PID_NX][SS_PID_NX] = SS_PID_FIX_A;
+static const fix_t fixPidB[SS_PID_NX][SS_PID_NU] = SS_PID_FIX_B;
+static const fix_t fixPidC[SS_PID_NY][SS_PID_NX] = SS_PID_FIX_C;
+static const fix_t fixPidD[SS_PID_NY][SS_PID_NU] = SS_PID_FIX_D;
+
+STATE_SPACE_DEFINE(pidStateSpace, SS_PID_NX, SS_PID_NU, SS_PID_NY,
+                   pidA, pidB, pidC, pidD)
+
+STATE_SPACE_DEFINE_FIX(fixPidStateSpace, SS_PID_NX, SS_PID_NU, SS_PID_NY,
+                       fixPidA, fixPidB, fixPidC, fixPidD)
+
+// Out of line state-space PID steps including saturation, so that they are
+// timed as complete controllers
+__attribute__((noinline))
+float stateSpaceStep3(struct pidStateSpaceState *state, float setpoint, float feedback) {
+    float u[SS_PID_NU] = { setpoint, feedback };
+    float y;
+    pidStateSpace(state, u, &y);
+
+    if (y < OUTPUT_MIN)
+        y = OUTPUT_MIN;
+    else if (y > OUTPUT_MAX)
+        y = OUTPUT_MAX;
+
+    return y;
+}
+
+__attribute__((noinline))
+fix_t stateSpaceStepFix3(struct fixPidStateSpaceState *state, fix_t setpoint, fix_t feedback) {
+    fix_t u[SS_PID_NU] = { setpoint, feedback };
+    fix_t y;
+    fixPidStateSpace(state, u, &y);
+
+    if (y < FIX_OUTPUT_MIN)
+        y = FIX_OUTPUT_MIN;
+    else if (y > FIX_OUTPUT_MAX)
+        y = FIX_OUTPUT_MAX;
+
+    return y;
+}
+
+volatile float setpointReg, feedbackReg, controlReg;
+volatile fix_t fixSetpointReg, fixFeedbackReg, fixControlReg;
+
+static float setpoints[NUM_SAMPLES];
+static float feedbacks[NUM_SAMPLES];
+static fix_t fixSetpoints[NUM_SAMPLES];
+static fix_t fixFeedbacks[NUM_SAMPLES];
+
+int main(void) {
+    struct pidController pid;
+    struct pidParameters params = PID_DEFAULT_PARAMETERS;
+    pidInit(&pid, &params, &setpointReg, &feedbackReg, &controlReg);
+
+    struct fixPidController fixPid = {
+        .propCoeff1 = FIX_PROP_COEFF1, .propCoeff2 = FIX_PROP_COEFF2,
+        .intCoeff = FIX_INT_COEFF,
+        .derCoeff1 = FIX_DER_COEFF1, .derCoeff2 = FIX_DER_COEFF2,
+        .derCoeff3 = FIX_DER_COEFF3,
+        .outputMin = FIX_OUTPUT_MIN, .outputMax = FIX_OUTPUT_MAX,
+
+        .setpoint = &fixSetpointReg,
+        .feedback = &fixFeedbackReg,
+        .controlSignal = &fixControlReg,
+
+        .integrator = 0,
+        .differentiator = 0,
+        .prevError = 0
+    };
+
+    struct pidStateSpaceState state = { { ZERO } };
+    struct fixPidStateSpaceState fixState = { { 0 } };
+
+    struct motor motor = {
+        .dcGain = DC_GAIN,
+        .timeConstant = TIME_CONSTANT,
+        .angularVelocity = ZERO,
+        .coeffV = COEFF_V,
+        .coeffW = COEFF_W
+    };
+
+    // Closed loop comparison
+    // -------------------------------------------------------------------------
+    float maxDifference = ZERO;
+
+    for (int i = 0; i < NUM_SAMPLES; i++) {
+        setpoints[i] = ((i / 100) % 2) ? 20.0f : 10.0f;
+        feedbacks[i] = motor.angularVelocity;
+        fixSetpoints[i] = FIX_POINT(setpoints[i]);
+        fixFeedbacks[i] = FIX_POINT(feedbacks[i]);
+
+        setpointReg = setpoints[i];
+        feedbackReg = feedbacks[i];
+        float generic = runControlAlgorithm(&pid);
+        float stateSpace = stateSpaceStep3(&state, setpoints[i], feedbacks[i]);
+
+        float difference = fabsf(generic - stateSpace);
+        if (difference > maxDifference)
+            maxDifference = difference;
+
+        calculateAngularVelocity(&motor, generic);
+    }
+
+    printf("Largest difference from runControlAlgorithm: %g V\n", maxDifference);
+
+    // Timing
+    // -------------------------------------------------------------------------
+    uint64_t genericBest = UINT64_MAX, stateSpaceBest = UINT64_MAX;
+    uint64_t fixBest = UINT64_MAX, fixStateSpaceBest = UINT64_MAX;
+
+    for (int r = 0; r < NUM_REPEATS; r++) {
+        uint64_t start = benchTime();
+        for (int i = 0; i < NUM_SAMPLES; i++) {
+            setpointReg = setpoints[i];
+            feedbackReg = feedbacks[i];
+            runControlAlgorithm(&pid);
+        }
+        uint64_t elapsed = benchTime() - start;
+        if (elapsed < genericBest)
+            genericBest = elapsed;
+
+        start = benchTime();
+        for (int i = 0; i < NUM_SAMPLES; i++) {
+            setpointReg = setpoints[i];
+            feedbackReg = feedbacks[i];
+            controlReg = stateSpaceStep3(&state, setpointReg, feedbackReg);
+        }
+        elapsed = benchTime() - start;
+        if (elapsed < stateSpaceBest)
+            stateSpaceBest = elapsed;
+
+        start = benchTime();
+        for (int i = 0; i < NUM_SAMPLES; i++) {
+            fixSetpointReg = fixSetpoints[i];
+            fixFeedbackReg = fixFeedbacks[i];
+            runFixControlAlgorithm(&fixPid);
+        }
+        elapsed = benchTime() - start;
+        if (elapsed < fixBest)
+            fixBest = elapsed;
+
+        start = benchTime();
+        for (int i = 0; i < NUM_SAMPLES; i++) {
+            fixSetpointReg = fixSetpoints[i];
+            fixFeedbackReg = fixFeedbacks[i];
+            fixControlReg = stateSpaceStepFix3(&fixState, fixSetpointReg, fixFeedbackReg);
+        }
+        elapsed = benchTime() - start;
+        if (elapsed < fixStateSpaceBest)
+            fixStateSpaceBest = elapsed;
+    }
+
+    printf("runControlAlgorithm:    %6.1f %s/step\n",
+           (double)genericBest / NUM_SAMPLES, BENCH_UNIT);
+    printf("state-space (float):    %6.1f %s/step\n",
+           (double)stateSpaceBest / NUM_SAMPLES, BENCH_UNIT);
+    printf("runFixControlAlgorithm: %6.1f %s/step\n",
+           (double)fixBest / NUM_SAMPLES, BENCH_UNIT);
+    printf("state-space (fixed):    %6.1f %s/step\n",
+           (double)fixStateSpaceBest / NUM_SAMPLES, BENCH_UNIT);
+
+    return (maxDifference < TOLERANCE) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,217 @@
+/* trajectoryTest.c
+ * Tests for the setpoint trajectory generator.
+ *
+ * Author: Aaron Lucas
+ * Date Created: 2026/10/16
+ *
+ * Written for the Off-World Robotics Team.
+ */
+
+#include "benchmark.h"
+
+#include "Trajectory.h"
+#include "PIDController.h"
+#include "Motor.h"
+
+#include "MotorParameters.h"
+#include "ControllerParameters.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define NUM_SAMPLES     500
+#define NUM_REPEATS     200
+
+#define RATE_INCREMENT  TRAJECTORY_RATE_INCREMENT(TRAJ_MAX_ACCEL, FS)
+#define JERK_INCREMENT  TRAJECTORY_JERK_INCREMENT(TRAJ_MAX_JERK, FS)
+
+volatile float commandReg, setpointReg, feedbackReg, controlReg;
+
+static void test_ramp(void);
+static void test_sCurve(void);
+static void test_closedLoop(void);
+static void measureCycles(void);
+
+static void checkProfile(enum trajectoryProfile profile, float from, float to);
+static float maxControlSignal(bool useTrajectory);
+
+int main(void) {
+    printf("Testing ramp profile ... ");
+    test_ramp();
+    printf("Done!\n");
+
+    printf("Testing S-curve profile ... ");
+    test_sCurve();
+    printf("Done!\n");
+
+    printf("Testing closed loop step ... ");
+    test_closedLoop();
+    printf("Done!\n");
+
+    printf("\nAll tests completed successfully!\n\n");
+
+    measureCycles();
+
+    return EXIT_SUCCESS;
+}
+
+static void test_ramp(void) {
+    checkProfile(TRAJECTORY_RAMP, 10.0f, 20.0f);
+    checkProfile(TRAJECTORY_RAMP, 20.0f, 10.0f);
+    checkProfile(TRAJECTORY_RAMP, 0.0f, 0.013f);
+}
+
+static void test_sCurve(void) {
+    checkProfile(TRAJECTORY_SCURVE, 10.0f, 20.0f);
+    checkProfile(TRAJECTORY_SCURVE, 20.0f, 10.0f);
+    checkProfile(TRAJECTORY_SCURVE, -5.0f, 3.7f);
+    checkProfile(TRAJECTORY_SCURVE, 0.0f, 0.013f);
+
+    // Reverse the command while still moving
+    struct trajectory traj;
+    commandReg = 10.0f;
+    trajectoryInit(&traj, TRAJECTORY_SCURVE, RATE_INCREMENT, JERK_INCREMENT,
+                   &commandReg, &setpointReg);
+
+    commandReg = 20.0f;
+    for (int i = 0; i < 10; i++)
+        runTrajectory(&traj);
+
+    commandReg = 10.0f;
+    fix_t prevRate = traj.rate;
+    for (int i = 0; i < NUM_SAMPLES; i++) {
+        runTrajectory(&traj);
+        assert(abs(traj.rate - prevRate) <= JERK_INCREMENT);
+        prevRate = traj.rate;
+    }
+    assert(setpointReg == 10.0f);
+}
+
+static void test_closedLoop(void) {
+    float direct = maxControlSignal(false);
+    float shaped = maxControlSignal(true);
+
+    printf("\n    Peak control signal: %.2f V direct, %.2f V with trajectory ... ",
+           direct, shaped);
+
+    assert(shaped < direct);
+}
+
+// Step the command and check the setpoint reaches it exactly, without
+// overshoot, and that the limits are never exceeded
+static void checkProfile(enum trajectoryProfile profile, float from, float to) {
+    struct trajectory traj;
+    commandReg = from;
+    trajectoryInit(&traj, profile, RATE_INCREMENT, JERK_INCREMENT,
+                   &commandReg, &setpointReg);
+    assert(setpointReg == from);
+
+    commandReg = to;
+    fix_t prevRate = 0;
+    fix_t prevSetpoint = traj.setpoint;
+    bool reached = false;
+
+    for (int i = 0; i < NUM_SAMPLES; i++) {
+        float setpoint = runTrajectory(&traj);
+
+        assert(abs(traj.setpoint - prevSetpoint) <= RATE_INCREMENT);
+        if (profile == TRAJECTORY_SCURVE)
+            assert(abs(traj.rate - prevRate) <= JERK_INCREMENT || reached);
+
+        if (to > from)
+            assert(setpoint <= to);
+        else
+            assert(setpoint >= to);
+
+        reached = reached || (setpoint == to);
+        prevRate = traj.rate;
+        prevSetpoint = traj.setpoint;
+    }
+
+    assert(reached);
+    assert(setpointReg == to);
+    assert(traj.rate == 0);
+}
+
+// Largest control signal in a step from 10 to 20 rpm, as in system.c
+static float maxControlSignal(bool useTrajectory) {
+    struct pidController pid;
+    struct pidParameters params = PID_DEFAULT_PARAMETERS;
+    pidInit(&pid, &params, &setpointReg, &feedbackReg, &controlReg);
+
+    struct trajectory traj;
+    commandReg = 10.0f;
+    setpointReg = commandReg;
+    trajectoryInit(&traj, TRAJECTORY_SCURVE, RATE_INCREMENT, JERK_INCREMENT,
+                   &commandReg, &setpointReg);
+
+    struct motor motor = {
+        .dcGain = DC_GAIN,
+        .timeConstant = TIME_CONSTANT,
+        .angularVelocity = 0.0f,
+        .coeffV = COEFF_V,
+        .coeffW = COEFF_W
+    };
+
+    // Settle at the initial speed
+    for (int i = 0; i < NUM_SAMPLES; i++) {
+        feedbackReg = motor.angularVelocity;
+        runControlAlgorithm(&pid);
+        calculateAngularVelocity(&motor, controlReg);
+    }
+
+    float maxControl = 0.0f;
+    commandReg = 20.0f;
+    for (int i = 0; i < NUM_SAMPLES; i++) {
+        if (useTrajectory)
+            runTrajectory(&traj);
+        else
+            setpointReg = commandReg;
+
+        feedbackReg = motor.angularVelocity;
+        runControlAlgorithm(&pid);
+        calculateAngularVelocity(&motor, controlReg);
+
+        if (controlReg > maxControl)
+            maxControl = controlReg;
+    }
+
+    return maxControl;
+}
+
+// Measure the fastest and slowest step over a transition to show that the cost
+// of a step is bounded
+static void measureCycles(void) {
+    struct trajectory traj;
+    uint64_t best[NUM_SAMPLES], fastest = UINT64_MAX, slowest = 0;
+
+    for (int i = 0; i < NUM_SAMPLES; i++)
+        best[i] = UINT64_MAX;
+
+    for (int r = 0; r < NUM_REPEATS; r++) {
+        commandReg = 10.0f;
+        trajectoryInit(&traj, TRAJECTORY_SCURVE, RATE_INCREMENT, JERK_INCREMENT,
+                       &commandReg, &setpointReg);
+        commandReg = 20.0f;
+
+        for (int i = 0; i < NUM_SAMPLES; i++) {
+            uint64_t start = benchTime();
+            runTrajectory(&traj);
+            uint64_t elapsed = benchTime() - start;
+            if (elapsed < best[i])
+                best[i] = elapsed;
+        }
+    }
+
+    for (int i = 0; i < NUM_SAMPLES; i++) {
+        if (best[i] < fastest)
+            fastest = best[i];
+        if (best[i] > slowest)
+            slowest = best[i];
+    }
+
+    printf("runTrajectory (S-curve): %u to %u %s/step, including timer overhead\n",
+           (unsigned)fastest, (unsigned)slowest, BENCH_UNIT);
+}
@@ -0,0 +1,90 @@
+function exportStateSpace(sys, name, filename)
+% exportStateSpace  Write a discrete state-space controller to a C header
+%
+%   exportStateSpace(sys, name, filename) writes the dimensions and matrices
+%   of the discrete state-space model sys to the header file filename, for use
+%   with STATE_SPACE_DEFINE() and STATE_SPACE_DEFINE_FIX() in StateSpace.h.
+%
+%   All definitions are prefixed with name (converted to upper case):
+%
+%       NAME_NX, NAME_NU, NAME_NY       Number of states, inputs and outputs
+%       NAME_A, NAME_B, NAME_C, NAME_D  Floating point matrix initialisers
+%       NAME_FIX_A, ..., NAME_FIX_D     Fixed point matrix initialisers
+%
+%   A continuous model is discretised with the sample time Ts from
+%   updateParameters.m (zero-order hold).
+%
+%   Example (lead compensator acting on the error):
+%
+%       updateParameters;
+%       lead = ss(tf([0.05 1], [0.01 1]));
+%       exportStateSpace(lead, 'lead', '../Microcontroller (C)/src/LeadController.h');
+%
+%   Author: Aaron Lucas
+%   Date Created: 2026/10/16
+%
+%   Written for the Off-World Robotics Team
+
+if sys.Ts == 0
+    updateParameters;
+    sys = c2d(sys, Ts, 'zoh');
+end
+
+sys = ss(sys);
+[A, B, C, D] = ssdata(sys);
+
+name = upper(name);
+[~, headerName, ~] = fileparts(filename);
+guard = [upper(regexprep(headerName, '([a-z])([A-Z])', '$1_$2')) '_H'];
+
+fid = fopen(filename, 'w');
+if fid < 0
+    error('Could not open %s for writing', filename);
+end
+
+fprintf(fid, '/*\n * %s.h\n *\n', headerName);
+fprintf(fid, ' * Discrete state-space controller exported by exportStateSpace.m on %s.\n', ...
+        datestr(now, 'yyyy/mm/dd'));
+fprintf(fid, ' * Sample time: %g s\n *\n', sys.Ts);
+fprintf(fid, ' * Do not edit this file by hand.\n */\n\n');
+
+fprintf(fid, '#ifndef %s\n#define %s\n\n', guard, guard);
+fprintf(fid, '#include "fix_t.h"\n\n');
+
+fprintf(fid, '#define %s_NX %d\n', name, size(A, 1));
+fprintf(fid, '#define %s_NU %d\n', name, size(B, 2));
+fprintf(fid, '#define %s_NY %d\n\n', name, size(C, 1));
+
+matrices = {A, B, C, D};
+labels = {'A', 'B', 'C', 'D'};
+
+for m = 1:numel(matrices)
+    writeMatrix(fid, sprintf('%s_%s', name, labels{m}), matrices{m}, '%.9gf');
+end
+
+for m = 1:numel(matrices)
+    writeMatrix(fid, sprintf('%s_FIX_%s', name, labels{m}), matrices{m}, 'FIX_POINT(%.9g)');
+end
+
+fprintf(fid, '#endif\n');
+fclose(fid);
+
+end
+
+function writeMatrix(fid, macro, M, format)
+% Write a matrix as a two-dimensional array initialiser macro
+
+fprintf(fid, '#define %s { \\\n', macro);
+
+for i = 1:size(M, 1)
+    entries = arrayfun(@(x) sprintf(format, x), M(i, :), 'UniformOutput', false);
+    separator = ',';
+    if i == size(M, 1)
+        separator = '';
+    end
+    fprintf(fid, '        { %s }%s \\\n', strjoin(entries, ', '), separator);
+end
+
+fprintf(fid, '    }\n\n');
+
+end
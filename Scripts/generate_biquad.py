@@ -0,0 +1,172 @@
+"""
+generate_biquad.py
+
+Generate the coefficients of a cascaded biquad filter (Biquad.h) for
+conditioning the feedback or setpoint of the microcontroller controllers.
+
+The filter is built from any number of stages, low-pass stages first:
+
+    --lowpass FREQ ORDER    Butterworth low-pass filter. Even orders use ORDER / 2
+                            second-order sections; odd orders add a first-order
+                            section.
+    --notch FREQ Q          Notch filter removing FREQ, with a -3 dB bandwidth of
+                            FREQ / Q.
+
+Second-order sections use the bilinear transform designs of R. Bristow-Johnson's
+"Audio EQ Cookbook", with the frequency prewarped so that the cut-off and notch
+frequencies are exact. Coefficients are normalised so that a0 = 1 and written in
+the order { b0, b1, b2, a1, a2 } for the direct form II transposed sections:
+
+    y = b0 x + s1,  s1 = b1 x - a1 y + s2,  s2 = b2 x - a2 y
+
+Both floating point and fixed point (FIX_POINT()) initialisers are written.
+
+Example (the feedback filter in FeedbackFilter.h):
+
+    python3 generate_biquad.py --lowpass 10 2
+
+Author: Aaron Lucas
+Date Created: 2026/10/16
+
+Written for the Off-World Robotics Team
+"""
+
+import argparse
+import cmath
+import math
+import os
+import re
+
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+SRC_DIR = os.path.join(SCRIPT_DIR, '..', 'Microcontroller (C)', 'src')
+
+
+def read_define(path, name):
+    """Read the numeric value of a simple #define from a header file."""
+    with open(path) as header:
+        for line in header:
+            match = re.match(rf'\s*#define\s+{name}\s+(-?[0-9.eE+-]+)f?\b', line)
+            if match:
+                return float(match.group(1))
+    raise ValueError(f'{name} not found in {path}')
+
+
+def normalise(b0, b1, b2, a0, a1, a2):
+    return (b0 / a0, b1 / a0, b2 / a0, a1 / a0, a2 / a0)
+
+
+def lowpass_section(freq, q, fs):
+    """Cookbook second-order low-pass section."""
+    w0 = 2 * math.pi * freq / fs
+    alpha = math.sin(w0) / (2 * q)
+    cos_w0 = math.cos(w0)
+    return normalise((1 - cos_w0) / 2, 1 - cos_w0, (1 - cos_w0) / 2,
+                     1 + alpha, -2 * cos_w0, 1 - alpha)
+
+
+def first_order_lowpass_section(freq, fs):
+    """First-order low-pass section by the bilinear transform."""
+    k = math.tan(math.pi * freq / fs)
+    return normalise(k, k, 0.0, k + 1, k - 1, 0.0)
+
+
+def notch_section(freq, q, fs):
+    """Cookbook notch section."""
+    w0 = 2 * math.pi * freq / fs
+    alpha = math.sin(w0) / (2 * q)
+    cos_w0 = math.cos(w0)
+    return normalise(1, -2 * cos_w0, 1, 1 + alpha, -2 * cos_w0, 1 - alpha)
+
+
+def butterworth(freq, order, fs):
+    """Sections of a Butterworth low-pass filter."""
+    sections = []
+    for k in range(order // 2):
+        q = 1 / (2 * math.cos((2 * k + 1) * math.pi / (2 * order)))
+        sections.append(lowpass_section(freq, q, fs))
+    if order % 2:
+        sections.append(first_order_lowpass_section(freq, fs))
+    return sections
+
+
+def response(sections, freq, fs):
+    """Magnitude of the frequency response of the cascade."""
+    z = cmath.exp(-2j * math.pi * freq / fs)
+    h = 1
+    for b0, b1, b2, a1, a2 in sections:
+        h *= (b0 + b1 * z + b2 * z * z) / (1 + a1 * z + a2 * z * z)
+    return abs(h)
+
+
+def c_float(x):
+    """Format a number as a C float literal."""
+    text = f'{x:.9g}'
+    if not any(ch in text for ch in '.en'):
+        text += '.0'
+    return text + 'f'
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate cascaded biquad filter coefficients.')
+    parser.add_argument('--lowpass', nargs=2, action='append', default=[], type=float,
+                        metavar=('FREQ', 'ORDER'), help='Butterworth low-pass stage')
+    parser.add_argument('--notch', nargs=2, action='append', default=[], type=float,
+                        metavar=('FREQ', 'Q'), help='notch stage')
+    parser.add_argument('--fs', type=float, help='sample frequency (default FS in ControllerParameters.h)')
+    parser.add_argument('--name', default='FeedbackFilter', help='name of the header and its definitions')
+    parser.add_argument('--output', help='output file (default src/NAME.h)')
+    args = parser.parse_args()
+
+    fs = args.fs or read_define(os.path.join(SRC_DIR, 'ControllerParameters.h'), 'FS')
+    output = args.output or os.path.join(SRC_DIR, f'{args.name}.h')
+
+    sections = []
+    stages = []
+    for freq, order in args.lowpass:
+        sections += butterworth(freq, int(order), fs)
+        stages.append(f'Butterworth low-pass, {freq:g} Hz, order {int(order)}')
+    for freq, q in args.notch:
+        sections.append(notch_section(freq, q, fs))
+        stages.append(f'Notch, {freq:g} Hz, Q = {q:g}')
+
+    if not sections:
+        parser.error('at least one --lowpass or --notch stage is needed')
+    if any(freq >= fs / 2 for freq, _ in args.lowpass + args.notch):
+        parser.error('frequencies must be below the Nyquist frequency')
+
+    macro = re.sub(r'([a-z])([A-Z])', r'\1_\2', args.name).upper()
+
+    with open(output, 'w') as header:
+        header.write('/*\n')
+        header.write(f' * {args.name}.h\n')
+        header.write(' *\n')
+        header.write(' * Cascaded biquad filter coefficients for Biquad.h, generated by\n')
+        header.write(' * Scripts/generate_biquad.py. Do not edit this file by hand.\n')
+        header.write(' *\n')
+        header.write(f' * Sample frequency: {fs:g} Hz\n')
+        for stage in stages:
+            header.write(f' * {stage}\n')
+        header.write(' */\n\n')
+        header.write(f'#ifndef {macro}_H\n#define {macro}_H\n\n')
+        header.write('#include "fix_t.h"\n\n')
+
+        header.write(f'#define {macro}_SECTIONS {len(sections)}\n\n')
+
+        header.write('// Each section is { b0, b1, b2, a1, a2 }\n')
+        for name, fmt in ((f'{macro}_COEFFS', c_float),
+                          (f'{macro}_FIX_COEFFS', lambda x: f'FIX_POINT({x:.9g})')):
+            header.write(f'#define {name} {{ \\\n')
+            for i, section in enumerate(sections):
+                separator = ',' if i < len(sections) - 1 else ''
+                header.write('        { ' + ', '.join(fmt(x) for x in section) + f' }}{separator} \\\n')
+            header.write('    }\n\n')
+
+        header.write('#endif\n')
+
+    print(f'{len(sections)} sections written to {os.path.normpath(output)}')
+    for freq in (0, fs / 20, fs / 10, fs / 5, fs / 4, fs * 0.49):
+        print(f'  {freq:7.2f} Hz: {20 * math.log10(max(response(sections, freq, fs), 1e-12)):8.2f} dB')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,203 @@
+"""
+generate_gain_schedule.py
+
+Generate the gain schedule table for the velocity controller (GainSchedule.h)
+from the motor model used by the microcontroller code.
+
+The gains at each breakpoint are found by pole placement on the discrete model
+of the motor at that speed
+
+    w[k+1] = a w[k] + b u[k],  a = tau / (Ts + tau),  b = Ts K / (Ts + tau)
+
+The closed loop poles of the nominal gains (KP and KI in ControllerParameters.h)
+with the nominal model (MotorParameters.h) give the design damping and natural
+frequency. At each speed the poles are placed at the same damping and natural
+frequency, so the step response has the same shape wherever the motor
+operates. This is the same design as rlsTunePid() in RLSEstimator.c.
+
+The model at each speed is interpolated linearly between models at several
+speeds. By default these are the models of MotorParameters.h at rest
+(DC_GAIN, TIME_CONSTANT) and at full speed (DC_GAIN, TIME_CONSTANT_FULL_SPEED).
+Models measured at several speeds (e.g. with the online identification in
+RLSEstimator.h, or step tests on the bench) are given instead with
+--model SPEED GAIN TIME_CONSTANT. The number of different models is written as
+GAIN_SCHEDULE_MODELS. With fewer than two every breakpoint has the nominal
+gains, and such a table is only the starting point for building up the
+schedule on the board with ONLINE_IDENTIFICATION (see system.c).
+
+The breakpoints are uniformly spaced from zero to the largest speed the motor
+can reach within the output limits.
+
+Author: Aaron Lucas
+Date Created: 2026/10/16
+
+Written for the Off-World Robotics Team
+"""
+
+import argparse
+import cmath
+import math
+import os
+import re
+
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+SRC_DIR = os.path.join(SCRIPT_DIR, '..', 'Microcontroller (C)', 'src')
+
+
+def read_define(path, name):
+    """Read the numeric value of a simple #define from a header file."""
+    with open(path) as header:
+        for line in header:
+            match = re.match(rf'\s*#define\s+{name}\s+(-?[0-9.eE+-]+)f?\b', line)
+            if match:
+                return float(match.group(1))
+    raise ValueError(f'{name} not found in {path}')
+
+
+def discrete_model(K, tau, Ts):
+    return tau / (Ts + tau), Ts * K / (Ts + tau)
+
+
+def interpolate_model(models, speed):
+    """Interpolate (K, tau) from a list of (speed, K, tau) sorted by speed."""
+    if speed <= models[0][0]:
+        return models[0][1:]
+    for (s0, K0, t0), (s1, K1, t1) in zip(models, models[1:]):
+        if speed <= s1:
+            f = (speed - s0) / (s1 - s0)
+            return K0 + f * (K1 - K0), t0 + f * (t1 - t0)
+    return models[-1][1:]
+
+
+def design_poles(a, b, kp, ki, Ts):
+    """Damping and natural frequency of the closed loop poles.
+
+    runControlAlgorithm() is Kp + Ki Ts z / (z - 1), so with the motor b / (z - a)
+    the characteristic polynomial is z^2 + (b (Kp + Ki Ts) - 1 - a) z + (a - b Kp).
+    """
+    c1 = b * (kp + ki * Ts) - 1 - a
+    c0 = a - b * kp
+    root = cmath.sqrt(c1 * c1 - 4 * c0)
+    z = (-c1 + root) / 2
+    s = cmath.log(z) / Ts
+    wn = abs(s)
+    return -s.real / wn, wn
+
+
+def place_poles(a, b, zeta, wn, Ts):
+    """PI gains which place the closed loop poles at the given damping and natural frequency."""
+    s = wn * complex(-zeta, math.sqrt(max(0.0, 1 - zeta * zeta)))
+    z = cmath.exp(s * Ts)
+    c1 = -2 * z.real
+    c0 = abs(z) ** 2
+
+    # As in rlsTunePid(), a motor too fast for the poles has no proportional
+    # gain, and one which would need a negative integral gain is an error
+    kp = max((a - c0) / b, 0.0)
+    ki_ts = (c1 + 1 + a) / b - kp
+    if ki_ts < 0:
+        raise ValueError('the model is too fast for the design poles')
+    return kp, ki_ts / Ts
+
+
+def c_float(x):
+    """Format a number as a C float literal."""
+    text = f'{x:.9g}'
+    if not any(ch in text for ch in '.en'):
+        text += '.0'
+    return text + 'f'
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate the gain schedule table.')
+    parser.add_argument('--points', type=int, default=9, help='number of breakpoints')
+    parser.add_argument('--model', nargs=3, type=float, action='append', default=[],
+                        metavar=('SPEED', 'GAIN', 'TIME_CONSTANT'),
+                        help='motor model measured at a speed (may be repeated)')
+    parser.add_argument('--output', default=os.path.join(SRC_DIR, 'GainScheduleTable.h'))
+    args = parser.parse_args()
+
+    if args.points < 2:
+        parser.error('at least two breakpoints are needed')
+
+    motor = os.path.join(SRC_DIR, 'MotorParameters.h')
+    controller = os.path.join(SRC_DIR, 'ControllerParameters.h')
+
+    K = read_define(motor, 'DC_GAIN')
+    tau = read_define(motor, 'TIME_CONSTANT')
+    tau_full = read_define(motor, 'TIME_CONSTANT_FULL_SPEED')
+    fs = read_define(controller, 'FS')
+    kp = read_define(controller, 'KP')
+    ki = read_define(controller, 'KI')
+    kd = read_define(controller, 'KD')
+    N = read_define(controller, 'N')
+    u_max = max(abs(read_define(controller, 'OUTPUT_MIN')), abs(read_define(controller, 'OUTPUT_MAX')))
+
+    Ts = 1 / fs
+    zeta, wn = design_poles(*discrete_model(K, tau, Ts), kp, ki, Ts)
+
+    if args.model:
+        models = sorted(tuple(model) for model in args.model)
+        source = 'Measured'
+    else:
+        models = [(0.0, K, tau), (K * u_max, K, tau_full)]
+        source = 'MotorParameters.h'
+    distinct = len(set((K_i, tau_i) for _, K_i, tau_i in models))
+
+    max_speed = max(K_i for _, K_i, _ in models) * u_max
+    spacing = max_speed / (args.points - 1)
+
+    gains = []
+    for i in range(args.points):
+        speed = i * spacing
+        K_i, tau_i = interpolate_model(models, speed)
+        a, b = discrete_model(K_i, tau_i, Ts)
+
+        try:
+            kp_i, ki_i = place_poles(a, b, zeta, wn, Ts)
+        except ValueError as error:
+            parser.error(f'{speed:.1f} rpm: {error}')
+        gains.append((speed, kp_i, ki_i * Ts, kd * N))
+
+    with open(args.output, 'w') as header:
+        header.write('/*\n')
+        header.write(' * GainScheduleTable.h\n')
+        header.write(' *\n')
+        header.write(' * Gain schedule table for the velocity controller, generated by\n')
+        header.write(' * Scripts/generate_gain_schedule.py. Do not edit this file by hand.\n')
+        header.write(' *\n')
+        for speed, K_i, tau_i in models:
+            header.write(f' * {source} model at {speed:g} rpm: gain = {K_i:g}, time constant = {tau_i:g}\n')
+        header.write(f' * Design: damping = {zeta:.4g}, natural frequency = {wn:.4g} rad/s\n')
+        header.write(' */\n\n')
+        header.write('#ifndef GAIN_SCHEDULE_TABLE_H\n#define GAIN_SCHEDULE_TABLE_H\n\n')
+
+        header.write('// Number of different models the table was generated from. With fewer than\n')
+        header.write('// two, every breakpoint has the same gains.\n')
+        header.write(f'#define GAIN_SCHEDULE_MODELS    {distinct}\n\n')
+        header.write(f'#define GAIN_SCHEDULE_POINTS    {args.points}\n')
+        header.write(f'#define GAIN_SCHEDULE_SPACING   {c_float(spacing)}     // rpm\n\n')
+
+        header.write('// Each breakpoint is { Kp, Ki * Ts, Kd * N, and the slope of each to the next\n')
+        header.write('// breakpoint }, starting from zero speed\n')
+        header.write('#define GAIN_SCHEDULE_TABLE { \\\n')
+        for i, (speed, kp_i, int_i, der_i) in enumerate(gains):
+            if i < len(gains) - 1:
+                _, kp_n, int_n, der_n = gains[i + 1]
+                slopes = (kp_n - kp_i, int_n - int_i, der_n - der_i)
+            else:
+                slopes = (0.0, 0.0, 0.0)
+            separator = ',' if i < len(gains) - 1 else ''
+            values = ', '.join(c_float(x) for x in (kp_i, int_i, der_i) + slopes)
+            header.write(f'        {{ {values} }}{separator}   /* {speed:.1f} rpm */ \\\n')
+        header.write('    }\n\n')
+        header.write('#endif\n')
+
+    print(f'{args.points} breakpoints written to {os.path.normpath(args.output)}')
+    print(f'  damping {zeta:.4f}, natural frequency {wn:.4f} rad/s')
+    for speed, kp_i, int_i, _ in gains:
+        print(f'  {speed:8.2f} rpm: Kp = {kp_i:.5f}, Ki = {int_i * fs:.5f}')
+
+
+if __name__ == '__main__':
+    main()
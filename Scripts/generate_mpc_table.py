@@ -0,0 +1,304 @@
+"""
+generate_mpc_table.py
+
+Generate the region table for the explicit model predictive controller
+(ExplicitMPC.h) from the first-order motor model and output limits used by the
+microcontroller code.
+
+The controller minimises, over a horizon of N samples,
+
+    sum_{i=1}^{N-1} Q e_i^2 + P e_N^2 + sum_{i=0}^{N-1} R v_i^2
+
+where e = w - r is the speed error and v = u - (r / K - d) is the deviation of
+the voltage from the steady-state voltage for the setpoint. The model is the
+one used by the motor simulation, augmented with a constant disturbance d at
+the input of the motor:
+
+    w[k+1] = a w[k] + b (u[k] + d[k]),  a = tau / (Ts + tau),  b = Ts K / (Ts + tau)
+    d[k+1] = d[k]
+
+and every voltage in the horizon must lie within [OUTPUT_MIN, OUTPUT_MAX]. P is
+the solution of the Riccati equation, so the unconstrained controller is the
+LQR.
+
+The disturbance is estimated by the controller from the difference between the
+measured and predicted speeds. It absorbs any error in the model as well as a
+load on the motor, so the steady-state voltage is corrected and there is no
+steady-state error.
+
+The optimal first voltage is a piecewise-affine function of the speed w,
+setpoint r and disturbance d. Each region of that function corresponds to one
+set of active constraints. Every combination of free, upper and lower bounded
+inputs is solved from its optimality conditions, and the combinations which are
+optimal somewhere on a grid covering the reachable speeds and setpoints and
+the range of disturbances are written to the table, most frequent first.
+
+Author: Aaron Lucas
+Date Created: 2026/10/16
+
+Written for the Off-World Robotics Team
+"""
+
+import argparse
+import itertools
+import math
+import os
+import re
+
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+SRC_DIR = os.path.join(SCRIPT_DIR, '..', 'Microcontroller (C)', 'src')
+
+FREE, UPPER, LOWER = 0, 1, 2
+
+# Number of grid points along each axis when checking which regions exist
+GRID_POINTS = 41
+
+
+def read_define(path, name):
+    """Read the numeric value of a simple #define from a header file."""
+    with open(path) as header:
+        for line in header:
+            match = re.match(rf'\s*#define\s+{name}\s+(-?[0-9.eE+-]+)f?\b', line)
+            if match:
+                return float(match.group(1))
+    raise ValueError(f'{name} not found in {path}')
+
+
+def solve(A, B):
+    """Solve A X = B by Gaussian elimination, where B is a list of columns."""
+    n = len(A)
+    M = [list(A[i]) + [col[i] for col in B] for i in range(n)]
+
+    for c in range(n):
+        pivot = max(range(c, n), key=lambda r: abs(M[r][c]))
+        M[c], M[pivot] = M[pivot], M[c]
+        for r in range(n):
+            if r != c:
+                f = M[r][c] / M[c][c]
+                M[r] = [x - f * y for x, y in zip(M[r], M[c])]
+
+    return [[M[i][n + j] / M[i][i] for i in range(n)] for j in range(len(B))]
+
+
+# Affine functions of the parameters (w, r, d) are stored as [c_w, c_r, c_d, c_1]
+def affine_add(x, y, scale=1.0):
+    return [a + scale * b for a, b in zip(x, y)]
+
+
+def affine_scale(x, scale):
+    return [scale * a for a in x]
+
+
+class Problem:
+    def __init__(self, a, b, K, u_min, u_max, horizon, Q, R):
+        self.horizon = horizon
+        self.u_min, self.u_max = u_min, u_max
+        self.K = K
+
+        # Terminal weight from the scalar discrete Riccati equation
+        P = Q
+        for _ in range(10000):
+            P = Q + a * a * P - (a * b * P) ** 2 / (R + b * b * P)
+        self.P = P
+
+        # Errors over the horizon: e_i = a^i e_0 + sum_{j<i} a^(i-1-j) b v_j
+        phi = [a ** i for i in range(1, horizon + 1)]
+        gamma = [[a ** (i - j) * b if j <= i else 0.0 for j in range(horizon)]
+                 for i in range(horizon)]
+        weights = [Q] * (horizon - 1) + [P]
+
+        # Cost (divided by 2) is 1/2 V'HV + V'h e_0 + constant
+        self.H = [[sum(weights[k] * gamma[k][i] * gamma[k][j] for k in range(horizon))
+                   + (R if i == j else 0.0)
+                   for j in range(horizon)] for i in range(horizon)]
+        self.h = [sum(weights[k] * gamma[k][i] * phi[k] for k in range(horizon))
+                  for i in range(horizon)]
+
+        # The disturbance does not change the error dynamics, only the
+        # steady-state voltage r / K - d and so the bounds on v
+        self.e0 = [1.0, -1.0, 0.0, 0.0]
+        self.upper = [0.0, -1.0 / K, 1.0, u_max]
+        self.lower = [0.0, -1.0 / K, 1.0, u_min]
+
+    def region(self, active):
+        """Optimal law and region for one combination of active constraints.
+
+        Returns (law, constraints) where law is the affine voltage u_0 and each
+        constraint is an affine function which is <= 0 inside the region.
+        """
+        n = self.horizon
+        v = [None] * n
+        for i, state in enumerate(active):
+            if state == UPPER:
+                v[i] = self.upper
+            elif state == LOWER:
+                v[i] = self.lower
+
+        free = [i for i in range(n) if active[i] == FREE]
+        fixed = [i for i in range(n) if active[i] != FREE]
+
+        if free:
+            # H_FF v_F = -(h_F e_0 + H_FA v_A)
+            rhs = []
+            for i in free:
+                term = affine_scale(self.e0, self.h[i])
+                for j in fixed:
+                    term = affine_add(term, v[j], self.H[i][j])
+                rhs.append(affine_scale(term, -1.0))
+
+            H_ff = [[self.H[i][j] for j in free] for i in free]
+            columns = [[row[k] for row in rhs] for k in range(4)]
+            solution = solve(H_ff, columns)
+            for index, i in enumerate(free):
+                v[i] = [solution[k][index] for k in range(4)]
+
+        constraints = []
+        for i in range(n):
+            gradient = affine_scale(self.e0, self.h[i])
+            for j in range(n):
+                gradient = affine_add(gradient, v[j], self.H[i][j])
+
+            if active[i] == FREE:
+                constraints.append(affine_add(v[i], self.upper, -1.0))
+                constraints.append(affine_add(self.lower, v[i], -1.0))
+            elif active[i] == UPPER:
+                # Multiplier -gradient must be non-negative
+                constraints.append(gradient)
+            else:
+                constraints.append(affine_scale(gradient, -1.0))
+
+        # Normalise so that constraint values are distances in rpm, with the
+        # disturbance measured by the speed K d it would cause
+        normalised = []
+        for c in constraints:
+            norm = math.sqrt(c[0] ** 2 + c[1] ** 2 + (c[2] / self.K) ** 2)
+            if norm > 1e-12:
+                normalised.append(affine_scale(c, 1.0 / norm))
+            elif c[3] > 1e-9:
+                return None         # Never satisfied
+
+        law = affine_add(v[0], [0.0, 1.0 / self.K, -1.0, 0.0])
+        return law, normalised
+
+
+def contains(constraints, w, r, d, tolerance=1e-6):
+    return all(c[0] * w + c[1] * r + c[2] * d + c[3] <= tolerance for c in constraints)
+
+
+def c_float(x):
+    """Format a number as a C float literal."""
+    text = f'{x:.9g}'
+    if not any(ch in text for ch in '.en'):
+        text += '.0'
+    return text + 'f'
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate the explicit MPC region table.')
+    parser.add_argument('--horizon', type=int, default=4, help='prediction horizon (samples)')
+    parser.add_argument('--q', type=float, default=1.0, help='speed error weight')
+    parser.add_argument('--r', type=float, default=1.0, help='voltage weight')
+    parser.add_argument('--disturbance', type=float, default=None,
+                        help='largest disturbance covered by the table (V, '
+                             'default half the largest output)')
+    parser.add_argument('--output', default=os.path.join(SRC_DIR, 'MPCTable.h'))
+    args = parser.parse_args()
+
+    motor = os.path.join(SRC_DIR, 'MotorParameters.h')
+    controller = os.path.join(SRC_DIR, 'ControllerParameters.h')
+
+    K = read_define(motor, 'DC_GAIN')
+    tau = read_define(motor, 'TIME_CONSTANT')
+    fs = read_define(controller, 'FS')
+    u_min = read_define(controller, 'OUTPUT_MIN')
+    u_max = read_define(controller, 'OUTPUT_MAX')
+
+    Ts = 1 / fs
+    a = tau / (Ts + tau)
+    b = Ts * K / (Ts + tau)
+
+    d_max = args.disturbance
+    if d_max is None:
+        d_max = 0.5 * max(abs(u_min), abs(u_max))
+
+    problem = Problem(a, b, K, u_min, u_max, args.horizon, args.q, args.r)
+
+    candidates = []
+    for active in itertools.product((FREE, UPPER, LOWER), repeat=args.horizon):
+        result = problem.region(active)
+        if result is not None:
+            candidates.append(result)
+
+    # Speeds and setpoints reachable within the output limits, and the range of
+    # disturbances. Points where the steady-state voltage is outside the limits
+    # are skipped, since the setpoint cannot be reached there.
+    limit = K * max(abs(u_min), abs(u_max))
+    grid = [-limit + 2 * limit * i / (GRID_POINTS - 1) for i in range(GRID_POINTS)]
+    d_grid = [-d_max + 2 * d_max * i / (GRID_POINTS - 1) for i in range(GRID_POINTS)]
+
+    counts = [0] * len(candidates)
+    for w in grid:
+        for r in grid:
+            for d in d_grid:
+                if not u_min <= r / K - d <= u_max:
+                    continue
+                for index, (_, constraints) in enumerate(candidates):
+                    if contains(constraints, w, r, d):
+                        counts[index] += 1
+                        break
+
+    regions = sorted(((count, candidates[i]) for i, count in enumerate(counts) if count > 0),
+                     key=lambda x: -x[0])
+
+    max_constraints = 2 * args.horizon
+
+    with open(args.output, 'w') as header:
+        header.write('/*\n')
+        header.write(' * MPCTable.h\n')
+        header.write(' *\n')
+        header.write(' * Region table for the explicit model predictive controller, generated by\n')
+        header.write(' * Scripts/generate_mpc_table.py. Do not edit this file by hand.\n')
+        header.write(' *\n')
+        header.write(f' * Model: DC_GAIN = {K:g}, TIME_CONSTANT = {tau:g}, FS = {fs:g}\n')
+        header.write(f' * Output limits: [{u_min:g}, {u_max:g}], disturbance limit: {d_max:g}\n')
+        header.write(f' * Horizon: {args.horizon}, Q = {args.q:g}, R = {args.r:g}, P = {problem.P:.6g}\n')
+        header.write(' */\n\n')
+        header.write('#ifndef MPC_TABLE_H\n#define MPC_TABLE_H\n\n')
+
+        header.write(f'#define MPC_HORIZON             {args.horizon}\n')
+        header.write(f'#define MPC_WEIGHT_Q            {c_float(args.q)}\n')
+        header.write(f'#define MPC_WEIGHT_R            {c_float(args.r)}\n')
+        header.write(f'#define MPC_WEIGHT_P            {c_float(problem.P)}\n\n')
+        header.write('// Discrete model of the motor, w[k+1] = a w[k] + b (u[k] + d[k]), used to\n')
+        header.write('// estimate the disturbance d\n')
+        header.write(f'#define MPC_MODEL_A             {c_float(a)}\n')
+        header.write(f'#define MPC_MODEL_B             {c_float(b)}\n')
+        header.write(f'#define MPC_DISTURBANCE_LIMIT   {c_float(d_max)}\n\n')
+        header.write(f'#define MPC_NUM_REGIONS         {len(regions)}\n')
+        header.write(f'#define MPC_MAX_CONSTRAINTS     {max_constraints}\n\n')
+
+        header.write('// Each region is { { constraints }, number of constraints, { law } } where a\n')
+        header.write('// point (w, r, d) is inside the region if c[0] w + c[1] r + c[2] d + c[3] <= 0\n')
+        header.write('// for every constraint and the control signal is\n')
+        header.write('// law[0] w + law[1] r + law[2] d + law[3]\n')
+        header.write('#define MPC_REGIONS { \\\n')
+        for n, (count, (law, constraints)) in enumerate(regions):
+            separator = ',' if n < len(regions) - 1 else ''
+            header.write('        { { \\\n')
+            for i, c in enumerate(constraints):
+                comma = ',' if i < len(constraints) - 1 else ''
+                header.write('            { ' + ', '.join(c_float(x) for x in c) + f' }}{comma} \\\n')
+            header.write('          }, \\\n')
+            header.write(f'          {len(constraints)}, \\\n')
+            header.write('          { ' + ', '.join(c_float(x) for x in law) + f' }} }}{separator} \\\n')
+        header.write('    }\n\n')
+        header.write('#endif\n')
+
+    print(f'{len(regions)} regions written to {os.path.normpath(args.output)}')
+    for count, (law, constraints) in regions:
+        print(f'  {count:6d} grid points, {len(constraints)} constraints, '
+              f'u = {law[0]:+.4f} w {law[1]:+.4f} r {law[2]:+.4f} d {law[3]:+.4f}')
+
+
+if __name__ == '__main__':
+    main()